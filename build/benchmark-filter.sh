@@ -0,0 +1,119 @@
+#!/usr/bin/env bash
+#-----------------------------------------------------------------------------
+#
+#  TSDuck - The MPEG Transport Stream Toolkit
+#  Copyright (c) 2005-2020, Thierry Lelegard
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#
+#  1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+#  THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  This script measures the processing time of the "filter" plugin with
+#  a realistic combination of ten selection criteria over a large file.
+#  The plugin is run twice: once alone with a PID filter and once with all
+#  criteria, both against a reference chain without filter.
+#
+#  Options:
+#
+#     --bin dir   : binary directory to test (default: current build)
+#     --file name : TS file to use (default: generate a temporary file)
+#     --size mb   : size in MB of the generated file (default: 1024)
+#
+#-----------------------------------------------------------------------------
+
+SCRIPT=$(basename ${BASH_SOURCE[0]} .sh)
+error() { echo >&2 "$SCRIPT: $*"; exit 1; }
+
+# Default options.
+BINDIR=$($(dirname ${BASH_SOURCE[0]})/setenv.sh --display)
+TSFILE=
+SIZE=1024
+
+# Decode command line options.
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --bin)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            BINDIR=$(cd "$1"; pwd)
+            ;;
+        --file)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            TSFILE="$1"
+            ;;
+        --size)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            SIZE=$1
+            ;;
+        *)
+            error "invalid option $1"
+            ;;
+    esac
+    shift
+done
+
+[[ -x "$BINDIR/tsp" ]] || error "tsp not found in $BINDIR"
+export PATH="$BINDIR:$PATH"
+export LD_LIBRARY_PATH="$BINDIR:$LD_LIBRARY_PATH"
+export TSPLUGINS_PATH="$BINDIR:$TSPLUGINS_PATH"
+
+# Generate a file with a mix of null packets and packets on a few PID's.
+if [[ -z "$TSFILE" ]]; then
+    TMPDIR=$(mktemp -d)
+    trap "rm -rf $TMPDIR" EXIT
+    TSFILE="$TMPDIR/filter.ts"
+    tsp -I null $(( SIZE * 1024 * 1024 / 188 )) \
+        -P filter --every 3 --set-label 1 \
+        -P craft --only-label 1 --pid 100 --payload-pattern 0123456789ABCDEF \
+        -P filter --every 7 --set-label 2 \
+        -P craft --only-label 2 --pid 200 --pusi --pes-payload \
+        -O file "$TSFILE" || error "cannot create $TSFILE"
+fi
+[[ -f "$TSFILE" ]] || error "$TSFILE not found"
+
+# Usage: bench description tsp-processor-options...
+bench() {
+    local desc="$1"
+    shift
+    local start=$(date +%s%N)
+    tsp --bitrate 100000000 -I file "$TSFILE" "$@" -O drop || error "error running tsp $*"
+    local end=$(date +%s%N)
+    awk "BEGIN {printf \"%-30s %10.3f s\\n\", \"$desc:\", ($end - $start) / 1000000000}"
+}
+
+echo "Binary directory: $BINDIR"
+echo "Input file: $TSFILE ($(( $(stat -c %s "$TSFILE") / 1048576 )) MB)"
+bench "no filter" -P count --summary --output-file /dev/null
+bench "filter one PID" -P filter --pid 100
+bench "filter ten criteria" -P filter \
+    --pid 300-310 \
+    --stream-id 0xC0-0xDF \
+    --unit-start \
+    --pcr \
+    --scrambling-control 3 \
+    --label 5 \
+    --interval 1000-2000 --interval 3000-4000 \
+    --min-payload-size 184 \
+    --has-splice-countdown \
+    --pattern 0123456789ABCDEF --search-offset 4
@@ -0,0 +1,160 @@
+#!/usr/bin/env bash
+#-----------------------------------------------------------------------------
+#
+#  TSDuck - The MPEG Transport Stream Toolkit
+#  Copyright (c) 2005-2020, Thierry Lelegard
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#
+#  1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+#  THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  This script compares the CPU time, memory usage and number of threads
+#  of many light tsp chains, running either as separate tsp processes or
+#  as chains inside one single tsphost process, with the packet processor
+#  plugins of all chains in a shared thread pool (default) or in one
+#  thread per plugin (option --no-pool of tsphost).
+#
+#  The number of threads is sampled on Linux only (from /proc), on chains
+#  which are regulated at a low bitrate to keep them running during the
+#  measurement.
+#
+#  Options:
+#
+#     --bin dir      : binary directory to test (default: current build)
+#     --chains count : number of chains (default: 100)
+#     --packets count: number of packets per chain (default: 100000)
+#
+#-----------------------------------------------------------------------------
+
+SCRIPT=$(basename ${BASH_SOURCE[0]} .sh)
+error() { echo >&2 "$SCRIPT: $*"; exit 1; }
+
+# Default options.
+BINDIR=$($(dirname ${BASH_SOURCE[0]})/setenv.sh --display)
+CHAINS=100
+PACKETS=100000
+
+# Decode command line options.
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --bin)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            BINDIR=$(cd "$1"; pwd)
+            ;;
+        --chains)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            CHAINS=$1
+            ;;
+        --packets)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            PACKETS=$1
+            ;;
+        *)
+            error "invalid option $1"
+            ;;
+    esac
+    shift
+done
+
+[[ -x "$BINDIR/tsp" ]] || error "tsp not found in $BINDIR"
+[[ -x "$BINDIR/tsphost" ]] || error "tsphost not found in $BINDIR"
+[[ -x /usr/bin/time ]] || error "/usr/bin/time not found"
+export PATH="$BINDIR:$PATH"
+export LD_LIBRARY_PATH="$BINDIR:$LD_LIBRARY_PATH"
+export TSPLUGINS_PATH="$BINDIR:$TSPLUGINS_PATH"
+
+TMPDIR=$(mktemp -d)
+trap "rm -rf $TMPDIR" EXIT
+
+# The same light chain is used everywhere, with the tsphost default buffer size.
+CHAIN="--buffer-size-mb 1 -I null $PACKETS -P count --summary --output-file /dev/null -O drop"
+
+# Same chain, running long enough to count the threads.
+LIVE_CHAIN="--buffer-size-mb 1 -I null -P regulate --bitrate 1000000 -P count --summary --output-file /dev/null -O drop"
+
+# Build the tsphost configuration files.
+for ((i = 1; i <= CHAINS; i++)); do
+    echo "chain-$i: $CHAIN"
+done >"$TMPDIR/host.conf"
+for ((i = 1; i <= CHAINS; i++)); do
+    echo "chain-$i: $LIVE_CHAIN"
+done >"$TMPDIR/live.conf"
+
+# Usage: threads pid...
+# Display the total number of threads in the specified processes.
+threads() {
+    local pid
+    for pid in "$@"; do
+        grep '^Threads:' /proc/$pid/status 2>/dev/null
+    done | awk '{ n += $2 } END { print n + 0 }'
+}
+
+# Usage: report description time-output-files...
+# Each time output file contains "elapsed user system maxrss-kb".
+report() {
+    local desc="$1"
+    shift
+    cat "$@" | awk -v desc="$desc" '
+        { elapsed = $1 > elapsed ? $1 : elapsed; cpu += $2 + $3; rss += $4 }
+        END { printf "%-20s elapsed: %8.2f s, cpu: %8.2f s, memory: %8.1f MB\n", desc ":", elapsed, cpu, rss / 1024 }'
+}
+
+echo "Binary directory: $BINDIR"
+echo "Chains: $CHAINS, packets per chain: $PACKETS"
+
+# Separate processes. The elapsed time is the longest one, memory is the sum of all processes.
+for ((i = 1; i <= CHAINS; i++)); do
+    /usr/bin/time -f "%e %U %S %M" -o "$TMPDIR/tsp-$i.time" tsp $CHAIN &
+done
+wait
+report "separate tsp" "$TMPDIR"/tsp-*.time
+
+# One single host process.
+/usr/bin/time -f "%e %U %S %M" -o "$TMPDIR/host.time" tsphost "$TMPDIR/host.conf" || error "error running tsphost"
+report "tsphost" "$TMPDIR/host.time"
+/usr/bin/time -f "%e %U %S %M" -o "$TMPDIR/nopool.time" tsphost --no-pool "$TMPDIR/host.conf" || error "error running tsphost"
+report "tsphost --no-pool" "$TMPDIR/nopool.time"
+
+# Number of threads, when all chains are running.
+if [[ -d /proc/self ]]; then
+    PIDS=
+    for ((i = 1; i <= CHAINS; i++)); do
+        tsp $LIVE_CHAIN &
+        PIDS="$PIDS $!"
+    done
+    sleep 3
+    printf "%-20s threads: %d\n" "separate tsp:" $(threads $PIDS)
+    kill -INT $PIDS
+    wait
+
+    for opt in "" --no-pool; do
+        tsphost $opt "$TMPDIR/live.conf" &
+        PID=$!
+        sleep 3
+        printf "%-20s threads: %d\n" "tsphost${opt:+ $opt}:" $(threads $PID)
+        kill -INT $PID
+        wait
+    done
+fi
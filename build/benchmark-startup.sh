@@ -0,0 +1,99 @@
+#!/usr/bin/env bash
+#-----------------------------------------------------------------------------
+#
+#  TSDuck - The MPEG Transport Stream Toolkit
+#  Copyright (c) 2005-2020, Thierry Lelegard
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#
+#  1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+#  THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  This script measures the startup time of short-lived TSDuck commands.
+#  Each command is run a number of times and the average elapsed time per
+#  execution is displayed. Use it to compare a default build with a build
+#  using "make STATIC_PLUGINS=true" (all plugins linked inside tsp).
+#
+#  Options:
+#
+#     --bin dir : binary directory to test (default: current build)
+#     --count n : number of executions per command (default: 100)
+#
+#-----------------------------------------------------------------------------
+
+SCRIPT=$(basename ${BASH_SOURCE[0]} .sh)
+error() { echo >&2 "$SCRIPT: $*"; exit 1; }
+
+# Default options.
+BINDIR=$($(dirname ${BASH_SOURCE[0]})/setenv.sh --display)
+COUNT=100
+
+# Decode command line options.
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --bin)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            BINDIR=$(cd "$1"; pwd)
+            ;;
+        --count)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            COUNT=$1
+            ;;
+        *)
+            error "invalid option $1"
+            ;;
+    esac
+    shift
+done
+
+[[ -x "$BINDIR/tsp" ]] || error "tsp not found in $BINDIR"
+export PATH="$BINDIR:$PATH"
+export LD_LIBRARY_PATH="$BINDIR:$LD_LIBRARY_PATH"
+export TSPLUGINS_PATH="$BINDIR:$TSPLUGINS_PATH"
+
+# A small TS file with a PAT and an SDT.
+TMPDIR=$(mktemp -d)
+trap "rm -rf $TMPDIR" EXIT
+TSFILE="$TMPDIR/small.ts"
+tsp -I null 1000 \
+    -P pat --create --add-service 1/1000 \
+    -P sdt --create --service-id 1 --name bench \
+    -O file "$TSFILE" || error "cannot create $TSFILE"
+
+# Usage: bench description command [args...]
+bench() {
+    local desc="$1"
+    shift
+    local start=$(date +%s%N)
+    for ((i = 0; i < $COUNT; i++)); do
+        "$@" >/dev/null 2>&1
+    done
+    local end=$(date +%s%N)
+    awk "BEGIN {printf \"%-40s %8.3f ms\\n\", \"$desc:\", ($end - $start) / ($COUNT * 1000000)}"
+}
+
+echo "Binary directory: $BINDIR"
+echo "Average elapsed time over $COUNT executions:"
+bench "tsp --version" tsp --version
+bench "tsp single-plugin chain" tsp -I file "$TSFILE" -P count -O drop
+bench "tstables on small file" tstables "$TSFILE"
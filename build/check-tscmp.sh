@@ -0,0 +1,155 @@
+#!/usr/bin/env bash
+#-----------------------------------------------------------------------------
+#
+#  TSDuck - The MPEG Transport Stream Toolkit
+#  Copyright (c) 2005-2020, Thierry Lelegard
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#
+#  1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+#  THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  This script checks that the bulk comparison of identical packets in
+#  tscmp produces exactly the same output as a packet-by-packet comparison.
+#  Two files are generated, the second one is modified at several offsets
+#  (payload, PID, continuity counter) and truncated. Each output format of
+#  tscmp is produced with the default buffers and compared byte by byte
+#  with the output of the same command with one-packet buffers, where each
+#  packet is compared alone. With --ref, the output is also compared with
+#  the output of another tscmp binary, typically a previous version. Since
+#  the JSON output is now streamed, the order of the fields in JSON objects
+#  may differ from older versions: the JSON outputs are compared with sorted
+#  fields (requires python3).
+#
+#  Options:
+#
+#     --bin dir   : binary directory to test (default: current build)
+#     --ref dir   : directory of a reference tscmp binary (default: none)
+#
+#
+#-----------------------------------------------------------------------------
+
+SCRIPT=$(basename ${BASH_SOURCE[0]} .sh)
+error() { echo >&2 "$SCRIPT: $*"; exit 1; }
+
+# Default options.
+BINDIR=$($(dirname ${BASH_SOURCE[0]})/setenv.sh --display)
+REFDIR=
+
+# Decode command line options.
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --bin)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            BINDIR=$(cd "$1"; pwd)
+            ;;
+        --ref)
+            [[ $# -gt 1 ]] || error "missing value after $1"
+            shift
+            REFDIR=$(cd "$1"; pwd)
+            ;;
+        *)
+            error "invalid option $1"
+            ;;
+    esac
+    shift
+done
+
+[[ -x "$BINDIR/tsp" ]] || error "tsp not found in $BINDIR"
+[[ -x "$BINDIR/tscmp" ]] || error "tscmp not found in $BINDIR"
+[[ -z "$REFDIR" || -x "$REFDIR/tscmp" ]] || error "tscmp not found in $REFDIR"
+export LD_LIBRARY_PATH="$BINDIR:$LD_LIBRARY_PATH"
+export TSPLUGINS_PATH="$BINDIR:$TSPLUGINS_PATH"
+
+TMPDIR=$(mktemp -d)
+trap "rm -rf $TMPDIR" EXIT
+FILE1="$TMPDIR/file1.ts"
+FILE2="$TMPDIR/file2.ts"
+
+# Generate a file with a mix of null packets and packets on a few PID's.
+"$BINDIR/tsp" -I null 50000 \
+    -P filter --every 3 --set-label 1 \
+    -P craft --only-label 1 --pid 100 --payload-pattern 0123456789ABCDEF \
+    -P filter --every 7 --set-label 2 \
+    -P craft --only-label 2 --pid 200 --pusi --pes-payload \
+    -P continuity --fix \
+    -O file "$FILE1" || error "cannot create $FILE1"
+
+# Usage: patch packet-index byte-offset hexa-value
+patch() {
+    printf "\\x$3" | dd of="$FILE2" bs=1 seek=$(( $1 * 188 + $2 )) conv=notrunc status=none
+}
+
+# Differences in payload, PID and continuity counter, then truncate the second file.
+cp "$FILE1" "$FILE2"
+patch 9 100 55
+patch 12 100 55
+patch 15 120 55
+patch 9999 2 55
+patch 10002 3 1F
+patch 30000 50 AA
+patch 30000 51 BB
+patch 30003 4 55
+truncate -s $(( 49990 * 188 )) "$FILE2"
+
+# Usage: sort_json file
+# Rewrite a JSON file with sorted fields in objects.
+sort_json() {
+    python3 -c 'import json, sys; print(json.dumps(json.load(open(sys.argv[1])), indent=2, sort_keys=True))' "$1" >"$1.sorted" &&
+        mv "$1.sorted" "$1" || error "cannot sort $1, python3 is required"
+}
+
+# Usage: check description tscmp-options...
+check() {
+    local desc="$1"
+    shift
+    "$BINDIR/tscmp" --continue "$@" "$FILE1" "$FILE2" >"$TMPDIR/bulk.txt" 2>&1
+    "$BINDIR/tscmp" --continue --buffered-packets 1 "$@" "$FILE1" "$FILE2" >"$TMPDIR/single.txt" 2>&1
+    if ! cmp -s "$TMPDIR/bulk.txt" "$TMPDIR/single.txt"; then
+        diff "$TMPDIR/single.txt" "$TMPDIR/bulk.txt"
+        error "$desc: bulk and packet-by-packet outputs differ"
+    fi
+    if [[ -n "$REFDIR" ]]; then
+        LD_LIBRARY_PATH="$REFDIR:$LD_LIBRARY_PATH" "$REFDIR/tscmp" --continue "$@" "$FILE1" "$FILE2" >"$TMPDIR/ref.txt" 2>&1
+        if [[ " $* " == *" --json "* ]]; then
+            sort_json "$TMPDIR/bulk.txt"
+            sort_json "$TMPDIR/ref.txt"
+        fi
+        if ! cmp -s "$TMPDIR/bulk.txt" "$TMPDIR/ref.txt"; then
+            diff "$TMPDIR/ref.txt" "$TMPDIR/bulk.txt"
+            error "$desc: output differs from reference"
+        fi
+    fi
+    printf "%-20s identical, %d lines\n" "$desc:" $(wc -l <"$TMPDIR/bulk.txt")
+}
+
+check "default"
+check "verbose" --verbose
+check "normalized" --normalized
+check "json" --json
+check "payload only" --payload-only --normalized
+check "cc ignore" --cc-ignore --normalized
+check "pid ignore" --pid-ignore --normalized
+check "subset" --subset --normalized
+check "threshold" --threshold-diff 1 --normalized
+check "dump" --dump --normalized
+check "quiet" --quiet
@@ -0,0 +1,3 @@
+CONFIG += tstool
+TARGET = tsphost
+include(../tsduck.pri)
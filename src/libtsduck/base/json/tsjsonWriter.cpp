@@ -0,0 +1,357 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Streaming JSON writer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsjsonWriter.h"
+TSDUCK_SOURCE;
+
+// Flush the output when the internal buffer reaches this size.
+#define FLUSH_THRESHOLD 65536
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::json::Writer::Writer(std::ostream& strm, size_t indent) :
+    _strm(strm),
+    _indent(indent),
+    _buffer(),
+    _levels()
+{
+    _buffer.reserve(FLUSH_THRESHOLD + 1024);
+}
+
+ts::json::Writer::~Writer()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Close all levels and flush the output.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::close()
+{
+    while (!_levels.empty()) {
+        endLevel(_levels.back().close);
+    }
+    flush();
+}
+
+void ts::json::Writer::flush()
+{
+    if (!_buffer.empty()) {
+        _strm.write(_buffer.data(), std::streamsize(_buffer.size()));
+        _strm.flush();
+        _buffer.clear();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Formatting of elements, same layout as Value::print().
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::newLine()
+{
+    _buffer.push_back('\n');
+    _buffer.append(_levels.size() * _indent, ' ');
+}
+
+void ts::json::Writer::beginValue()
+{
+    // At top level, nothing to insert. In an array, one element per line.
+    if (!_levels.empty()) {
+        assert(_levels.back().close == ']');
+        if (!_levels.back().empty) {
+            _buffer.push_back(',');
+        }
+        _levels.back().empty = false;
+        newLine();
+    }
+}
+
+void ts::json::Writer::beginField(const UString& name)
+{
+    assert(!_levels.empty() && _levels.back().close == '}');
+    if (!_levels.empty()) {
+        if (!_levels.back().empty) {
+            _buffer.push_back(',');
+        }
+        _levels.back().empty = false;
+        newLine();
+    }
+    appendString(name);
+    _buffer.append(": ");
+}
+
+void ts::json::Writer::beginLevel(char open, char close)
+{
+    _buffer.push_back(open);
+    _levels.push_back({close, true});
+}
+
+void ts::json::Writer::endLevel(char close)
+{
+    assert(!_levels.empty() && _levels.back().close == close);
+    if (!_levels.empty()) {
+        _levels.pop_back();
+        newLine();
+        _buffer.push_back(close);
+        endValue();
+    }
+}
+
+void ts::json::Writer::endValue()
+{
+    if (_levels.empty()) {
+        // End of a top-level value.
+        _buffer.push_back('\n');
+        flush();
+    }
+    else if (_buffer.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Objects and arrays.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::beginObject()
+{
+    beginValue();
+    beginLevel('{', '}');
+}
+
+void ts::json::Writer::beginObject(const UString& name)
+{
+    beginField(name);
+    beginLevel('{', '}');
+}
+
+void ts::json::Writer::beginArray()
+{
+    beginValue();
+    beginLevel('[', ']');
+}
+
+void ts::json::Writer::beginArray(const UString& name)
+{
+    beginField(name);
+    beginLevel('[', ']');
+}
+
+
+//----------------------------------------------------------------------------
+// Object fields.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::add(const UString& name, int64_t value)
+{
+    beginField(name);
+    appendNumber(value);
+    endValue();
+}
+
+void ts::json::Writer::add(const UString& name, const UString& value)
+{
+    beginField(name);
+    appendString(value);
+    endValue();
+}
+
+void ts::json::Writer::add(const UString& name, const Value& value)
+{
+    beginField(name);
+    appendValue(value);
+    endValue();
+}
+
+void ts::json::Writer::addBool(const UString& name, bool value)
+{
+    beginField(name);
+    _buffer.append(value ? "true" : "false");
+    endValue();
+}
+
+
+//----------------------------------------------------------------------------
+// Array elements or top-level values.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::set(int64_t value)
+{
+    beginValue();
+    appendNumber(value);
+    endValue();
+}
+
+void ts::json::Writer::set(const UString& value)
+{
+    beginValue();
+    appendString(value);
+    endValue();
+}
+
+void ts::json::Writer::set(const Value& value)
+{
+    beginValue();
+    appendValue(value);
+    endValue();
+}
+
+void ts::json::Writer::setBool(bool value)
+{
+    beginValue();
+    _buffer.append(value ? "true" : "false");
+    endValue();
+}
+
+
+//----------------------------------------------------------------------------
+// Append a number in the buffer.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::appendNumber(int64_t value)
+{
+    // Format digits backward, without intermediate UString.
+    char str[24];
+    char* const end = str + sizeof(str);
+    char* cur = end;
+    uint64_t uvalue = value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+    do {
+        *--cur = char('0' + uvalue % 10);
+        uvalue /= 10;
+    } while (uvalue != 0);
+    if (value < 0) {
+        *--cur = '-';
+    }
+    _buffer.append(cur, end - cur);
+}
+
+
+//----------------------------------------------------------------------------
+// Append a quoted JSON string in the buffer.
+// Same encoding as UString::toJSON() but directly into 8-bit characters.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::appendString(const UString& value)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    _buffer.push_back('"');
+    for (UString::const_iterator it = value.begin(); it != value.end(); ++it) {
+        const UChar c = *it;
+        if (c >= 0x0020 && c <= 0x007E) {
+            if (c == QUOTATION_MARK || c == REVERSE_SOLIDUS) {
+                _buffer.push_back('\\');
+            }
+            _buffer.push_back(char(c));
+        }
+        else {
+            _buffer.push_back('\\');
+            switch (c) {
+                case BACKSPACE: _buffer.push_back('b'); break;
+                case FORM_FEED: _buffer.push_back('f'); break;
+                case LINE_FEED: _buffer.push_back('n'); break;
+                case CARRIAGE_RETURN: _buffer.push_back('r'); break;
+                case HORIZONTAL_TABULATION: _buffer.push_back('t'); break;
+                default:
+                    // Other Unicode character, use hex code.
+                    _buffer.push_back('u');
+                    _buffer.push_back(hex[(c >> 12) & 0x0F]);
+                    _buffer.push_back(hex[(c >> 8) & 0x0F]);
+                    _buffer.push_back(hex[(c >> 4) & 0x0F]);
+                    _buffer.push_back(hex[c & 0x0F]);
+                    break;
+            }
+        }
+    }
+    _buffer.push_back('"');
+}
+
+
+//----------------------------------------------------------------------------
+// Append a JSON value tree in the buffer.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::appendValue(const Value& value)
+{
+    switch (value.type()) {
+        case TypeNull:
+            _buffer.append("null");
+            break;
+        case TypeTrue:
+            _buffer.append("true");
+            break;
+        case TypeFalse:
+            _buffer.append("false");
+            break;
+        case TypeString:
+            appendString(value.toString());
+            break;
+        case TypeNumber:
+            appendNumber(value.toInteger());
+            break;
+        case TypeObject: {
+            UStringList names;
+            value.getNames(names);
+            beginLevel('{', '}');
+            for (auto it = names.begin(); it != names.end(); ++it) {
+                beginField(*it);
+                appendValue(value.value(*it));
+            }
+            _levels.pop_back();
+            newLine();
+            _buffer.push_back('}');
+            break;
+        }
+        case TypeArray: {
+            beginLevel('[', ']');
+            for (size_t i = 0; i < value.size(); ++i) {
+                beginValue();
+                appendValue(value.at(i));
+            }
+            _levels.pop_back();
+            newLine();
+            _buffer.push_back(']');
+            break;
+        }
+        default:
+            assert(false);
+            break;
+    }
+}
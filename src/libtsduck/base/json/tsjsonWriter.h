@@ -0,0 +1,214 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Streaming JSON writer.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsjsonValue.h"
+
+namespace ts {
+    namespace json {
+        //!
+        //! Streaming JSON writer.
+        //! @ingroup json
+        //!
+        //! A JSON document can be built as a tree of ts::json::Value and then printed.
+        //! This is convenient for small documents. For very large documents, such as a
+        //! list of events in a long transport stream, building the tree uses a lot of memory.
+        //!
+        //! A Writer directly formats the JSON text as the values are produced. Objects and
+        //! arrays are opened and closed explicitly and there is no memory of the previous
+        //! elements. The output is formatted into an internal buffer which is regularly
+        //! flushed to a standard text stream. The JSON text is pure ASCII (all non-ASCII
+        //! characters in strings are escaped) and is formatted exactly as Value::print().
+        //! However, the fields of an object are written in the order of the application,
+        //! not sorted by name as in a json::Object.
+        //!
+        //! When the top-level value is complete, a new line is written and the stream is
+        //! flushed. Several top-level values can be written one after the other.
+        //!
+        //! Inside an object, use the methods with a field name: beginObject(name), add(name, value),
+        //! etc. Inside an array or at top level, use the methods without name: beginObject(),
+        //! set(value), etc.
+        //!
+        class TSDUCKDLL Writer
+        {
+            TS_NOBUILD_NOCOPY(Writer);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] strm Output text stream. The lifetime of the stream must
+            //! equals or exceeds the lifetime of the writer.
+            //! @param [in] indent Indentation width of each level.
+            //!
+            explicit Writer(std::ostream& strm, size_t indent = 2);
+
+            //!
+            //! Destructor.
+            //! All open objects and arrays are closed and the output is flushed.
+            //!
+            ~Writer();
+
+            //!
+            //! Open an object at top level or as element of an array.
+            //!
+            void beginObject();
+
+            //!
+            //! Open an object as field of the current object.
+            //! @param [in] name Field name.
+            //!
+            void beginObject(const UString& name);
+
+            //!
+            //! Close the current object.
+            //!
+            void endObject() { endLevel('}'); }
+
+            //!
+            //! Open an array at top level or as element of an array.
+            //!
+            void beginArray();
+
+            //!
+            //! Open an array as field of the current object.
+            //! @param [in] name Field name.
+            //!
+            void beginArray(const UString& name);
+
+            //!
+            //! Close the current array.
+            //!
+            void endArray() { endLevel(']'); }
+
+            //!
+            //! Add a number field into the current object.
+            //! @param [in] name Field name.
+            //! @param [in] value Field value.
+            //!
+            void add(const UString& name, int64_t value);
+
+            //!
+            //! Add a string field into the current object.
+            //! @param [in] name Field name.
+            //! @param [in] value Field value.
+            //!
+            void add(const UString& name, const UString& value);
+
+            //!
+            //! Add a field into the current object from a JSON value tree.
+            //! @param [in] name Field name.
+            //! @param [in] value JSON value to write.
+            //!
+            void add(const UString& name, const Value& value);
+
+            //!
+            //! Add a boolean field into the current object.
+            //! @param [in] name Field name.
+            //! @param [in] value Field value.
+            //!
+            void addBool(const UString& name, bool value);
+
+            //!
+            //! Add a number at top level or as element of the current array.
+            //! @param [in] value Value to write.
+            //!
+            void set(int64_t value);
+
+            //!
+            //! Add a string at top level or as element of the current array.
+            //! @param [in] value Value to write.
+            //!
+            void set(const UString& value);
+
+            //!
+            //! Add a JSON value tree at top level or as element of the current array.
+            //! @param [in] value JSON value to write.
+            //!
+            void set(const Value& value);
+
+            //!
+            //! Add a boolean at top level or as element of the current array.
+            //! @param [in] value Value to write.
+            //!
+            void setBool(bool value);
+
+            //!
+            //! Get the current depth of nested objects and arrays.
+            //! @return The current depth, zero at top level.
+            //!
+            size_t depth() const { return _levels.size(); }
+
+            //!
+            //! Close all open objects and arrays and flush the output.
+            //!
+            void close();
+
+            //!
+            //! Flush the buffered output to the text stream.
+            //!
+            void flush();
+
+        private:
+            // Description of an open object or array.
+            struct Level
+            {
+                char close;  // Closing character, '}' or ']'.
+                bool empty;  // No element written yet.
+            };
+
+            std::ostream&      _strm;    // Output stream.
+            size_t             _indent;  // Indentation width.
+            std::string        _buffer;  // Formatted output, not yet flushed.
+            std::vector<Level> _levels;  // Stack of open objects and arrays.
+
+            // Start a value inside an array or at top level.
+            void beginValue();
+            // Start a field in an object.
+            void beginField(const UString& name);
+            // Open a level after the field name or array separator.
+            void beginLevel(char open, char close);
+            // Close the current level.
+            void endLevel(char close);
+            // Append a new line and the margin of the current level.
+            void newLine();
+            // End of a value, flush when the top-level value is complete or the buffer is large.
+            void endValue();
+            // Append a quoted JSON string in the buffer.
+            void appendString(const UString& value);
+            // Append a number in the buffer.
+            void appendNumber(int64_t value);
+            // Append a JSON value in the buffer, the field name or separator is already written.
+            void appendValue(const Value& value);
+        };
+    }
+}
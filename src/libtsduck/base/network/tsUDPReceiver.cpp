@@ -36,10 +36,12 @@ TSDUCK_SOURCE;
 // Constructor.
 //----------------------------------------------------------------------------
 
-ts::UDPReceiver::UDPReceiver(ts::Report& report, bool with_short_options, bool dest_as_param) :
+ts::UDPReceiver::UDPReceiver(ts::Report& report, bool with_short_options, bool dest_as_param, bool multiple_dest) :
     UDPSocket(false, report),
     _with_short_options(with_short_options),
     _dest_as_param(dest_as_param),
+    _multiple_dest(multiple_dest && dest_as_param),
+    _dest_count(0),
     _receiver_specified(false),
     _use_ssm(false),
     _dest_addr(),
@@ -67,14 +69,19 @@ void ts::UDPReceiver::defineArgs(ts::Args& args) const
     const UChar* const dest_name = _dest_as_param ? u"" : u"ip-udp";
     const UChar dest_short = _dest_as_param || !_with_short_options ? 0 : 'i';
     const size_t dest_min = _dest_as_param ? 1 : 0;
+    const size_t dest_max = _multiple_dest ? Args::UNLIMITED_COUNT : 1;
 
-    args.option(dest_name, dest_short, Args::STRING, dest_min, 1);
+    args.option(dest_name, dest_short, Args::STRING, dest_min, dest_max);
     args.help(dest_name, u"[address:]port",
-              u"The [address:]port describes the destination of UDP packets to receive. "
-              u"The 'port' part is mandatory and specifies the UDP port to listen on. "
-              u"The 'address' part is optional. It specifies an IP multicast address to listen on. "
-              u"It can be also a host name that translates to a multicast address. "
-              u"An optional source address can be specified as 'source@address:port' in the case of SSM.");
+              UString(u"The [address:]port describes the destination of UDP packets to receive. "
+                      u"The 'port' part is mandatory and specifies the UDP port to listen on. "
+                      u"The 'address' part is optional. It specifies an IP multicast address to listen on. "
+                      u"It can be also a host name that translates to a multicast address. "
+                      u"An optional source address can be specified as 'source@address:port' in the case of SSM.") +
+              UString(!_multiple_dest ? u"" :
+                      u"\n\nSeveral destinations can be specified, typically several multicast groups, each with "
+                      u"an optional SSM source. All other options apply to all destinations. "
+                      u"All destinations are received in parallel."));
 
     args.option(u"buffer-size", _with_short_options ? 'b' : 0, Args::UNSIGNED);
     args.help(u"buffer-size", u"Specify the UDP socket receive buffer size (socket option).");
@@ -136,9 +143,16 @@ void ts::UDPReceiver::defineArgs(ts::Args& args) const
 //----------------------------------------------------------------------------
 
 bool ts::UDPReceiver::loadArgs(DuckContext& duck, Args& args)
+{
+    return loadArgs(duck, args, 0);
+}
+
+bool ts::UDPReceiver::loadArgs(DuckContext& duck, Args& args, size_t dest_index)
 {
     // Get destination address.
-    UString destination(args.value(_dest_as_param ? u"" : u"ip-udp"));
+    const UChar* const dest_name = _dest_as_param ? u"" : u"ip-udp";
+    UString destination(args.value(dest_name, u"", dest_index));
+    _dest_count = args.count(dest_name);
     _receiver_specified = !destination.empty();
 
     // When --ip-udp is specified as an option, the presence of a UDP received is optional.
@@ -350,82 +364,106 @@ bool ts::UDPReceiver::receive(void* data,
                               MicroSecond* timestamp)
 {
     // Loop on packet reception until one matching filtering criteria is found.
-    for (;;) {
-
-        // Wait for a UDP message from the superclass.
-        if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report, timestamp)) {
+    bool accepted = false;
+    do {
+        if (!receiveOne(data, max_size, ret_size, sender, destination, accepted, abort, report, timestamp)) {
             return false;
         }
+    } while (!accepted);
+    return true;
+}
 
-        // Debug (level 2) message for each message.
-        if (report.maxSeverity() >= 2) {
-            // Prior report level checking to avoid evaluating parameters when not necessary.
-            report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", {sender, destination, timestamp != nullptr ? *timestamp : -1});
-        }
 
-        // Check the destination address to exclude packets from other streams.
-        // When several multicast streams use the same destination port and several
-        // applications on the same system listen to these distinct streams,
-        // the multicast MAC address management is such that any socket which
-        // is bound to the common port will receive the traffic for all streams.
-        // This is why we need to check the destination address and exclude
-        // packets which are not from the intended stream.
-        //
-        // We accept a packet in any of:
-        // 1) Actual packet destination is unknown. Probably, the system cannot
-        //    report the destination address.
-        // 2) We listen to a multicast address and the actual destination is the same.
-        // 3) If we listen to unicast traffic and the actual destination is unicast.
-        //    In that case, unicast is by definition sent to us.
-
-        if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
-            // This is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
-            }
-            continue;
-        }
+//----------------------------------------------------------------------------
+// Receive exactly one message and check it against filtering criteria.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::receiveOne(void* data,
+                                 size_t max_size,
+                                 size_t& ret_size,
+                                 ts::SocketAddress& sender,
+                                 ts::SocketAddress& destination,
+                                 bool& accepted,
+                                 const ts::AbortInterface* abort,
+                                 ts::Report& report,
+                                 MicroSecond* timestamp)
+{
+    accepted = false;
 
-        // Keep track of the first sender address.
-        if (!_first_source.hasAddress()) {
-            // First packet, keep address of the sender.
-            _first_source = sender;
-            _sources.insert(sender);
-
-            // With option --first-source, use this one to filter packets.
-            if (_use_first_source) {
-                assert(!_use_source.hasAddress());
-                _use_source = sender;
-                report.verbose(u"now filtering on source address %s", {sender});
-            }
+    // Wait for a UDP message from the superclass.
+    if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report, timestamp)) {
+        return false;
+    }
+
+    // Debug (level 2) message for each message.
+    if (report.maxSeverity() >= 2) {
+        // Prior report level checking to avoid evaluating parameters when not necessary.
+        report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", {sender, destination, timestamp != nullptr ? *timestamp : -1});
+    }
+
+    // Check the destination address to exclude packets from other streams.
+    // When several multicast streams use the same destination port and several
+    // applications on the same system listen to these distinct streams,
+    // the multicast MAC address management is such that any socket which
+    // is bound to the common port will receive the traffic for all streams.
+    // This is why we need to check the destination address and exclude
+    // packets which are not from the intended stream.
+    //
+    // We accept a packet in any of:
+    // 1) Actual packet destination is unknown. Probably, the system cannot
+    //    report the destination address.
+    // 2) We listen to a multicast address and the actual destination is the same.
+    // 3) If we listen to unicast traffic and the actual destination is unicast.
+    //    In that case, unicast is by definition sent to us.
+
+    if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
+        // This is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
         }
+        return true;
+    }
 
-        // Keep track of senders (sources) to detect or filter multiple sources.
-        if (_sources.count(sender) == 0) {
-            // Detected an additional source, warn the user that distinct streams are potentially mixed.
-            // If no source filtering is applied, this is a warning since this may affect the resulting stream.
-            // With source filtering, this is just an informational verbose-level message.
-            const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
-            if (_sources.size() == 1) {
-                report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
-                report.log(level, u"detected source: %s", {_first_source});
-            }
-            report.log(level, u"detected source: %s", {sender});
-            _sources.insert(sender);
+    // Keep track of the first sender address.
+    if (!_first_source.hasAddress()) {
+        // First packet, keep address of the sender.
+        _first_source = sender;
+        _sources.insert(sender);
+
+        // With option --first-source, use this one to filter packets.
+        if (_use_first_source) {
+            assert(!_use_source.hasAddress());
+            _use_source = sender;
+            report.verbose(u"now filtering on source address %s", {sender});
         }
+    }
 
-        // Filter packets based on source address if requested.
-        if (!sender.match(_use_source)) {
-            // Not the expected source, this is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
-            }
-            continue;
+    // Keep track of senders (sources) to detect or filter multiple sources.
+    if (_sources.count(sender) == 0) {
+        // Detected an additional source, warn the user that distinct streams are potentially mixed.
+        // If no source filtering is applied, this is a warning since this may affect the resulting stream.
+        // With source filtering, this is just an informational verbose-level message.
+        const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
+        if (_sources.size() == 1) {
+            report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
+            report.log(level, u"detected source: %s", {_first_source});
         }
+        report.log(level, u"detected source: %s", {sender});
+        _sources.insert(sender);
+    }
 
-        // Now found a packet matching all criteria.
+    // Filter packets based on source address if requested.
+    if (!sender.match(_use_source)) {
+        // Not the expected source, this is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
+        }
         return true;
     }
+
+    // Now found a packet matching all criteria.
+    accepted = true;
+    return true;
 }
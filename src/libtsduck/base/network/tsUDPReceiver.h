@@ -51,13 +51,39 @@ namespace ts {
         //! @param [in] with_short_options When true, define one-letter short options.
         //! @param [in] dest_as_param When true, the destination [address:]port is defined
         //! as a parameter. When false, it is defined as option --ip--udp.
+        //! @param [in] multiple_dest When true, several destinations can be specified on the
+        //! command line. The receiver uses the first one. Use loadArgs() with a destination
+        //! index to configure other instances of UDPReceiver for the other destinations.
         //!
-        explicit UDPReceiver(Report& report = CERR, bool with_short_options = true, bool dest_as_param = true);
+        explicit UDPReceiver(Report& report = CERR, bool with_short_options = true, bool dest_as_param = true, bool multiple_dest = false);
 
         // Implementation of ArgsSupplierInterface.
         virtual void defineArgs(Args& args) const override;
         virtual bool loadArgs(DuckContext& duck, Args& args) override;
 
+        //!
+        //! Load arguments from command line for one of several destinations.
+        //! All options are identical, only the destination changes.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] args Command line arguments.
+        //! @param [in] dest_index Index of the destination on the command line.
+        //! @return True on success, false on error in argument line.
+        //! @see destinationCount()
+        //!
+        bool loadArgs(DuckContext& duck, Args& args, size_t dest_index);
+
+        //!
+        //! Get the number of destinations which were specified on the command line.
+        //! @return The number of destinations.
+        //!
+        size_t destinationCount() const { return _dest_count; }
+
+        //!
+        //! Get the reception timeout.
+        //! @return Receive timeout in milliseconds. No timeout if negative.
+        //!
+        MilliSecond receiveTimeout() const { return _recv_timeout; }
+
         //!
         //! Check if a UDP receiver is specified.
         //! When @a dest_as_param is false in the constructor, the UDP parameters
@@ -81,6 +107,34 @@ namespace ts {
         //!
         void setReceiveTimeoutArg(MilliSecond timeout);
 
+        //!
+        //! Receive exactly one message and check it against the filtering criteria.
+        //! Unlike receive(), a rejected message is not skipped: the method returns
+        //! with @a accepted set to false. This is useful when the socket is used in
+        //! an external poll() loop where a readiness indication guarantees only one
+        //! available message.
+        //! @param [out] data Address of the buffer for the received message.
+        //! @param [in] max_size Size in bytes of the reception buffer.
+        //! @param [out] ret_size Size in bytes of the received message.
+        //! @param [out] sender Source address of the received message.
+        //! @param [out] destination Destination address of the received message.
+        //! @param [out] accepted Set to true when the message matches all filtering criteria.
+        //! When false, the message was received but shall be ignored.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted.
+        //! @param [in,out] report Where to report error.
+        //! @param [out] timestamp If not null, receive timestamp in micro-seconds. See UDPSocket::receive().
+        //! @return True on success, false on error.
+        //!
+        bool receiveOne(void* data,
+                        size_t max_size,
+                        size_t& ret_size,
+                        SocketAddress& sender,
+                        SocketAddress& destination,
+                        bool& accepted,
+                        const AbortInterface* abort = nullptr,
+                        Report& report = CERR,
+                        MicroSecond* timestamp = nullptr);
+
         // Override UDPSocket methods
         virtual bool open(Report& report = CERR) override;
         virtual bool receive(void* data,
@@ -95,6 +149,8 @@ namespace ts {
     private:
         bool                    _with_short_options;
         bool                    _dest_as_param;
+        bool                    _multiple_dest;      // Several destinations are allowed.
+        size_t                  _dest_count;         // Number of destinations in command line.
         bool                    _receiver_specified; // An address is specified.
         bool                    _use_ssm;            // Use source-specific multicast.
         SocketAddress           _dest_addr;          // Expected destination of packets.
@@ -1134,7 +1134,7 @@ bool ts::Buffer::putBit(uint8_t bit)
 // Internal "read bytes" method (1 to 8 bytes).
 //----------------------------------------------------------------------------
 
-const uint8_t* ts::Buffer::rdb(size_t bytes)
+const uint8_t* ts::Buffer::rdbInternal(size_t bytes)
 {
     // Internally used to read up to 8 bytes (64-bit integers).
     assert(bytes <= 8);
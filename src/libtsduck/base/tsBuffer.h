@@ -1296,7 +1296,21 @@ namespace ts {
         // - Otherwise, if current read pointer is at a byte boundary, return the read address in the buffer.
         // - If not byte aligned, read the bytes content into an internal 8-byte buffer, byte aligned, and return its address.
         // - Advance read pointer.
-        const uint8_t* rdb(size_t bytes);
+        // The byte-aligned case without error is inlined, this is the most common case.
+        const uint8_t* rdb(size_t bytes)
+        {
+            if (!_read_error && _state.rbit == 0 && _state.rbyte + bytes <= _state.wbyte) {
+                const uint8_t* const buf = _buffer + _state.rbyte;
+                _state.rbyte += bytes;
+                return buf;
+            }
+            else {
+                return rdbInternal(bytes);
+            }
+        }
+
+        // Non-inlined version of rdb(), all cases.
+        const uint8_t* rdbInternal(size_t bytes);
 
         // Internal put integer method.
         template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
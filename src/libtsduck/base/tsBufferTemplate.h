@@ -66,7 +66,21 @@ INT ts::Buffer::getBits(size_t bits)
 
     INT val = 0;
 
-    if (_big_endian) {
+    if (_big_endian && _state.rbit + bits <= 64) {
+        // Fast path, most common case: all bits are in the next 8 bytes.
+        // Load the involved bytes at once and extract the bits.
+        const size_t end_bit = _state.rbit + bits;
+        const size_t nbytes = (end_bit + 7) / 8;
+        uint64_t acc = 0;
+        for (size_t i = 0; i < nbytes; ++i) {
+            acc = (acc << 8) | _buffer[_state.rbyte + i];
+        }
+        acc >>= 8 * nbytes - end_bit;
+        val = static_cast<INT>(bits >= 64 ? acc : acc & ((uint64_t(1) << bits) - 1));
+        _state.rbyte += end_bit / 8;
+        _state.rbit = end_bit % 8;
+    }
+    else if (_big_endian) {
         // Read leading bits up to byte boundary
         while (bits > 0 && _state.rbit != 0) {
             val = INT(val << 1) | INT(getBit());
@@ -251,7 +265,19 @@ bool ts::Buffer::getBCD(INT& value, size_t bcd_count)
     }
     else {
         while (bcd_count-- > 0) {
-            UNSINT nibble = getBits<UNSINT>(4);
+            UNSINT nibble = 0;
+            if (_big_endian && !_read_error && (_state.rbit == 0 || _state.rbit == 4)) {
+                // Fast path, nibble-aligned, size already checked. After an invalid digit,
+                // getBits() is used, returning zero without moving the read pointer.
+                nibble = (_buffer[_state.rbyte] >> (4 - _state.rbit)) & 0x0F;
+                if ((_state.rbit += 4) == 8) {
+                    _state.rbyte++;
+                    _state.rbit = 0;
+                }
+            }
+            else {
+                nibble = getBits<UNSINT>(4);
+            }
             if (nibble > 9) {
                 _read_error = true;
                 nibble = 0;
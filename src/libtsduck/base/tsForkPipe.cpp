@@ -31,6 +31,7 @@
 #include "tsNullReport.h"
 #include "tsMemory.h"
 #include "tsIntegerUtils.h"
+#include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
 // Index of pipe file descriptors on UNIX.
@@ -308,6 +309,11 @@ bool ts::ForkPipe::open(const UString& command, WaitMode wait_mode, size_t buffe
         return false;
     }
 
+    // Enlarge the pipe buffer to reduce context switches with the created process.
+    if (_use_pipe) {
+        SetPipeSize(filedes[PIPE_WRITEFD], buffer_size == 0 ? DEFAULT_PIPE_SIZE : buffer_size, report);
+    }
+
     // Create the forked process
     if (_wait_mode == EXIT_PROCESS) {
         // Don't fork, the parent process will directly call exec().
@@ -571,7 +577,7 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
             // Normal case, some data were written
             assert(outsize <= remain);
             data += outsize;
-            remain -= std::max(remain, outsize);
+            remain -= std::min(remain, outsize);
             written_size += size_t(outsize);
         }
         else {
@@ -595,7 +601,7 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
             // Normal case, some data were written
             assert(size_t(outsize) <= remain);
             data += outsize;
-            remain -= std::max(remain, size_t(outsize));
+            remain -= std::min(remain, size_t(outsize));
             written_size += size_t(outsize);
         }
         else if ((error_code = LastErrorCode()) != EINTR) {
@@ -32,6 +32,13 @@
 //----------------------------------------------------------------------------
 
 #include "tsMemory.h"
+#if defined(TS_X86_64) || defined(__SSE2__)
+    #define TS_SSE2_START_CODES 1
+    #include <emmintrin.h>
+#elif defined(TS_ARM64)
+    #define TS_NEON_START_CODES 1
+    #include <arm_neon.h>
+#endif
 TSDUCK_SOURCE;
 
 
@@ -71,6 +78,80 @@ const void* ts::LocatePattern(const void* area, size_t area_size, const void* pa
 }
 
 
+//----------------------------------------------------------------------------
+// Locate the next 00 00 00 or 00 00 01 sequence into a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateZeroZero(const uint8_t* area, size_t area_size)
+{
+    if (area == nullptr || area_size < 3) {
+        return nullptr;
+    }
+
+    const uint8_t* cur = area;
+    const uint8_t* const end = area + area_size;
+
+#if defined(TS_SSE2_START_CODES)
+
+    // Check 16 positions at a time: a sequence starts at index i when
+    // cur[i] == 0, cur[i+1] == 0 and (cur[i+2] & 0xFE) == 0.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask_fe = _mm_set1_epi8(char(0xFE));
+    while (end - cur >= 18) {
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 1));
+        const __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 2));
+        const __m128i hit = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)),
+                                          _mm_cmpeq_epi8(_mm_and_si128(b2, mask_fe), zero));
+        int bits = _mm_movemask_epi8(hit);
+        if (bits != 0) {
+            while ((bits & 1) == 0) {
+                bits >>= 1;
+                ++cur;
+            }
+            return cur;
+        }
+        cur += 16;
+    }
+
+#elif defined(TS_NEON_START_CODES)
+
+    // Same principle as SSE2. NEON has no "movemask", so the exact position
+    // inside a block with a hit is found by the scalar loop below.
+    const uint8x16_t mask_fe = vdupq_n_u8(0xFE);
+    while (end - cur >= 18) {
+        const uint8x16_t b0 = vld1q_u8(cur);
+        const uint8x16_t b1 = vld1q_u8(cur + 1);
+        const uint8x16_t b2 = vld1q_u8(cur + 2);
+        const uint8x16_t any = vorrq_u8(vorrq_u8(b0, b1), vandq_u8(b2, mask_fe));
+        if (vminvq_u8(any) == 0) {
+            break;
+        }
+        cur += 16;
+    }
+
+#endif
+
+    // Portable version, also used for the last bytes. We look at the third
+    // byte first, which allows to skip up to 3 bytes at a time.
+    while (end - cur >= 3) {
+        if (cur[2] > 1) {
+            cur += 3;
+        }
+        else if (cur[1] != 0) {
+            cur += 2;
+        }
+        else if (cur[0] != 0) {
+            cur += 1;
+        }
+        else {
+            return cur;
+        }
+    }
+    return nullptr;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a memory area contains all identical byte values.
 //----------------------------------------------------------------------------
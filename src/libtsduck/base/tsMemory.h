@@ -78,6 +78,19 @@ namespace ts {
     //!
     TSDUCKDLL const void* LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size);
 
+    //!
+    //! Locate the next 3-byte sequence 00 00 00 or 00 00 01 into a memory area.
+    //! In MPEG-2 video, AVC and HEVC elementary streams, 00 00 01 is a start code prefix
+    //! and 00 00 00 can only appear after the end of a NAL unit. This function is much faster
+    //! than LocatePattern() for this purpose: it uses vector instructions when available
+    //! (SSE2 on Intel, NEON on Arm) and finds both sequences in one single pass.
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @return Address of the first 00 00 00 or 00 00 01 sequence in @a area or zero if not found.
+    //! The third byte of the returned sequence tells which one was found.
+    //!
+    TSDUCKDLL const uint8_t* LocateZeroZero(const uint8_t* area, size_t area_size);
+
     //!
     //! Check if a memory area contains all identical byte values.
     //! @param [in] area Address of a memory area to check.
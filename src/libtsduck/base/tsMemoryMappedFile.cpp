@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMemoryMappedFile.h"
+#include "tsSysUtils.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::MemoryMappedFile::MemoryMappedFile() :
+    _address(nullptr),
+    _size(0)
+#if defined(TS_WINDOWS)
+    , _mapping(INVALID_HANDLE_VALUE)
+#endif
+{
+}
+
+ts::MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Map a file in memory.
+//----------------------------------------------------------------------------
+
+bool ts::MemoryMappedFile::open(const UString& fileName, Report& report)
+{
+    // Unmap previous file, if any.
+    close();
+
+#if defined(TS_WINDOWS)
+
+    ::HANDLE file = ::CreateFileW(fileName.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        report.error(u"cannot open %s: %s", {fileName, ErrorCodeMessage()});
+        return false;
+    }
+
+    ::LARGE_INTEGER size;
+    if (::GetFileSizeEx(file, &size) == 0 || size.QuadPart <= 0) {
+        report.error(u"cannot map %s: empty or invalid file", {fileName});
+        ::CloseHandle(file);
+        return false;
+    }
+
+    // The file handle is no longer needed once the mapping object is created.
+    _mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (_mapping == nullptr) {
+        _mapping = INVALID_HANDLE_VALUE;
+        report.error(u"cannot map %s: %s", {fileName, ErrorCodeMessage()});
+        return false;
+    }
+
+    _address = reinterpret_cast<const uint8_t*>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (_address == nullptr) {
+        report.error(u"cannot map %s: %s", {fileName, ErrorCodeMessage()});
+        ::CloseHandle(_mapping);
+        _mapping = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    _size = size_t(size.QuadPart);
+
+#else
+
+    const int fd = ::open(fileName.toUTF8().c_str(), O_RDONLY);
+    if (fd < 0) {
+        report.error(u"cannot open %s: %s", {fileName, ErrorCodeMessage()});
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || st.st_size <= 0) {
+        report.error(u"cannot map %s: empty or invalid file", {fileName});
+        ::close(fd);
+        return false;
+    }
+
+    // The file descriptor is no longer needed once the file is mapped.
+    void* addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        report.error(u"cannot map %s: %s", {fileName, ErrorCodeMessage()});
+        return false;
+    }
+    _address = reinterpret_cast<const uint8_t*>(addr);
+    _size = size_t(st.st_size);
+
+#endif
+
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Unmap the file.
+//----------------------------------------------------------------------------
+
+void ts::MemoryMappedFile::close()
+{
+    if (_address != nullptr) {
+#if defined(TS_WINDOWS)
+        ::UnmapViewOfFile(_address);
+        ::CloseHandle(_mapping);
+        _mapping = INVALID_HANDLE_VALUE;
+#else
+        ::munmap(const_cast<uint8_t*>(_address), _size);
+#endif
+        _address = nullptr;
+        _size = 0;
+    }
+}
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only memory-mapped file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Read-only memory-mapped file.
+    //! @ingroup system
+    //!
+    //! The content of the file is mapped in the virtual memory of the process.
+    //! Pages are loaded from the file on demand and shared between all processes
+    //! which map the same file.
+    //!
+    class TSDUCKDLL MemoryMappedFile
+    {
+        TS_NOCOPY(MemoryMappedFile);
+    public:
+        //!
+        //! Default constructor.
+        //!
+        MemoryMappedFile();
+
+        //!
+        //! Destructor, unmap the file.
+        //!
+        ~MemoryMappedFile();
+
+        //!
+        //! Map a file in memory.
+        //! @param [in] fileName Name of the file to map.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& fileName, Report& report);
+
+        //!
+        //! Unmap the file.
+        //!
+        void close();
+
+        //!
+        //! Check if the file is currently mapped.
+        //! @return True if the file is currently mapped.
+        //!
+        bool isOpen() const { return _address != nullptr; }
+
+        //!
+        //! Get the base address of the mapped file.
+        //! @return The base address of the mapped file or a null pointer if the file is not mapped.
+        //!
+        const uint8_t* data() const { return _address; }
+
+        //!
+        //! Get the size of the mapped file.
+        //! @return The size in bytes of the mapped file.
+        //!
+        size_t size() const { return _size; }
+
+    private:
+        const uint8_t* _address;  // Base address of the mapped file.
+        size_t         _size;     // Size in bytes of the mapped file.
+#if defined(TS_WINDOWS)
+        ::HANDLE       _mapping;  // Handle of the file mapping object.
+#endif
+    };
+}
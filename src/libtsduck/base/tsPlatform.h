@@ -851,6 +851,7 @@ TS_MSC_NOWARNING(5204)
 #include <sys/time.h>
 #include <sys/wait.h>
 #include <sys/socket.h>
+#include <poll.h>
 #include <netdb.h>
 #include <net/if.h>
 #include <netinet/in.h>
@@ -2287,6 +2288,19 @@ typedef platform_specific TS_SOCKET_MC_TTL_T;
 //!
 typedef platform_specific TS_SOCKET_PKTINFO_T;
 
+//!
+//! Data type for the description of a socket in a poll() system call.
+//! Example:
+//! @code
+//! TS_SOCKET_POLLFD_T fds[2];
+//! fds[0].fd = sock1;
+//! fds[0].events = POLLIN;
+//! ...
+//! int count = TS_SOCKET_POLL(fds, 2, timeout_ms);
+//! @endcode
+//!
+typedef platform_specific TS_SOCKET_POLLFD_T;
+
 //!
 //! Type conversion macro for the address of a socket option value.
 //! The "standard" parameter type is @c void* but some systems use other exotic values.
@@ -2375,6 +2389,13 @@ typedef platform_specific TS_SOCKET_PKTINFO_T;
 //!
 #define TS_SOCKET_ERR_NOTCONN platform_specific
 
+//!
+//! Name of the poll() system call which applies to socket devices.
+//! The "standard" name is @c poll but some systems use other exotic names.
+//! @see TS_SOCKET_POLLFD_T
+//!
+#define TS_SOCKET_POLL platform_specific
+
 #elif defined(TS_WINDOWS)
 
 #define TS_SOCKET_L_LINGER_T(x) (static_cast<u_short>(x))
@@ -2389,6 +2410,7 @@ typedef platform_specific TS_SOCKET_PKTINFO_T;
 #define TS_SOCKET_SHUT_WR       SD_SEND
 #define TS_SOCKET_ERR_RESET     WSAECONNRESET
 #define TS_SOCKET_ERR_NOTCONN   WSAENOTCONN
+#define TS_SOCKET_POLL          ::WSAPoll
 
 typedef ::SOCKET TS_SOCKET_T;
 typedef int TS_SOCKET_SOCKLEN_T;
@@ -2397,6 +2419,7 @@ typedef ::DWORD TS_SOCKET_TOS_T;
 typedef ::DWORD TS_SOCKET_TTL_T;
 typedef ::DWORD TS_SOCKET_MC_TTL_T;
 typedef ::DWORD TS_SOCKET_PKTINFO_T;
+typedef ::WSAPOLLFD TS_SOCKET_POLLFD_T;
 
 #elif defined(TS_UNIX)
 
@@ -2412,6 +2435,7 @@ typedef ::DWORD TS_SOCKET_PKTINFO_T;
 #define TS_SOCKET_SHUT_WR       SHUT_WR
 #define TS_SOCKET_ERR_RESET     EPIPE
 #define TS_SOCKET_ERR_NOTCONN   ENOTCONN
+#define TS_SOCKET_POLL          ::poll
 
 typedef int TS_SOCKET_T;
 typedef ::socklen_t TS_SOCKET_SOCKLEN_T;
@@ -2420,6 +2444,7 @@ typedef int TS_SOCKET_TOS_T;
 typedef int TS_SOCKET_TTL_T;
 typedef unsigned char TS_SOCKET_MC_TTL_T;
 typedef int TS_SOCKET_PKTINFO_T;
+typedef struct ::pollfd TS_SOCKET_POLLFD_T;
 
 #else
 #error "check socket compatibility macros on this platform"
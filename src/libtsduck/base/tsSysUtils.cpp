@@ -955,6 +955,35 @@ void ts::GetProcessMetrics(ProcessMetrics& metrics)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the CPU time of the current thread.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::GetThreadCPUTime()
+{
+#if defined(TS_WINDOWS)
+
+    // Kernel and user times are durations in 100-nanosecond units.
+    ::FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time) == 0) {
+        return 0;
+    }
+    const uint64_t kernel = (uint64_t(kernel_time.dwHighDateTime) << 32) | kernel_time.dwLowDateTime;
+    const uint64_t user = (uint64_t(user_time.dwHighDateTime) << 32) | user_time.dwLowDateTime;
+    return NanoSecond(kernel + user) * 100;
+
+#else
+
+    ::timespec cpu;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) != 0) {
+        return 0;
+    }
+    return NanoSecond(cpu.tv_sec) * NanoSecPerSec + NanoSecond(cpu.tv_nsec);
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Ignore SIGPIPE. On UNIX systems: writing to a broken pipe returns an
 // error instead of killing the process. On Windows systems: does nothing.
@@ -968,6 +997,34 @@ void ts::IgnorePipeSignal()
 }
 
 
+//----------------------------------------------------------------------------
+// Set the size of the kernel buffer of a pipe.
+//----------------------------------------------------------------------------
+
+size_t ts::SetPipeSize(int fd, size_t size, Report& report)
+{
+#if defined(TS_LINUX)
+    int result = ::fcntl(fd, F_SETPIPE_SZ, int(std::min<size_t>(size, std::numeric_limits<int>::max())));
+    if (result < 0 && errno == EPERM) {
+        // Above the limit for unprivileged processes, use this limit.
+        UStringList lines;
+        size_t max_size = 0;
+        if (UString::Load(lines, u"/proc/sys/fs/pipe-max-size") && !lines.empty() && lines.front().toInteger(max_size) && max_size < size) {
+            report.debug(u"pipe size limited to %'d bytes", {max_size});
+            result = ::fcntl(fd, F_SETPIPE_SZ, int(max_size));
+        }
+    }
+    if (result < 0) {
+        report.debug(u"error setting pipe size to %'d bytes: %s", {size, ErrorCodeMessage()});
+        return 0;
+    }
+    return size_t(result);
+#else
+    return 0;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Put standard input / output stream in binary mode.
 // On UNIX systems, this does not make any difference.
@@ -642,6 +642,15 @@ namespace ts {
     //!
     TSDUCKDLL void GetProcessMetrics(ProcessMetrics& metrics);
 
+    //!
+    //! Get the CPU time of the current thread (user and system).
+    //! Unlike a monotonic clock, this time does not progress while the thread is
+    //! waiting or preempted. This is suitable to measure the actual processing cost
+    //! of a thread.
+    //! @return The CPU time of the current thread in nanoseconds or zero on error.
+    //!
+    TSDUCKDLL NanoSecond GetThreadCPUTime();
+
     //!
     //! Ensure that writing to a broken pipe does not kill the current process.
     //!
@@ -658,6 +667,32 @@ namespace ts {
     //!
     TSDUCKDLL void IgnorePipeSignal();
 
+    //!
+    //! Default size in bytes of the kernel buffer of pipes which are created or used by TSDuck.
+    //! This is the default maximum size for unprivileged processes on Linux.
+    //!
+    constexpr size_t DEFAULT_PIPE_SIZE = 1024 * 1024;
+
+    //!
+    //! Set the size of the kernel buffer of a pipe.
+    //!
+    //! A larger pipe buffer reduces the number of context switches between the
+    //! writer and the reader processes when large amounts of data are transferred.
+    //!
+    //! <strong>Linux:</strong> The size is set using F_SETPIPE_SZ. When the requested
+    //! size exceeds the maximum size for unprivileged processes (/proc/sys/fs/pipe-max-size),
+    //! this maximum size is used instead.
+    //!
+    //! <strong>Other systems:</strong> This function does nothing. On Windows, the
+    //! buffer size of a pipe can be specified only when the pipe is created.
+    //!
+    //! @param [in] fd File descriptor of either end of the pipe.
+    //! @param [in] size Requested size in bytes of the pipe buffer.
+    //! @param [in,out] report Where to report errors.
+    //! @return The actual size in bytes of the pipe buffer or zero if it cannot be set.
+    //!
+    TSDUCKDLL size_t SetPipeSize(int fd, size_t size, Report& report);
+
     //!
     //! Check if the standard input is a terminal.
     //! @return True if the standard input is a terminal.
@@ -38,7 +38,8 @@ TSDUCK_SOURCE;
 ts::TextParser::TextParser(Report& report) :
     _report(report),
     _lines(),
-    _pos(_lines)
+    _pos(_lines),
+    _stream(nullptr)
 {
 }
 
@@ -75,6 +76,7 @@ void ts::TextParser::clear()
 {
     _lines.clear();
     _pos = Position(_lines);
+    _stream = nullptr;
 }
 
 
@@ -86,16 +88,20 @@ void ts::TextParser::loadDocument(const UStringList& lines)
 {
     _lines.clear();
     _pos = Position(lines);
+    _stream = nullptr;
 }
 
 void ts::TextParser::loadDocument(const UString& text)
 {
     text.toSubstituted(u"\r", UString()).split(_lines, u'\n', false);
     _pos = Position(_lines);
+    _stream = nullptr;
 }
 
 bool ts::TextParser::loadFile(const UString& fileName)
 {
+    _stream = nullptr;
+
     // Load the file into the internal lines buffer.
     const bool ok = UString::Load(_lines, fileName);
     if (!ok) {
@@ -109,6 +115,8 @@ bool ts::TextParser::loadFile(const UString& fileName)
 
 bool ts::TextParser::loadStream(std::istream& strm)
 {
+    _stream = nullptr;
+
     // Load the file into the internal lines buffer.
     const bool ok = UString::Load(_lines, strm);
     if (!ok) {
@@ -121,6 +129,52 @@ bool ts::TextParser::loadStream(std::istream& strm)
 }
 
 
+//----------------------------------------------------------------------------
+// Load the document to parse incrementally from a text stream.
+//----------------------------------------------------------------------------
+
+void ts::TextParser::loadStreamIncremental(std::istream& strm)
+{
+    _lines.clear();
+    _pos = Position(_lines);
+    _stream = &strm;
+    fetchLine();
+}
+
+void ts::TextParser::fetchLine()
+{
+    if (_stream != nullptr && _pos._lines == &_lines && _pos._curLine == _lines.end()) {
+        UString line;
+        if (line.getLine(*_stream)) {
+            _lines.push_back(line);
+            _pos._curLine = --_lines.end();
+        }
+        else {
+            // End of stream, no longer read from it.
+            if (!_stream->eof()) {
+                _report.error(u"error reading input document");
+            }
+            _stream = nullptr;
+        }
+    }
+}
+
+void ts::TextParser::nextLine()
+{
+    _pos._curLine++;
+    _pos._curLineNumber++;
+    _pos._curIndex = 0;
+    fetchLine();
+}
+
+void ts::TextParser::discardPreviousLines()
+{
+    if (_pos._lines == &_lines) {
+        _lines.erase(_lines.begin(), _pos._curLine);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Save the document to parse to a text file.
 //----------------------------------------------------------------------------
@@ -190,9 +244,7 @@ bool ts::TextParser::skipWhiteSpace()
             return true;
         }
         // Move to next line.
-        _pos._curLine++;
-        _pos._curLineNumber++;
-        _pos._curIndex = 0;
+        nextLine();
     }
     return true;
 }
@@ -205,9 +257,7 @@ bool ts::TextParser::skipWhiteSpace()
 bool ts::TextParser::skipLine()
 {
     while (_pos._curLine != _pos._lines->end()) {
-        _pos._curLine++;
-        _pos._curLineNumber++;
-        _pos._curIndex = 0;
+        nextLine();
     }
     return true;
 }
@@ -469,9 +519,7 @@ bool ts::TextParser::parseText(UString& result, const UString endToken, bool ski
             // End token not found, include the complete end of line.
             result.append(*_pos._curLine, _pos._curIndex);
             result.append(LINE_FEED);
-            _pos._curLine++;
-            _pos._curLineNumber++;
-            _pos._curIndex = 0;
+            nextLine();
         }
         else {
             // Found end token, stop here.
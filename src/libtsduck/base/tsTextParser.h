@@ -103,6 +103,23 @@ namespace ts {
         //!
         bool loadStream(std::istream& strm);
 
+        //!
+        //! Load the document to parse incrementally from a text stream.
+        //! The lines are read from the stream only when the parser needs them.
+        //! Used with discardPreviousLines(), this allows parsing very large
+        //! documents with a memory usage which does not depend on the document size.
+        //! @param [in,out] strm A standard text stream in input mode.
+        //! The lifetime of the stream must equals or exceeds the lifetime of the parser.
+        //!
+        void loadStreamIncremental(std::istream& strm);
+
+        //!
+        //! Release all lines before the current position in the document.
+        //! This is useful when the document is incrementally loaded from a stream.
+        //! All previously saved positions before the current line become invalid.
+        //!
+        void discardPreviousLines();
+
         //!
         //! Save the document to parse to a text file.
         //! @param [in] fileName Name of the file to save.
@@ -271,8 +288,15 @@ namespace ts {
         virtual bool parseJSONStringLiteral(UString& str);
 
     private:
-        Report&     _report;
-        UStringList _lines;
-        Position    _pos;
+        Report&       _report;
+        UStringList   _lines;
+        Position      _pos;
+        std::istream* _stream;  // Incremental input stream, if any.
+
+        // Move to the next line, read it from the incremental stream if necessary.
+        void nextLine();
+
+        // When the current position is at end of document, read one more line from the incremental stream.
+        void fetchLine();
     };
 }
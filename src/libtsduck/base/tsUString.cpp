@@ -36,6 +36,16 @@
 #include "tsUString.h"
 #include "tsByteBlock.h"
 #include "tsSysUtils.h"
+#if defined(TS_X86_64) || defined(__SSE2__)
+    #define TS_SSE2_UTF 1
+    #include <emmintrin.h>
+    #if defined(TS_MSC)
+        #include <intrin.h>
+    #endif
+#elif defined(TS_ARM64)
+    #define TS_NEON_UTF 1
+    #include <arm_neon.h>
+#endif
 TSDUCK_SOURCE;
 
 // The UTF-8 Byte Order Mark
@@ -89,12 +99,147 @@ const ::WCHAR* ts::UString::wc_str() const
 #endif
 
 
+//----------------------------------------------------------------------------
+// Fast paths for runs of ASCII characters in UTF-8 / UTF-16 conversions.
+// Most strings (file names, XML and JSON texts, log messages) are mostly
+// ASCII. These functions convert as many characters as possible, 16 at a
+// time with SIMD instructions (8 at a time without). They stop on the first
+// non-ASCII character (or the block which contains it, when its position is
+// not cheaply available) or when there is no room for a complete block. The
+// general conversion loop processes the rest.
+//----------------------------------------------------------------------------
+
+namespace {
+
+#if defined(TS_SSE2_UTF)
+    // Index of the lowest bit set in a non-zero SSE2 mask.
+    inline size_t LowestBit(uint32_t mask)
+    {
+    #if defined(TS_GCC) || defined(TS_LLVM)
+        return size_t(__builtin_ctz(mask));
+    #elif defined(TS_MSC)
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return size_t(index);
+    #else
+        size_t index = 0;
+        while ((mask & 1) == 0) {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+    #endif
+    }
+#endif
+
+    // UTF-8 to UTF-16.
+    inline void WidenASCII(const char*& in, const char* inEnd, ts::UChar*& out, const ts::UChar* outEnd)
+    {
+#if defined(TS_SSE2_UTF)
+        const __m128i zero = _mm_setzero_si128();
+        while (inEnd - in >= 16 && outEnd - out >= 16) {
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const uint32_t non_ascii = uint32_t(_mm_movemask_epi8(b));
+            // Always store 16 characters, those after the first non-ASCII one will be overwritten.
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(b, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(b, zero));
+            if (non_ascii != 0) {
+                const size_t count = LowestBit(non_ascii);
+                in += count;
+                out += count;
+                break;
+            }
+            in += 16;
+            out += 16;
+        }
+#elif defined(TS_NEON_UTF)
+        while (inEnd - in >= 16 && outEnd - out >= 16) {
+            const uint8x16_t b = vld1q_u8(reinterpret_cast<const uint8_t*>(in));
+            if (vmaxvq_u8(b) >= 0x80) {
+                break; // at least one non-ASCII byte
+            }
+            vst1q_u16(reinterpret_cast<uint16_t*>(out), vmovl_u8(vget_low_u8(b)));
+            vst1q_u16(reinterpret_cast<uint16_t*>(out + 8), vmovl_u8(vget_high_u8(b)));
+            in += 16;
+            out += 16;
+        }
+#else
+        while (inEnd - in >= 8 && outEnd - out >= 8) {
+            uint64_t w;
+            ::memcpy(&w, in, 8);
+            if ((w & TS_UCONST64(0x8080808080808080)) != 0) {
+                break; // at least one non-ASCII byte
+            }
+            for (size_t i = 0; i < 8; ++i) {
+                out[i] = ts::UChar(uint8_t(in[i]));
+            }
+            in += 8;
+            out += 8;
+        }
+#endif
+    }
+
+    // UTF-16 to UTF-8.
+    inline void NarrowASCII(const ts::UChar*& in, const ts::UChar* inEnd, char*& out, const char* outEnd)
+    {
+#if defined(TS_SSE2_UTF)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i non_ascii = _mm_set1_epi16(short(0xFF80));
+        while (inEnd - in >= 16 && outEnd - out >= 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+            // One bit per byte of the two vectors, i.e. two bits per non-ASCII character.
+            const uint32_t ascii_a = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(a, non_ascii), zero)));
+            const uint32_t ascii_b = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(b, non_ascii), zero)));
+            const uint32_t mask = ~(ascii_a | (ascii_b << 16));
+            // Always store 16 bytes, those after the first non-ASCII character will be overwritten.
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+            if (mask != 0) {
+                const size_t count = LowestBit(mask) / 2;
+                in += count;
+                out += count;
+                break;
+            }
+            in += 16;
+            out += 16;
+        }
+#elif defined(TS_NEON_UTF)
+        while (inEnd - in >= 16 && outEnd - out >= 16) {
+            const uint16x8_t a = vld1q_u16(reinterpret_cast<const uint16_t*>(in));
+            const uint16x8_t b = vld1q_u16(reinterpret_cast<const uint16_t*>(in + 8));
+            if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) {
+                break; // at least one non-ASCII character
+            }
+            vst1q_u8(reinterpret_cast<uint8_t*>(out), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+            in += 16;
+            out += 16;
+        }
+#else
+        while (inEnd - in >= 8 && outEnd - out >= 8) {
+            if (((in[0] | in[1] | in[2] | in[3] | in[4] | in[5] | in[6] | in[7]) & 0xFF80) != 0) {
+                break; // at least one non-ASCII character
+            }
+            for (size_t i = 0; i < 8; ++i) {
+                out[i] = char(in[i]);
+            }
+            in += 8;
+            out += 8;
+        }
+#endif
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // General routine to convert from UTF-16 to UTF-8.
 //----------------------------------------------------------------------------
 
-void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStart, const UChar* inEnd, char*& outStart, char* outEnd)
+void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStartRef, const UChar* inEnd, char*& outStartRef, char* outEnd)
 {
+    // Work on local copies of the pointers. Since the output is made of char, the
+    // compiler would otherwise reload the referenced pointers after each store.
+    const UChar* inStart = inStartRef;
+    char* outStart = outStartRef;
     uint32_t code;
     uint32_t high6;
 
@@ -147,7 +292,11 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStart, const UChar* inEnd,
             // The 16-bit value is the code point.
             if (code < 0x0080) {
                 // ASCII compatible value, one byte encoding.
+                // If the next one is ASCII too, we are probably in an ASCII run, use the fast path.
                 *outStart++ = char(code);
+                if (inStart < inEnd && *inStart < 0x0080) {
+                    NarrowASCII(inStart, inEnd, outStart, outEnd);
+                }
             }
             else if (code < 0x800 && outStart + 1 < outEnd) {
                 // 2 bytes encoding.
@@ -172,6 +321,9 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStart, const UChar* inEnd,
             }
         }
     }
+
+    inStartRef = inStart;
+    outStartRef = outStart;
 }
 
 
@@ -205,8 +357,11 @@ std::ostream& operator<<(std::ostream& strm, const ts::UChar c)
 // General routine to convert from UTF-8 to UTF-16.
 //----------------------------------------------------------------------------
 
-void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UChar*& outStart, UChar* outEnd)
+void ts::UString::ConvertUTF8ToUTF16(const char*& inStartRef, const char* inEnd, UChar*& outStartRef, UChar* outEnd)
 {
+    // Work on local copies of the pointers, see ConvertUTF16ToUTF8().
+    const char* inStart = inStartRef;
+    UChar* outStart = outStartRef;
     uint32_t code;
 
     while (inStart < inEnd && outStart < outEnd) {
@@ -220,7 +375,11 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
 
         if (code < 0x80) {
             // 0xxx xxxx, ASCII compatible value, one byte encoding.
+            // If the next one is ASCII too, we are probably in an ASCII run, use the fast path.
             *outStart++ = uint16_t(code);
+            if (inStart < inEnd && (*inStart & 0x80) == 0) {
+                WidenASCII(inStart, inEnd, outStart, outEnd);
+            }
         }
         else if ((code & 0xE0) == 0xC0) {
             // 110x xxx, 2 byte encoding.
@@ -270,6 +429,9 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
             assert((code & 0xC0) == 0x80 || (code & 0xF8) == 0xF8);
         }
     }
+
+    inStartRef = inStart;
+    outStartRef = outStart;
 }
 
 
@@ -1631,204 +1793,379 @@ void ts::UString::appendDump(const ByteBlock& bb,
     appendDump(bb.data(), bb.size(), flags, indent, line_width, init_offset, inner_indent);
 }
 
+std::ostream& ts::UString::Dump(std::ostream& strm,
+                                const ByteBlock& bb,
+                                uint32_t flags,
+                                size_type indent,
+                                size_type line_width,
+                                size_type init_offset,
+                                size_type inner_indent)
+{
+    return Dump(strm, bb.data(), bb.size(), flags, indent, line_width, init_offset, inner_indent);
+}
+
 
 //----------------------------------------------------------------------------
-// Build a multi-line string containing the hexadecimal dump of a memory area.
+// Layout of an hexadecimal dump. The layout is computed once from the
+// flags and sizes. Lines are then formatted directly in a character buffer,
+// either UChar (appendDump) or char (Dump on a stream), using lookup tables.
 //----------------------------------------------------------------------------
 
-void ts::UString::appendDump(const void *data,
-                             size_type size,
-                             uint32_t flags,
-                             size_type indent,
-                             size_type line_width,
-                             size_type init_offset,
-                             size_type inner_indent)
-{
-    // Do nothing in case of invalid or empty data.
-    if (data == nullptr || size == 0) {
-        return;
-    }
+namespace {
+    const char HexaDigits[] = "0123456789ABCDEF";
 
-    // Work an area of bytes.
-    const uint8_t* raw = static_cast<const uint8_t*>(data);
+    class DumpLayout
+    {
+    public:
+        // Constructor: compute the layout.
+        DumpLayout(size_t size, uint32_t flags, size_t indent, size_t line_width, size_t init_offset, size_t inner_indent);
+
+        // Check if the dump is on one single line.
+        bool singleLine() const { return (_flags & ts::UString::SINGLE_LINE) != 0; }
+
+        // Max number of characters in a single line dump, per byte.
+        size_t singleLineByteWidth() const { return _hexa_width + 1; }
+
+        // Number of dumped bytes per line and number of lines in multi-line mode.
+        size_t bytesPerLine() const { return _bytes_per_line; }
+        size_t lineCount() const { return (_size + _bytes_per_line - 1) / _bytes_per_line; }
+
+        // Max number of characters in one line in multi-line mode, including the new-line.
+        size_t maxLineWidth() const { return _max_line_width; }
+
+        // Format a part of a single-line dump, starting at index 'first' in data.
+        // Return a pointer after the last written character.
+        template <typename CHAR>
+        CHAR* formatSingleLine(CHAR* out, const uint8_t* data, size_t first, size_t count) const;
+
+        // Format one line in multi-line mode, starting at index 'line' in data.
+        // Trailing spaces are removed, up to 'floor'. Return a pointer after the final new-line.
+        template <typename CHAR>
+        CHAR* formatLine(CHAR* out, const CHAR* floor, const uint8_t* data, size_t line) const;
+
+    private:
+        size_t   _size;
+        uint32_t _flags;
+        size_t   _indent;
+        size_t   _init_offset;
+        size_t   _inner_indent;
+        size_t   _hexa_width;      // Width of an hexa byte: "XX" (2) or "0xXX," (5)
+        size_t   _offset_width;    // Width of offset field
+        size_t   _bin_width;       // Width of a binary byte
+        size_t   _bytes_per_line;
+        size_t   _max_line_width;
+
+        // Fill with spaces.
+        template <typename CHAR>
+        static CHAR* Spaces(CHAR* out, size_t count)
+        {
+            return std::fill_n(out, count, CHAR(' '));
+        }
+    };
+}
 
+DumpLayout::DumpLayout(size_t size, uint32_t flags, size_t indent, size_t line_width, size_t init_offset, size_t inner_indent) :
+    _size(size),
+    _flags(flags),
+    _indent(indent),
+    _init_offset(init_offset),
+    _inner_indent(inner_indent),
+    _hexa_width(0),
+    _offset_width(0),
+    _bin_width(0),
+    _bytes_per_line(0),
+    _max_line_width(0)
+{
     // Make sure we have something to display (default is hexa)
-    if ((flags & (HEXA | C_STYLE | BINARY | BIN_NIBBLE | ASCII)) == 0) {
-        flags |= HEXA;
+    if ((_flags & (ts::UString::HEXA | ts::UString::C_STYLE | ts::UString::BINARY | ts::UString::BIN_NIBBLE | ts::UString::ASCII)) == 0) {
+        _flags |= ts::UString::HEXA;
     }
-    if ((flags & COMPACT) != 0) {
+    if ((_flags & ts::UString::COMPACT) != 0) {
         // COMPACT implies SINGLE_LINE.
-        flags |= SINGLE_LINE;
+        _flags |= ts::UString::SINGLE_LINE;
     }
 
     // Width of an hexa byte: "XX" (2) or "0xXX," (5)
-    size_type hexa_width = 0;
-    UString byte_prefix;
-    UString byte_suffix;
-
-    if (flags & C_STYLE) {
-        hexa_width  = 5;
-        byte_prefix = u"0x";
-        byte_suffix = u",";
-        flags |= HEXA; // Enforce hexa flag
+    if (_flags & ts::UString::C_STYLE) {
+        _hexa_width = 5;
+        _flags |= ts::UString::HEXA; // Enforce hexa flag
     }
-    else if (flags & (HEXA | SINGLE_LINE)) {
-        hexa_width  = 2;
-    }
-    else {
-        hexa_width  = 0;
+    else if (_flags & (ts::UString::HEXA | ts::UString::SINGLE_LINE)) {
+        _hexa_width = 2;
     }
 
     // Specific case: simple dump, everything on one line.
-    if (flags & SINGLE_LINE) {
-        reserve(length() + (hexa_width + 1) * size);
-        for (size_type i = 0; i < size; ++i) {
-            if (i > 0 && (flags & COMPACT) == 0) {
-                append(1, u' ');
-            }
-            append(byte_prefix);
-            append(Hexa(raw[i], 0, UString(), false, true));
-            append(byte_suffix);
-        }
+    if (_flags & ts::UString::SINGLE_LINE) {
         return;
     }
 
     // Width of offset field
-    size_type offset_width;
-
-    if ((flags & OFFSET) == 0) {
-        offset_width = 0;
+    if ((_flags & ts::UString::OFFSET) == 0) {
+        _offset_width = 0;
     }
-    else if (flags & WIDE_OFFSET) {
-        offset_width = 8;
+    else if (_flags & ts::UString::WIDE_OFFSET) {
+        _offset_width = 8;
     }
     else if (init_offset + size <= 0x10000) {
-        offset_width = 4;
+        _offset_width = 4;
     }
     else {
-        offset_width = 8;
+        _offset_width = 8;
     }
 
     // Width of a binary byte
-    size_type bin_width;
-
-    if (flags & BIN_NIBBLE) {
-        bin_width = 9;
-        flags |= BINARY;  // Enforce binary flag
-    }
-    else if (flags & BINARY) {
-        bin_width = 8;
+    if (_flags & ts::UString::BIN_NIBBLE) {
+        _bin_width = 9;
+        _flags |= ts::UString::BINARY;  // Enforce binary flag
     }
-    else {
-        bin_width = 0;
+    else if (_flags & ts::UString::BINARY) {
+        _bin_width = 8;
     }
 
-    // Pre-allocation to avoid too frequent reallocations.
-    reserve(length() + indent + inner_indent + (hexa_width + bin_width + 5) * size);
-
     // Number of non-byte characters
-    size_type add_width = indent + inner_indent;
-    if (offset_width != 0) {
-        add_width += offset_width + 3;
+    size_t add_width = indent + inner_indent;
+    if (_offset_width != 0) {
+        add_width += _offset_width + 3;
     }
-    if ((flags & HEXA) && (flags & (BINARY | ASCII))) {
+    if ((_flags & ts::UString::HEXA) && (_flags & (ts::UString::BINARY | ts::UString::ASCII))) {
         add_width += 2;
     }
-    if ((flags & BINARY) && (flags & ASCII)) {
+    if ((_flags & ts::UString::BINARY) && (_flags & ts::UString::ASCII)) {
         add_width += 2;
     }
 
     // Computes max number of dumped bytes per line
-    size_type bytes_per_line;
-
-    if (flags & BPL) {
-        bytes_per_line = line_width;
+    if (_flags & ts::UString::BPL) {
+        _bytes_per_line = line_width;
     }
     else if (add_width >= line_width) {
-        bytes_per_line = 8;  // arbitrary, if indent is too long
+        _bytes_per_line = 8;  // arbitrary, if indent is too long
     }
     else {
-        bytes_per_line = (line_width - add_width) /
-            (((flags & HEXA) ? (hexa_width + 1) : 0) +
-             ((flags & BINARY) ? (bin_width + 1) : 0) +
-             ((flags & ASCII) ? 1 : 0));
-        if (bytes_per_line > 1) {
-            bytes_per_line = bytes_per_line & ~1; // force even value
+        _bytes_per_line = (line_width - add_width) /
+            (((_flags & ts::UString::HEXA) ? (_hexa_width + 1) : 0) +
+             ((_flags & ts::UString::BINARY) ? (_bin_width + 1) : 0) +
+             ((_flags & ts::UString::ASCII) ? 1 : 0));
+        if (_bytes_per_line > 1) {
+            _bytes_per_line = _bytes_per_line & ~1; // force even value
         }
     }
-    if (bytes_per_line == 0) {
-        bytes_per_line = 8;  // arbitrary, if ended up with none
+    if (_bytes_per_line == 0) {
+        _bytes_per_line = 8;  // arbitrary, if ended up with none
     }
 
-    // Display data
-    for (size_type line = 0; line < size; line += bytes_per_line) {
+    // Max line width. Sections which are followed by another one are padded to the full number of bytes per line.
+    const size_t max_bytes = std::min(_bytes_per_line, _size);
+    _max_line_width = add_width + 1;
+    if (_flags & ts::UString::HEXA) {
+        _max_line_width += (_hexa_width + 1) * ((_flags & (ts::UString::BINARY | ts::UString::ASCII)) ? _bytes_per_line : max_bytes);
+    }
+    if (_flags & ts::UString::BINARY) {
+        _max_line_width += (_bin_width + 1) * ((_flags & ts::UString::ASCII) ? _bytes_per_line : max_bytes);
+    }
+    if (_flags & ts::UString::ASCII) {
+        _max_line_width += max_bytes;
+    }
+}
 
-        // Number of bytes on this line (last line may be shorter)
-        size_type line_size = line + bytes_per_line <= size ? bytes_per_line : size - line;
+template <typename CHAR>
+CHAR* DumpLayout::formatSingleLine(CHAR* out, const uint8_t* data, size_t first, size_t count) const
+{
+    const bool c_style = (_flags & ts::UString::C_STYLE) != 0;
+    const bool spaces = (_flags & ts::UString::COMPACT) == 0;
 
-        // Beginning of line
-        append(indent, u' ');
-        if (flags & OFFSET) {
-            append(Hexa(init_offset + line, offset_width, UString(), false, true));
-            append(u":  ");
+    for (size_t i = first; i < first + count; ++i) {
+        if (i > 0 && spaces) {
+            *out++ = CHAR(' ');
+        }
+        if (c_style) {
+            *out++ = CHAR('0');
+            *out++ = CHAR('x');
+        }
+        *out++ = CHAR(HexaDigits[data[i] >> 4]);
+        *out++ = CHAR(HexaDigits[data[i] & 0x0F]);
+        if (c_style) {
+            *out++ = CHAR(',');
         }
-        append(inner_indent, u' ');
+    }
+    return out;
+}
 
-        // Hexa dump
-        if (flags & HEXA) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                append(byte_prefix);
-                append(Hexa(raw[line + byte], 0, UString(), false, true));
-                append(byte_suffix);
-                if (byte < bytes_per_line - 1) {
-                    append(1, u' ');
-                }
+template <typename CHAR>
+CHAR* DumpLayout::formatLine(CHAR* out, const CHAR* floor, const uint8_t* data, size_t line) const
+{
+    // Number of bytes on this line (last line may be shorter)
+    const size_t line_size = line + _bytes_per_line <= _size ? _bytes_per_line : _size - line;
+    const uint8_t* const raw = data + line;
+
+    // Beginning of line
+    out = Spaces(out, _indent);
+    if (_flags & ts::UString::OFFSET) {
+        // Exactly _offset_width digits, as ts::UString::Hexa() does.
+        size_t value = _init_offset + line;
+        for (size_t i = _offset_width; i > 0; --i) {
+            out[i - 1] = CHAR(HexaDigits[value & 0x0F]);
+            value >>= 4;
+        }
+        out += _offset_width;
+        *out++ = CHAR(':');
+        out = Spaces(out, 2);
+    }
+    out = Spaces(out, _inner_indent);
+
+    // Hexa dump
+    if (_flags & ts::UString::HEXA) {
+        const bool c_style = (_flags & ts::UString::C_STYLE) != 0;
+        for (size_t byte = 0; byte < line_size; byte++) {
+            if (c_style) {
+                *out++ = CHAR('0');
+                *out++ = CHAR('x');
             }
-            if (flags & (BINARY | ASCII)) { // more to come
-                if (line_size < bytes_per_line) {
-                    append((hexa_width + 1) * (bytes_per_line - line_size) - 1, u' ');
-                }
-                append(2, u' ');
+            *out++ = CHAR(HexaDigits[raw[byte] >> 4]);
+            *out++ = CHAR(HexaDigits[raw[byte] & 0x0F]);
+            if (c_style) {
+                *out++ = CHAR(',');
+            }
+            if (byte < _bytes_per_line - 1) {
+                *out++ = CHAR(' ');
             }
         }
+        if (_flags & (ts::UString::BINARY | ts::UString::ASCII)) { // more to come
+            if (line_size < _bytes_per_line) {
+                out = Spaces(out, (_hexa_width + 1) * (_bytes_per_line - line_size) - 1);
+            }
+            out = Spaces(out, 2);
+        }
+    }
 
-        // Binary dump
-        if (flags & BINARY) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                int b = int(raw[line + byte]);
-                for (int i = 7; i >= 0; i--) {
-                    append(1, UChar(u'0' + ((b >> i) & 0x01)));
-                    if (i == 4 && (flags & BIN_NIBBLE) != 0) {
-                        append(1, u'.');
-                    }
-                }
-                if (byte < bytes_per_line - 1) {
-                    append(1, u' ');
+    // Binary dump
+    if (_flags & ts::UString::BINARY) {
+        const bool nibble = (_flags & ts::UString::BIN_NIBBLE) != 0;
+        for (size_t byte = 0; byte < line_size; byte++) {
+            const uint8_t b = raw[byte];
+            for (int i = 7; i >= 0; i--) {
+                *out++ = CHAR('0' + ((b >> i) & 0x01));
+                if (i == 4 && nibble) {
+                    *out++ = CHAR('.');
                 }
             }
-            if (flags & ASCII) { // more to come
-                if (line_size < bytes_per_line) {
-                    append((bin_width + 1) * (bytes_per_line - line_size) - 1, u' ');
-                }
-                append(2, u' ');
+            if (byte < _bytes_per_line - 1) {
+                *out++ = CHAR(' ');
             }
         }
-
-        // ASCII dump
-        if (flags & ASCII) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                // Display only ASCII characters. Other encodings don't make sense on one bytes.
-                const UChar c = UChar(raw[line + byte]);
-                push_back(c >= 0x20 && c <= 0x7E ? c : u'.');
+        if (_flags & ts::UString::ASCII) { // more to come
+            if (line_size < _bytes_per_line) {
+                out = Spaces(out, (_bin_width + 1) * (_bytes_per_line - line_size) - 1);
             }
+            out = Spaces(out, 2);
+        }
+    }
+
+    // ASCII dump
+    if (_flags & ts::UString::ASCII) {
+        for (size_t byte = 0; byte < line_size; byte++) {
+            // Display only ASCII characters. Other encodings don't make sense on one bytes.
+            const uint8_t c = raw[byte];
+            *out++ = CHAR(c >= 0x20 && c <= 0x7E ? c : '.');
+        }
+    }
+
+    // Insert a new-line, cleanup spurious spaces.
+    while (out > floor && out[-1] == CHAR(' ')) {
+        --out;
+    }
+    *out++ = CHAR('\n');
+    return out;
+}
+
+
+//----------------------------------------------------------------------------
+// Build a multi-line string containing the hexadecimal dump of a memory area.
+//----------------------------------------------------------------------------
+
+void ts::UString::appendDump(const void *data,
+                             size_type size,
+                             uint32_t flags,
+                             size_type indent,
+                             size_type line_width,
+                             size_type init_offset,
+                             size_type inner_indent)
+{
+    // Do nothing in case of invalid or empty data.
+    if (data == nullptr || size == 0) {
+        return;
+    }
+
+    const uint8_t* raw = static_cast<const uint8_t*>(data);
+    const DumpLayout layout(size, flags, indent, line_width, init_offset, inner_indent);
+    const size_type start = length();
+
+    // Allocate the maximum size once and format directly in the string.
+    if (layout.singleLine()) {
+        resize(start + layout.singleLineByteWidth() * size);
+        UChar* const base = &(*this)[0];
+        resize(layout.formatSingleLine(base + start, raw, 0, size) - base);
+    }
+    else {
+        resize(start + layout.maxLineWidth() * layout.lineCount());
+        UChar* const base = &(*this)[0];
+        UChar* out = base + start;
+        for (size_type line = 0; line < size; line += layout.bytesPerLine()) {
+            // Trailing spaces are removed up to the beginning of the string, as in previous content.
+            out = layout.formatLine(out, base, raw, line);
         }
+        resize(out - base);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Write the hexadecimal dump of a memory area directly on a stream.
+//----------------------------------------------------------------------------
+
+std::ostream& ts::UString::Dump(std::ostream& strm,
+                                const void *data,
+                                size_type size,
+                                uint32_t flags,
+                                size_type indent,
+                                size_type line_width,
+                                size_type init_offset,
+                                size_type inner_indent)
+{
+    // Do nothing in case of invalid or empty data.
+    if (data == nullptr || size == 0) {
+        return strm;
+    }
+
+    // The dump contains ASCII characters only, it is directly formatted as UTF-8 in a large buffer.
+    const uint8_t* raw = static_cast<const uint8_t*>(data);
+    const DumpLayout layout(size, flags, indent, line_width, init_offset, inner_indent);
+    const size_t DUMP_BUFFER_SIZE = 64 * 1024;
 
-        // Insert a new-line, cleanup spurious spaces.
-        while (!empty() && back() == u' ') {
-            pop_back();
+    if (layout.singleLine()) {
+        const size_t max_bytes = DUMP_BUFFER_SIZE / layout.singleLineByteWidth();
+        std::vector<char> buffer(layout.singleLineByteWidth() * std::min(size, max_bytes));
+        for (size_type first = 0; first < size; first += max_bytes) {
+            const char* end = layout.formatSingleLine(buffer.data(), raw, first, std::min(size - first, max_bytes));
+            strm.write(buffer.data(), end - buffer.data());
+        }
+    }
+    else {
+        std::vector<char> buffer(std::min(std::max(DUMP_BUFFER_SIZE, layout.maxLineWidth()), layout.maxLineWidth() * layout.lineCount()));
+        char* const base = buffer.data();
+        char* const limit = base + buffer.size();
+        char* out = base;
+        for (size_type line = 0; line < size; line += layout.bytesPerLine()) {
+            if (out + layout.maxLineWidth() > limit) {
+                strm.write(base, out - base);
+                out = base;
+            }
+            // Trailing spaces can be removed up to the beginning of the current line only.
+            out = layout.formatLine(out, out, raw, line);
         }
-        push_back(u'\n');
+        strm.write(base, out - base);
     }
+    return strm;
 }
 
 
@@ -758,6 +758,20 @@ void ts::xml::Element::printClose(TextFormatter& output, size_t levels) const
 
 bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
 {
+    // Parse the tag, then all children and the end tag, unless this is a standalone tag.
+    bool standalone = false;
+    return parseStartTag(parser, standalone) && (standalone || (parseChildren(parser) && parseEndTag(parser)));
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the start tag of an element, after "<".
+//----------------------------------------------------------------------------
+
+bool ts::xml::Element::parseStartTag(TextParser& parser, bool& standalone)
+{
+    standalone = false;
+
     // We just read the "<". Skip spaces and read the tag name.
     parser.skipWhiteSpace();
     if (!parser.parseXMLName(_value)) {
@@ -780,6 +794,7 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
         }
         else if (parser.match(u"/>", true)) {
             // Found end of standalone tag, without children.
+            standalone = true;
             return true;
         }
         else if (parser.parseXMLName(name)) {
@@ -833,13 +848,18 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
         return false;
     }
 
-    // End of tag, swallow all children.
-    if (!parseChildren(parser)) {
-        return false;
-    }
+    return true;
+}
+
 
+//----------------------------------------------------------------------------
+// Parse the end tag of an element, after all children.
+//----------------------------------------------------------------------------
+
+bool ts::xml::Element::parseEndTag(TextParser& parser)
+{
     // We now must be at "</tag>".
-    ok = parser.match(u"</", true);
+    bool ok = parser.match(u"</", true);
     if (ok) {
         UString endTag;
         ok = parser.skipWhiteSpace() && parser.parseXMLName(endTag) && parser.skipWhiteSpace() && endTag.similar(_value);
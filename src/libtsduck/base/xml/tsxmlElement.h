@@ -732,6 +732,16 @@ namespace ts {
             CaseSensitivity _attributeCase;  //!< For attribute names.
             AttributeMap    _attributes;     //!< Map of attributes.
 
+            // The pull parser needs to parse the start and end tags separately.
+            friend class PullParser;
+
+            // Parse the start tag, after "<", including the attributes.
+            // Set standalone to true if the tag ends with "/>" (no children, no end tag).
+            bool parseStartTag(TextParser& parser, bool& standalone);
+
+            // Parse the end tag "</name>", after all children.
+            bool parseEndTag(TextParser& parser);
+
             // Compute the key in the attribute map.
             UString attributeKey(const UString& attributeName) const;
 
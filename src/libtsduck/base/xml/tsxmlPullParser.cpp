@@ -0,0 +1,223 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Incremental parser of large XML documents.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlPullParser.h"
+#include "tsxmlDeclaration.h"
+#include "tsxmlComment.h"
+#include "tsxmlUnknown.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::PullParser::PullParser(Document& doc) :
+    _doc(doc),
+    _file(),
+    _parser(doc.report()),
+    _root(nullptr),
+    _current(nullptr),
+    _success(false),
+    _end(true)
+{
+}
+
+ts::xml::PullParser::~PullParser()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Open the document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::PullParser::open(const UString& fileName)
+{
+    if (_file.is_open()) {
+        _file.close();
+    }
+    _file.clear();
+    _file.open(fileName.toUTF8().c_str());
+    if (!_file) {
+        _doc.report().error(u"error reading file %s", {fileName});
+        _doc.clear();
+        _root = _current = nullptr;
+        _success = false;
+        _end = true;
+        return false;
+    }
+    _doc.report().debug(u"loading XML file %s", {fileName});
+    return open(_file);
+}
+
+bool ts::xml::PullParser::open(std::istream& strm)
+{
+    _doc.clear();
+    _parser.loadStreamIncremental(strm);
+    return parseStart();
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the beginning of the document, up to the start tag of the root element.
+//----------------------------------------------------------------------------
+
+bool ts::xml::PullParser::parseStart()
+{
+    _root = _current = nullptr;
+    _success = true;
+    _end = false;
+
+    // Load all leading declarations and comments (and unknown DTD), then the root element.
+    Node* node = nullptr;
+    while (_root == nullptr && _success && (node = _doc.identifyNextNode(_parser)) != nullptr) {
+        Element* elem = dynamic_cast<Element*>(node);
+        if (elem != nullptr) {
+            // Parse the start tag only, the children are parsed one by one later.
+            bool standalone = false;
+            if (elem->parseStartTag(_parser, standalone)) {
+                elem->reparent(&_doc);
+                _root = elem;
+                _end = standalone;
+            }
+            else {
+                delete elem;
+                _success = false;
+            }
+        }
+        else if (dynamic_cast<Declaration*>(node) == nullptr && dynamic_cast<Comment*>(node) == nullptr && dynamic_cast<Unknown*>(node) == nullptr) {
+            // Text before the root element.
+            delete node;
+            break;
+        }
+        else if (node->parseNode(_parser, &_doc)) {
+            node->reparent(&_doc);
+        }
+        else {
+            delete node;
+            _success = false;
+        }
+    }
+
+    if (_success && _root == nullptr) {
+        _doc.report().error(u"invalid XML document, no root element found");
+        _success = false;
+    }
+    if (!_success) {
+        _end = true;
+    }
+    else if (_end) {
+        // Empty root element.
+        parseEnd();
+    }
+    return _success;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the next child element of the root element.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::PullParser::nextElement()
+{
+    // Delete previous element.
+    if (_current != nullptr) {
+        delete _current;
+        _current = nullptr;
+    }
+    if (_end) {
+        return nullptr;
+    }
+
+    // Parse children of the root, as Node::parseChildren() does, but one at a time.
+    Node* node = nullptr;
+    while ((node = _root->identifyNextNode(_parser)) != nullptr) {
+        if (!node->parseNode(_parser, _root)) {
+            // Error, we expect the child's parser to have displayed the error message.
+            // Like the DOM parser, stop on first error.
+            delete node;
+            _success = false;
+            _end = true;
+            return nullptr;
+        }
+        else if ((_current = dynamic_cast<Element*>(node)) != nullptr) {
+            // Got a complete element, the previous lines of text are no longer needed.
+            _current->reparent(_root);
+            _parser.discardPreviousLines();
+            return _current;
+        }
+        else {
+            // Ignore comments and texts between elements.
+            delete node;
+        }
+    }
+
+    // End of the root element, we now must be at "</root>".
+    _end = true;
+    if (_root->parseEndTag(_parser)) {
+        parseEnd();
+    }
+    else {
+        _success = false;
+    }
+    return nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Check the end of the document, after the root element.
+//----------------------------------------------------------------------------
+
+void ts::xml::PullParser::parseEnd()
+{
+    // Skip all subsequent comments.
+    Node* node = nullptr;
+    while ((node = _doc.identifyNextNode(_parser)) != nullptr) {
+        const bool ok = dynamic_cast<Comment*>(node) != nullptr && node->parseNode(_parser, &_doc);
+        if (!ok) {
+            _doc.report().error(u"line %d: trailing %s, invalid XML document, need one single root element", {node->lineNumber(), node->typeName()});
+            _success = false;
+        }
+        delete node;
+        if (!ok) {
+            return;
+        }
+    }
+
+    // We must have reached the end of document.
+    if (!_parser.eof()) {
+        _doc.report().error(u"line %d: trailing character sequence, invalid XML document", {_parser.lineNumber()});
+        _success = false;
+    }
+}
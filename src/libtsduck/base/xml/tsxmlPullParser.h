@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Incremental parser of large XML documents.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlDocument.h"
+#include "tsxmlElement.h"
+#include "tsTextParser.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Incremental parser of large XML documents.
+        //! @ingroup xml
+        //!
+        //! Some XML documents are very large lists of elements under the root element,
+        //! for instance a list of tables in a TSDuck XML file. Loading such documents
+        //! completely in memory can be very slow and use gigabytes of memory.
+        //!
+        //! A pull parser loads the document one child of the root element at a time.
+        //! The leading declarations and the root element are loaded into an xml::Document.
+        //! Each call to nextElement() parses the next child of the root element and inserts
+        //! it as the only child of the root element, after deleting the previous one. The
+        //! input file is read only when necessary. The memory usage is bounded by the size
+        //! of the largest child element.
+        //!
+        class TSDUCKDLL PullParser
+        {
+            TS_NOBUILD_NOCOPY(PullParser);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] doc The document into which the declarations and the root
+            //! element are loaded. Errors are reported on the report of this document.
+            //!
+            explicit PullParser(Document& doc);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~PullParser();
+
+            //!
+            //! Open an XML file and parse it up to the start tag of the root element.
+            //! @param [in] fileName Name of the XML file to load.
+            //! @return True on success, false on error.
+            //!
+            bool open(const UString& fileName);
+
+            //!
+            //! Open an XML document from a text stream and parse it up to the start tag of the root element.
+            //! @param [in,out] strm A standard text stream in input mode. The lifetime of
+            //! the stream must equals or exceeds the lifetime of the parser.
+            //! @return True on success, false on error.
+            //!
+            bool open(std::istream& strm);
+
+            //!
+            //! Parse the next child element of the root element.
+            //! The previously returned element, if any, is deleted first.
+            //! @return The address of the next child element of the root element, or zero
+            //! at the end of the root element or on error. When the returned value is zero,
+            //! use success() to check if the complete document was successfully parsed.
+            //!
+            Element* nextElement();
+
+            //!
+            //! Check if the document was successfully parsed so far.
+            //! @return True if no error was found so far.
+            //!
+            bool success() const { return _success; }
+
+        private:
+            Document&     _doc;      // Target document.
+            std::ifstream _file;     // Input file, when open() with a file name.
+            TextParser    _parser;   // Incremental text parser.
+            Element*      _root;     // Root element in _doc.
+            Element*      _current;  // Last returned element, child of _root.
+            bool          _success;  // No error so far.
+            bool          _end;      // End of root element reached.
+
+            // Parse the beginning of the document, up to the start tag of the root element.
+            bool parseStart();
+
+            // Check the end of the document, after the root element.
+            void parseEnd();
+        };
+    }
+}
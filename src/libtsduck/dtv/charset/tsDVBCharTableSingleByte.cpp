@@ -57,6 +57,9 @@ const ts::DVBCharset ts::DVBCharTableSingleByte::DVB_ISO_8859_15(u"ISO-8859-15",
 ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t tableCode, std::initializer_list<uint16_t> init, std::initializer_list<uint8_t> revDiac) :
     DVBCharTable(name, tableCode),
     _upperCodePoints(init),
+    _codePoints(),
+    _diacritical(),
+    _precombined(),
     _bytesMap(),
     _reversedDiacritical()
 {
@@ -69,15 +72,19 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
     // Code point to byte mapping for ASCII range
     for (size_t i = 0x20; i <= 0x7E; i++) {
         _bytesMap.insert(std::make_pair(UChar(i), uint8_t(i)));
+        _codePoints[i] = uint16_t(i);
     }
 
     // Control codes
     _bytesMap.insert(std::make_pair(LINE_FEED, DVB_SINGLE_BYTE_CRLF));
+    _codePoints[DVB_SINGLE_BYTE_CRLF] = LINE_FEED;
 
     // Code point to byte mapping for 0xA0-0xFF range
     for (size_t i = 0; i < _upperCodePoints.size(); i++) {
         if (_upperCodePoints[i] != 0) {
             _bytesMap.insert(std::make_pair(UChar(_upperCodePoints[i]), uint8_t(0xA0 + i)));
+            _codePoints[0xA0 + i] = _upperCodePoints[i];
+            _diacritical.set(0xA0 + i, IsCombiningDiacritical(UChar(_upperCodePoints[i])));
         }
     }
 
@@ -87,6 +94,20 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
             _reversedDiacritical.set(*it - 0xA0);
         }
     }
+
+    // Precombined characters for all reversed diacritical marks, followed by a letter.
+    if (_reversedDiacritical.any()) {
+        _precombined.resize(256 * _upperCodePoints.size(), 0);
+        for (size_t mark = 0; mark < _upperCodePoints.size(); ++mark) {
+            if (_reversedDiacritical.test(mark)) {
+                for (size_t letter = 0; letter < 256; ++letter) {
+                    if (_codePoints[letter] != 0 && (letter < 0xA0 || !_reversedDiacritical.test(letter - 0xA0))) {
+                        _precombined[256 * mark + letter] = Precombined(UChar(_codePoints[letter]), UChar(_upperCodePoints[mark]));
+                    }
+                }
+            }
+        }
+    }
 }
 
 
@@ -97,45 +118,65 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
 bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
     str.clear();
-    str.reserve(dvbSize);
+    if (dvb == nullptr || dvbSize == 0) {
+        return true;
+    }
+
+    // There is at most one character per byte. Decode directly in the string buffer.
+    str.resize(dvbSize);
+    UChar* const base = &str[0];
+    UChar* out = base;
+    const uint8_t* const end = dvb + dvbSize;
     bool status = true;
     bool reverseNext = false;  // after decoding next character, it shall be swapped with previous one.
     bool hasDiacritical = false;
 
-    for (; dvb != nullptr && dvbSize > 0; --dvbSize) {
-        // Get next byte
-        const uint8_t b = *dvb++;
-        // Convert it to a code point
-        uint16_t cp = 0;
-        if (b >= 0x20 && b <= 0x7E) {
-            cp = b; // ASCII range = identity
-        }
-        else if (b >= 0xA0) {
-            cp = _upperCodePoints[b - 0xA0];
+    while (dvb < end) {
+        // Fast path for sequences of ASCII characters (identity), the most common case.
+        if (!reverseNext) {
+            while (dvb < end && *dvb >= 0x20 && *dvb <= 0x7E) {
+                *out++ = UChar(*dvb++);
+            }
+            if (dvb >= end) {
+                break;
+            }
         }
-        else if (b == DVB_SINGLE_BYTE_CRLF) {
-            cp = LINE_FEED;
+        // Get next byte.
+        const uint8_t b = *dvb++;
+        // Fast path for a reversed diacritical mark and a letter which combine into one character.
+        if (!reverseNext && b >= 0xA0 && dvb < end && !_precombined.empty()) {
+            const UChar pc = _precombined[256 * (b - 0xA0) + *dvb];
+            if (pc != CHAR_NULL) {
+                *out++ = pc;
+                dvb++;
+                continue;
+            }
         }
+        // Convert the byte to a code point.
+        const UChar cp = _codePoints[b];
         // Add in result if no error.
         if (cp == 0) {
             // Untranslatable character.
             status = false;
         }
-        else if (reverseNext && !str.empty()) {
+        else if (reverseNext && out > base) {
             // Insert decoded character before the previous one.
             // This is typically a letter coming after a reversable diacritical mark.
             // In Unicode, the letter must preceed the diacritical mark.
-            str.insert(str.length() - 1, 1, UChar(cp));
+            out[0] = out[-1];
+            out[-1] = cp;
+            out++;
         }
         else {
             // Simply add the decoded character.
-            str.push_back(UChar(cp));
+            *out++ = cp;
         }
         // Try the presence of diacritical, reversable or not.
-        hasDiacritical = hasDiacritical || IsCombiningDiacritical(UChar(cp));
+        hasDiacritical = hasDiacritical || _diacritical.test(b);
         // Shall we perform mark/letter swap next time?
         reverseNext = b >= 0xA0 && _reversedDiacritical.test(b - 0xA0);
     }
+    str.resize(out - base);
 
     // If some diacritical mark was found, try to combine them.
     if (hasDiacritical) {
@@ -108,6 +108,17 @@ namespace ts {
         // List of code points for byte values 0xA0-0xFF. Always contain 96 values.
         const std::vector<uint16_t> _upperCodePoints;
 
+        // Direct translation table for all byte values, built from _upperCodePoints. Zero means unused.
+        uint16_t _codePoints[256];
+
+        // Bitmap of byte values which are translated into combining diacritical marks.
+        std::bitset<256> _diacritical;
+
+        // Precombined characters for a reversed diacritical mark, followed by any byte.
+        // There are 256 entries per byte value 0xA0-0xFF. Zero means no precombined character.
+        // Empty when the character set has no reversed diacritical mark.
+        std::vector<uint16_t> _precombined;
+
         // Reverse mapping for complete character set (key = code point, value = byte rep).
         std::map<UChar, uint8_t> _bytesMap;
 
@@ -111,6 +111,17 @@ void ts::AbstractLongTable::addOneSectionImpl(BinaryTable& table, PSIBuffer& pay
     if (table.sectionCount() < 256) {
         // Add one section.
         const uint8_t section_number = uint8_t(table.sectionCount());
+
+        // Update the last_section_number of all previous sections without recomputing their CRC32.
+        // Otherwise, the CRC32 of all previous sections would be recomputed each time a section is
+        // added. The CRC32 of all sections are recomputed once at the end of the serialization.
+        for (size_t si = 0; si < table.sectionCount(); ++si) {
+            const SectionPtr sec(table.sectionAt(si));
+            if (!sec.isNull()) {
+                sec->setLastSectionNumber(section_number, false);
+            }
+        }
+
         const SectionPtr section(new Section(tableId(),
                                              isPrivate(),
                                              tableIdExtension(),
@@ -179,6 +179,16 @@ void ts::AbstractTable::serialize(DuckContext& duck, BinaryTable& table) const
         }
     }
 
+    // When sections are added, the previous ones are updated without recomputing their CRC32
+    // (see AbstractLongTable::addOneSectionImpl()). Recompute them now, once per section.
+    // The last section was not modified after its creation, its CRC32 is already correct.
+    for (size_t si = 0; si + 1 < table.sectionCount(); ++si) {
+        const SectionPtr sec(table.sectionAt(si));
+        if (!sec.isNull()) {
+            sec->recomputeCRC();
+        }
+    }
+
     // Add the standards of the serialized table into the context.
     duck.addStandards(definingStandards());
 }
@@ -412,9 +412,9 @@ bool ts::BinaryTable::addSection(const SectionPtr& sect, bool replace, bool grow
             _missing_count += int(sect->lastSectionNumber()) + 1 - int(_sections.size());
             _sections.resize(size_t(sect->lastSectionNumber()) + 1);
             assert(index < int(_sections.size()));
-            // Modify all previously entered sections
+            // Modify all previously entered sections (unless already done by the caller)
             for (int si = 0; si < int(_sections.size()); ++si) {
-                if (!_sections[si].isNull()) {
+                if (!_sections[si].isNull() && _sections[si]->lastSectionNumber() != sect->lastSectionNumber()) {
                     _sections[si]->setLastSectionNumber(sect->lastSectionNumber());
                 }
             }
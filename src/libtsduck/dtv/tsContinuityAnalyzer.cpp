@@ -36,28 +36,43 @@ TSDUCK_SOURCE;
 // Constructors and destructors
 //----------------------------------------------------------------------------
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr uint16_t ts::ContinuityAnalyzer::NO_INDEX;
+#endif
+
 ts::ContinuityAnalyzer::ContinuityAnalyzer(const PIDSet& pid_filter, Report* report) :
     _report(report != nullptr ? report : NullReport::Instance()),
     _severity(Severity::Info),
     _display_errors(false),
     _fix_errors(false),
     _generator(false),
+    _detect_dup(true),
     _prefix(),
     _total_packets(0),
     _processed_packets(0),
     _fix_count(0),
     _error_count(0),
     _pid_filter(pid_filter),
-    _pid_states()
+    _pid_states(PID_MAX),
+    _last_packets()
 {
 }
 
 ts::ContinuityAnalyzer::PIDState::PIDState() :
     first_cc(INVALID_CC),
+    last_cc_in(INVALID_CC),
     last_cc_out(INVALID_CC),
-    dup_count(0),
-    last_pkt_in()
+    has_pkt(0),
+    pkt_index(NO_INDEX),
+    dup_count(0)
+{
+}
+
+void ts::ContinuityAnalyzer::PIDState::clear()
 {
+    first_cc = last_cc_in = last_cc_out = INVALID_CC;
+    has_pkt = 0;
+    dup_count = 0;
 }
 
 
@@ -81,7 +96,26 @@ void ts::ContinuityAnalyzer::reset()
     _processed_packets = 0;
     _fix_count = 0;
     _error_count = 0;
-    _pid_states.clear();
+    std::fill(_pid_states.begin(), _pid_states.end(), PIDState());
+    _last_packets.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Set duplicate packets detection.
+//----------------------------------------------------------------------------
+
+void ts::ContinuityAnalyzer::setDuplicateDetection(bool on)
+{
+    if (on != _detect_dup) {
+        _detect_dup = on;
+        // Forget all last packets.
+        for (auto it = _pid_states.begin(); it != _pid_states.end(); ++it) {
+            it->has_pkt = 0;
+            it->pkt_index = NO_INDEX;
+        }
+        _last_packets.clear();
+    }
 }
 
 
@@ -89,6 +123,13 @@ void ts::ContinuityAnalyzer::reset()
 // PID filter management.
 //----------------------------------------------------------------------------
 
+void ts::ContinuityAnalyzer::clearPID(PID pid)
+{
+    if (pid < _pid_states.size()) {
+        _pid_states[pid].clear();
+    }
+}
+
 void ts::ContinuityAnalyzer::setPIDFilter(const PIDSet& pids)
 {
     // Get list of removed PID's
@@ -101,7 +142,7 @@ void ts::ContinuityAnalyzer::setPIDFilter(const PIDSet& pids)
     if (removed_pids.any()) {
         for (PID pid = 0; pid < PID_MAX; ++pid) {
             if (removed_pids[pid]) {
-                _pid_states.erase(pid);
+                clearPID(pid);
             }
         }
     }
@@ -123,7 +164,7 @@ void ts::ContinuityAnalyzer::removePID(PID pid)
 {
     if (pid < _pid_filter.size() && _pid_filter[pid]) {
         _pid_filter.reset(pid);
-        _pid_states.erase(pid);
+        clearPID(pid);
     }
 }
 
@@ -139,26 +180,27 @@ bool ts::ContinuityAnalyzer::hasPID(PID pid) const
 
 uint8_t ts::ContinuityAnalyzer::firstCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.first_cc;
+    return pid < _pid_states.size() ? _pid_states[pid].first_cc : INVALID_CC;
 }
 
 uint8_t ts::ContinuityAnalyzer::lastCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.last_cc_out;
+    return pid < _pid_states.size() ? _pid_states[pid].last_cc_out : INVALID_CC;
 }
 
 size_t ts::ContinuityAnalyzer::dupCount(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? NPOS : it->second.dup_count;
+    return pid < _pid_states.size() && _pid_states[pid].first_cc != INVALID_CC ? _pid_states[pid].dup_count : NPOS;
 }
 
 void ts::ContinuityAnalyzer::getLastPacket(PID pid, TSPacket& packet) const
 {
-    auto it = _pid_states.find(pid);
-    packet = it == _pid_states.end() ? NullPacket : it->second.last_pkt_in;
+    if (pid < _pid_states.size() && _pid_states[pid].has_pkt != 0) {
+        packet = _last_packets[_pid_states[pid].pkt_index];
+    }
+    else {
+        packet = NullPacket;
+    }
 }
     
 ts::TSPacket ts::ContinuityAnalyzer::lastPacket(PID pid) const
@@ -193,6 +235,15 @@ ts::UString ts::ContinuityAnalyzer::linePrefix(PID pid) const
 // Detect / fix error on packet.
 //----------------------------------------------------------------------------
 
+bool ts::ContinuityAnalyzer::feedPacketsInternal(TSPacket* pkt, size_t count, bool update)
+{
+    bool result = true;
+    for (size_t i = 0; i < count; ++i) {
+        result = feedPacketInternal(pkt + i, update) && result;
+    }
+    return result;
+}
+
 bool ts::ContinuityAnalyzer::feedPacketInternal(TSPacket* pkt, bool update)
 {
     assert(pkt != nullptr);
@@ -202,19 +253,36 @@ bool ts::ContinuityAnalyzer::feedPacketInternal(TSPacket* pkt, bool update)
     // The null PID is never eligible for CC processing.
     if (pid != PID_NULL && _pid_filter.test(pid)) {
 
-        // Get or create PID context.
+        // Get PID context.
         PIDState& state(_pid_states[pid]);
         const bool new_pid = state.first_cc == INVALID_CC;
 
         // Remember initial characteristics of the input packet.
-        const uint8_t last_cc_in = new_pid ? INVALID_CC : state.last_pkt_in.getCC();
+        const uint8_t last_cc_in = state.last_cc_in;
         const uint8_t cc = pkt->getCC();
         const bool has_payload = pkt->hasPayload();
         const bool has_discontinuity = pkt->getDiscontinuityIndicator();
-        const bool duplicated = !new_pid && !has_discontinuity && pkt->isDuplicate(state.last_pkt_in);
 
-        // Save input packet as originally received.
-        state.last_pkt_in = *pkt;
+        // A duplicate packet has the same CC as the previous one and a payload.
+        // The content of the packet is checked only if duplicate detection is on.
+        // In generator mode, the input CC are ignored and there is no need to keep the last packet.
+        bool duplicated = false;
+        if (!_generator && _detect_dup) {
+            duplicated = !new_pid && !has_discontinuity && cc == last_cc_in && state.has_pkt != 0 && pkt->isDuplicate(_last_packets[state.pkt_index]);
+            // Save input packet as originally received.
+            if (state.pkt_index == NO_INDEX) {
+                state.pkt_index = uint16_t(_last_packets.size());
+                _last_packets.push_back(*pkt);
+            }
+            else {
+                _last_packets[state.pkt_index] = *pkt;
+            }
+            state.has_pkt = 1;
+        }
+        else {
+            duplicated = !new_pid && !has_discontinuity && has_payload && cc == last_cc_in;
+        }
+        state.last_cc_in = cc;
 
         if (new_pid) {
             // First packet on this PID
@@ -235,7 +303,10 @@ bool ts::ContinuityAnalyzer::feedPacketInternal(TSPacket* pkt, bool update)
         }
         else if (duplicated) {
             // Duplicate packet.
-            if (++state.dup_count >= 2) {
+            if (state.dup_count < 0xFFFF) {
+                state.dup_count++;
+            }
+            if (state.dup_count >= 2) {
                 // The standard allows at most 2 duplicate packets.
                 if (_display_errors) {
                     _report->log(_severity, u"%s, %d duplicate packets", {linePrefix(pid), state.dup_count + 1});
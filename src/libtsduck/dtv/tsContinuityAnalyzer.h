@@ -94,6 +94,25 @@ namespace ts {
         //!
         bool feedPacket(TSPacket& pkt) { return feedPacketInternal(&pkt, true); }
 
+        //!
+        //! Process a contiguous array of constant TS packets.
+        //! Can be used only to report discontinuity errors.
+        //! @param [in] pkt Address of the first transport stream packet.
+        //! @param [in] count Number of packets.
+        //! @return True if no packet has a discontinuity error. False if at least one packet has an error.
+        //!
+        bool feedPackets(const TSPacket* pkt, size_t count) { return feedPacketsInternal(const_cast<TSPacket*>(pkt), count, false); }
+
+        //!
+        //! Process or modify a contiguous array of TS packets.
+        //! @param [in,out] pkt Address of the first transport stream packet.
+        //! The packets can be modified only when error fixing or generator mode is activated.
+        //! @param [in] count Number of packets.
+        //! @return True if no packet had a discontinuity error and all packets are unmodified.
+        //! False if at least one packet had an error or was modified.
+        //!
+        bool feedPackets(TSPacket* pkt, size_t count) { return feedPacketsInternal(pkt, count, true); }
+
         //!
         //! Get the total number of TS packets.
         //! @return The total number of TS packets.
@@ -146,6 +165,20 @@ namespace ts {
         //!
         void setGenerator(bool gen) { _generator = gen; }
 
+        //!
+        //! Set duplicate packets detection.
+        //! A duplicate packet has the same continuity counter as the previous packet in
+        //! the same PID and, except the PCR, the same content. When duplicate detection
+        //! is on (the default), a copy of the last packet is kept for each PID and duplicate
+        //! packets are compared with it. When duplicate detection is off, the last packets
+        //! are not kept and any packet with a payload and the same continuity counter as
+        //! the previous packet is considered as a duplicate packet. Switching duplicate
+        //! detection on or off forgets the last packets in all PID's.
+        //! Duplicate detection is useless and automatically skipped in generator mode.
+        //! @param [in] on When true, fully detect duplicate packets.
+        //!
+        void setDuplicateDetection(bool on);
+
         //!
         //! Define the severity of messages.
         //! The default severity is Severity::Info.
@@ -222,14 +255,18 @@ namespace ts {
         //!
         //! Get the last transport stream packet that was passed to feedPacket() for a PID.
         //! @param [in] pid The PID to check.
-        //! @return The last packet for the PID or ts::NullPacket when the PID is not filtered.
+        //! @return The last packet for the PID or ts::NullPacket when the PID is not filtered
+        //! or when duplicate detection is off or in generator mode.
+        //! @see setDuplicateDetection()
         //!
         TSPacket lastPacket(PID pid) const;
 
         //!
         //! Get the last transport stream packet that was passed to feedPacket() for a PID.
         //! @param [in] pid The PID to check.
-        //! @param [out] packet The last packet for the PID or ts::NullPacket when the PID is not filtered.
+        //! @param [out] packet The last packet for the PID or ts::NullPacket when the PID is not filtered
+        //! or when duplicate detection is off or in generator mode.
+        //! @see setDuplicateDetection()
         //!
         void getLastPacket(PID pid, TSPacket& packet) const;
 
@@ -242,19 +279,22 @@ namespace ts {
         static int MissingPackets(int cc1, int cc2);
 
     private:
-        // PID analysis state
+        // PID analysis state. Keep it small, the state of all PID's is directly indexed by PID.
         class PIDState
         {
         public:
             PIDState();            // Constructor
-            uint8_t  first_cc;     // First CC value in a PID.
+            void clear();          // Reset the state, keep the last packet slot.
+            uint8_t  first_cc;     // First CC value in a PID, INVALID_CC when no packet was received.
+            uint8_t  last_cc_in;   // Last input CC value in a PID.
             uint8_t  last_cc_out;  // Last output CC value in a PID.
-            size_t   dup_count;    // Consecutive duplicate count.
-            TSPacket last_pkt_in;  // Last input packet (before modification, if any).
+            uint8_t  has_pkt;      // Non-zero when the last input packet is in _last_packets.
+            uint16_t pkt_index;    // Index of last input packet in _last_packets, NO_INDEX if none.
+            uint16_t dup_count;    // Consecutive duplicate count (saturated).
         };
 
-        // A map of PID state, indexed by PID.
-        typedef std::map<PID,PIDState> PIDStateMap;
+        // Index of last packet for PID's without slot in _last_packets.
+        static constexpr uint16_t NO_INDEX = 0xFFFF;
 
         // Private members.
         Report*       _report;            // Where to report errors, never null.
@@ -262,17 +302,23 @@ namespace ts {
         bool          _display_errors;    // Display discontinuity errors.
         bool          _fix_errors;        // Fix discontinuity errors.
         bool          _generator;         // Use generator mode.
+        bool          _detect_dup;        // Detect duplicate packets using the last packet content.
         UString       _prefix;            // Message prefix.
         PacketCounter _total_packets;     // Total number of packets.
         PacketCounter _processed_packets; // Number of processed packets.
         PacketCounter _fix_count;         // Number of fixed (modified) packets.
         PacketCounter _error_count;       // Number of discontinuity errors.
         PIDSet        _pid_filter;        // Current set of filtered PID's.
-        PIDStateMap   _pid_states;        // State of all PID's.
+        std::vector<PIDState> _pid_states;   // State of all PID's, indexed by PID.
+        std::vector<TSPacket> _last_packets; // Last input packets (before modification, if any), only when detecting duplicates.
 
         // Internal version of feedPacket.
         // The packet is modified only is update is true.
         bool feedPacketInternal(TSPacket* pkt, bool update);
+        bool feedPacketsInternal(TSPacket* pkt, size_t count, bool update);
+
+        // Reset the state of one PID.
+        void clearPID(PID pid);
 
         // Build the first part of an error message.
         UString linePrefix(PID pid) const;
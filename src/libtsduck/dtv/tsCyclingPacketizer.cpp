@@ -48,9 +48,11 @@ ts::CyclingPacketizer::CyclingPacketizer(const DuckContext& duck, PID pid, Stuff
     _sched_sections(),
     _other_sections(),
     _sched_packets(0),
+    _sched_order(0),
     _current_cycle(1),
     _remain_in_cycle(0),
-    _cycle_end(UNDEFINED)
+    _cycle_end(UNDEFINED),
+    _last_provided()
 {
 }
 
@@ -63,7 +65,9 @@ ts::CyclingPacketizer::SectionDesc::SectionDesc(const SectionPtr& sec, MilliSeco
     repetition(rep),
     last_packet(0),
     due_packet(0),
-    last_cycle(0)
+    last_cycle(0),
+    sched_order(0),
+    packets()
 {
 }
 
@@ -105,47 +109,29 @@ void ts::CyclingPacketizer::addTable(DuckContext& duck, const AbstractTable& tab
 
 
 //----------------------------------------------------------------------------
-// Check if this section shall be inserted after some other one.
+// Ordering of the heap of scheduled sections: true if s1 shall be sent after s2.
 //----------------------------------------------------------------------------
 
-bool ts::CyclingPacketizer::SectionDesc::insertAfter(const SectionDesc& other) const
+bool ts::CyclingPacketizer::SendAfter(const SectionDescPtr& s1, const SectionDescPtr& s2)
 {
-    // Insert sections according due time when due times are different.
-    if (due_packet != other.due_packet) {
-        return due_packet > other.due_packet;
+    // Sections are sent according to their due time. With identical due times, a section
+    // which was already sent in the current cycle is sent after others. Then, sections are
+    // sent in scheduling order. Since all sections of a table are initially scheduled in
+    // order of section number, this order is preserved at each repetition.
+    if (s1->due_packet != s2->due_packet) {
+        return s1->due_packet > s2->due_packet;
     }
-
-    // At this point, the two sections have the same due time.
-    // Decide insertion order based on the sections contents.
-    const Section& sec1(*section);
-    const Section& sec2(*(other.section));
-
-    if (sec1.tableId() != sec2.tableId() || (sec1.isLongSection() && sec1.tableIdExtension() != sec2.tableIdExtension())) {
-        // Sections do not belong to the same table => insert before
-        return false;
-    }
-    else if (last_cycle > other.last_cycle) {
-        // This section in one cycle in advance => insert after
-        return true;
-    }
-    else if (last_cycle < other.last_cycle) {
-        // This section in one cycle late => insert before
-        return false;
-    }
-    else if (sec1.isShortSection() || sec2.isShortSection() || sec1.tableIdExtension() != sec2.tableIdExtension()) {
-        // Both sections have the same due packet and in the same cycle. They also have the same table id.
-        // Either they are short equivalent sections or do not have the same table id ext => insert after.
-        return true;
+    else if (s1->last_cycle != s2->last_cycle) {
+        return s1->last_cycle > s2->last_cycle;
     }
     else {
-        // Same due packet, same cycle, same long table => insert in order of section number.
-        return sec1.sectionNumber() >= sec2.sectionNumber();
+        return s1->sched_order > s2->sched_order;
     }
 }
 
 
 //----------------------------------------------------------------------------
-// Insert a scheduled section in the list, sorted by due_packet.
+// Insert a scheduled section in the heap, sorted by due_packet.
 //----------------------------------------------------------------------------
 
 void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
@@ -155,11 +141,9 @@ void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
                   sect->section->sectionNumber(), sect->section->lastSectionNumber(),
                   sect->last_cycle, sect->last_packet, sect->due_packet});
 
-    auto it = _sched_sections.begin();
-    while (it != _sched_sections.end() && sect->insertAfter(**it)) {
-        ++it;
-    }
-    _sched_sections.insert(it, sect);
+    sect->sched_order = _sched_order++;
+    _sched_sections.push_back(sect);
+    std::push_heap(_sched_sections.begin(), _sched_sections.end(), SendAfter);
 }
 
 
@@ -195,8 +179,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 
 void ts::CyclingPacketizer::removeSections(TID tid)
 {
-    removeSections(_sched_sections, tid, 0, false, true);
-    removeSections(_other_sections, tid, 0, false, false);
+    removeSections(tid, 0, false);
 }
 
 
@@ -206,38 +189,57 @@ void ts::CyclingPacketizer::removeSections(TID tid)
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 {
-    removeSections(_sched_sections, tid, tid_ext, true, true);
-    removeSections(_other_sections, tid, tid_ext, true, false);
+    removeSections(tid, tid_ext, true);
 }
 
 
 //----------------------------------------------------------------------------
-// Remove all sections with the specified tid/tid_ext in the specified list.
+// Remove all sections with the specified tid/tid_ext in the specified lists.
 //----------------------------------------------------------------------------
 
-void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, bool use_tid_ext, bool scheduled)
+void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, bool use_tid_ext)
 {
-    SectionDescList::iterator it(list.begin());
-    while (it != list.end()) {
-        const SectionDescPtr& sp(*it);
-        const Section& sect(*sp->section);
-        if (sect.tableId() == tid && (!use_tid_ext || sect.tableIdExtension() == tid_ext)) {
-            // Section match, remove it
-            assert(_section_count > 0);
-            _section_count--;
-            if (sp->last_cycle != _current_cycle) {
-                assert(_remain_in_cycle > 0);
-                _remain_in_cycle--;
-            }
-            if (scheduled) {
-                assert(_sched_packets >= sect.packetCount());
-                _sched_packets -= sect.packetCount();
-            }
-            it = list.erase(it);
+    // Remove scheduled sections, then rebuild the heap if some sections were removed.
+    const size_t sched_count = _sched_sections.size();
+    _sched_sections.erase(std::remove_if(_sched_sections.begin(), _sched_sections.end(),
+                                         [this, tid, tid_ext, use_tid_ext](const SectionDescPtr& sp) {
+                                             return removeSection(sp, tid, tid_ext, use_tid_ext, true);
+                                         }),
+                          _sched_sections.end());
+    if (_sched_sections.size() != sched_count) {
+        std::make_heap(_sched_sections.begin(), _sched_sections.end(), SendAfter);
+    }
+
+    // Remove unscheduled sections.
+    _other_sections.remove_if([this, tid, tid_ext, use_tid_ext](const SectionDescPtr& sp) {
+        return removeSection(sp, tid, tid_ext, use_tid_ext, false);
+    });
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a section matches tid/tid_ext. If true, update the counters
+// before the removal of the section and return true.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::removeSection(const SectionDescPtr& sp, TID tid, uint16_t tid_ext, bool use_tid_ext, bool scheduled)
+{
+    const Section& sect(*sp->section);
+    if (sect.tableId() != tid || (use_tid_ext && sect.tableIdExtension() != tid_ext)) {
+        return false;
+    }
+    else {
+        assert(_section_count > 0);
+        _section_count--;
+        if (sp->last_cycle != _current_cycle) {
+            assert(_remain_in_cycle > 0);
+            _remain_in_cycle--;
         }
-        else {
-            ++it;
+        if (scheduled) {
+            assert(_sched_packets >= sect.packetCount());
+            _sched_packets -= sect.packetCount();
         }
+        return true;
     }
 }
 
@@ -253,6 +255,7 @@ void ts::CyclingPacketizer::removeAll()
     _sched_packets = 0;
     _sched_sections.clear();
     _other_sections.clear();
+    _last_provided.clear();
 }
 
 
@@ -283,10 +286,8 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
     else if (new_bitrate == 0) {
         // Bitrate now unknown, unable to schedule sections, move them all
         // into the list of unscheduled sections.
-        while (!_sched_sections.empty()) {
-            _other_sections.push_back(_sched_sections.front());
-            _sched_sections.pop_front();
-        }
+        _other_sections.insert(_other_sections.end(), _sched_sections.begin(), _sched_sections.end());
+        _sched_sections.clear();
         _sched_packets = 0;
     }
     else if (_bitrate == 0) {
@@ -313,15 +314,11 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
     }
     else {
         // Old and new bitrate not null. Compute new due packet for all
-        // scheduled sections and re-sort list according to new due packet.
-        SectionDescList tmp_list;
-        tmp_list.swap(_sched_sections);
-        while (!tmp_list.empty()) {
-            SectionDesc* sp(tmp_list.back().pointer());
-            sp->due_packet = sp->last_packet + PacketDistance(new_bitrate, sp->repetition);
-            addScheduledSection(tmp_list.back());
-            tmp_list.pop_back();
+        // scheduled sections and rebuild the heap according to new due packet.
+        for (auto it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+            (*it)->due_packet = (*it)->last_packet + PacketDistance(new_bitrate, (*it)->repetition);
         }
+        std::make_heap(_sched_sections.begin(), _sched_sections.end(), SendAfter);
     }
 
     // Remember new bitrate
@@ -360,8 +357,9 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
 
     if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front()->due_packet <= current_packet) {
         // One scheduled section is ready
-        sp = _sched_sections.front();
-        _sched_sections.pop_front();
+        std::pop_heap(_sched_sections.begin(), _sched_sections.end(), SendAfter);
+        sp = _sched_sections.back();
+        _sched_sections.pop_back();
         // Reschedule the section. Make sure we add at least one packet to
         // ensure that all scheduled sections may pass.
         sp->due_packet = current_packet + std::max(PacketCounter(1), PacketDistance(_bitrate, sp->repetition));
@@ -375,6 +373,8 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
         _other_sections.push_back(sp);
     }
 
+    _last_provided = sp;
+
     if (sp.isNull()) {
         // No section to provide
         sect.clear();
@@ -400,6 +400,25 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
 }
 
 
+//----------------------------------------------------------------------------
+// Get the pre-packetized form of a section which is packetized alone.
+// Invoked by Packetizer just after provideSection().
+//----------------------------------------------------------------------------
+
+ts::Packetizer::TSPacketVectorPtr ts::CyclingPacketizer::packetizedSection(const SectionPtr& section)
+{
+    if (_last_provided.isNull() || _last_provided->section != section) {
+        return TSPacketVectorPtr();
+    }
+    if (_last_provided->packets.isNull()) {
+        // First time this section is packetized alone, build its packets once.
+        _last_provided->packets = new TSPacketVector;
+        BuildPackets(*section, *_last_provided->packets);
+    }
+    return _last_provided->packets;
+}
+
+
 //----------------------------------------------------------------------------
 // This hook returns true if stuffing to the next transport
 // packet boundary shall be performed before the next section.
@@ -455,7 +474,9 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Stored sections: " << _section_count << std::endl
         << "  Scheduled sections: " << _sched_sections.size() << std::endl
         << "  Scheduled packets max: " << _sched_packets << std::endl;
-    for (SectionDescList::const_iterator it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+    SectionDescHeap sched(_sched_sections);
+    std::sort_heap(sched.begin(), sched.end(), SendAfter);
+    for (auto it = sched.rbegin(); it != sched.rend(); ++it) {
         (*it)->display(duck(), strm);
     }
     strm << "  Unscheduled sections: " << _other_sections.size() << std::endl;
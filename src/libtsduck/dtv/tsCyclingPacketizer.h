@@ -74,6 +74,13 @@ namespace ts {
     //! A bitrate is specified in bits/second. Zero means undefined.
     //! A repetition rate is specified in milliseconds. Zero means undefined.
     //!
+    //! When a section is packetized alone (starting at a packet boundary and
+    //! followed by stuffing), its TS packets are built once and cached. They
+    //! are subsequently sent again with only the PID and continuity counter
+    //! updated. The content of a section shall consequently not be modified
+    //! while it is in the packetizer. To update a section, remove it and add
+    //! the new version.
+    //!
     class TSDUCKDLL CyclingPacketizer: public Packetizer, private SectionProviderInterface
     {
         TS_NOBUILD_NOCOPY(CyclingPacketizer);
@@ -213,6 +220,10 @@ namespace ts {
         virtual void reset() override;
         virtual std::ostream& display(std::ostream& strm) const override;
 
+    protected:
+        // Inherited from Packetizer.
+        virtual TSPacketVectorPtr packetizedSection(const SectionPtr& section) override;
+
     private:
         // Each section is identified by a SectionDesc instance
         class SectionDesc
@@ -224,13 +235,12 @@ namespace ts {
             PacketCounter  last_packet; // Packet index of last time the section was sent
             PacketCounter  due_packet;  // Packet index of next time
             SectionCounter last_cycle;  // Cycle index of last time the section was sent
+            uint64_t       sched_order; // Scheduling order, for sections with identical due packets
+            TSPacketVectorPtr packets;  // Cached packets when the section is packetized alone
 
             // Constructor
             SectionDesc(const SectionPtr& sec, MilliSecond rep);
 
-            // Check if this section shall be inserted after some other one.
-            bool insertAfter(const SectionDesc& other) const;
-
             // Display the internal state, mainly for debug.
             std::ostream& display(const DuckContext&, std::ostream&) const;
         };
@@ -241,24 +251,33 @@ namespace ts {
         // List of sections
         typedef std::list <SectionDescPtr> SectionDescList;
 
+        // Heap of scheduled sections. The front of the heap is the next section to send.
+        typedef std::vector <SectionDescPtr> SectionDescHeap;
+
+        // Ordering of the heap of scheduled sections: true if s1 shall be sent after s2.
+        static bool SendAfter(const SectionDescPtr& s1, const SectionDescPtr& s2);
+
         // Private members:
         StuffingPolicy  _stuffing;
         BitRate         _bitrate;
         size_t          _section_count;   // Number of sections in the 2 lists
-        SectionDescList _sched_sections;  // Scheduled sections, with repetition rates
+        SectionDescHeap _sched_sections;  // Scheduled sections, with repetition rates
         SectionDescList _other_sections;  // Unscheduled sections
         PacketCounter   _sched_packets;   // Size in TS packets of all sections in _sched_sections
+        uint64_t        _sched_order;     // Next scheduling order
         SectionCounter  _current_cycle;   // Cycle number (start at 1, always increasing)
         size_t          _remain_in_cycle; // Number of unsent sections in this cycle
         SectionCounter  _cycle_end;       // At end of cycle, contains the index of last section
+        SectionDescPtr  _last_provided;   // Last provided section
 
         static const SectionCounter UNDEFINED = ~SectionCounter(0);
 
-        // Insert a scheduled section in the list, sorted by due_packet.
+        // Insert a scheduled section in the heap, sorted by due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
-        // Remove all sections with the specified tid/tid_ext in the specified list.
-        void removeSections(SectionDescList&, TID, uint16_t tid_ext, bool use_tid_ext, bool scheduled);
+        // Remove all sections with the specified tid/tid_ext in the specified lists.
+        void removeSections(TID, uint16_t tid_ext, bool use_tid_ext);
+        bool removeSection(const SectionDescPtr&, TID, uint16_t tid_ext, bool use_tid_ext, bool scheduled);
 
         // Inherited from SectionProviderInterface
         virtual void provideSection(SectionCounter, SectionPtr&) override;
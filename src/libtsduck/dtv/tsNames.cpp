@@ -33,6 +33,8 @@
 #include "tsSysUtils.h"
 #include "tsFatal.h"
 #include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsByteBlock.h"
 #include "tsPSIRepository.h"
 TSDUCK_SOURCE;
 
@@ -382,18 +384,20 @@ ts::UString ts::names::AC3ComponentType(uint8_t type, Flags flags)
 // Constructor (load the configuration file).
 //----------------------------------------------------------------------------
 
-ts::Names::Names(const UString& fileName, bool mergeExtensions) :
+ts::Names::Names(const UString& fileName, bool mergeExtensions, bool useBinary) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
     _configErrors(0),
-    _sections()
+    _sections(),
+    _binary()
 {
     // Locate the configuration file.
     if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
     }
-    else {
+    else if (!useBinary || !loadBinary(BinaryFileName(_configFile))) {
+        // No usable compiled file, parse the text file.
         loadFile(_configFile);
     }
 
@@ -429,6 +433,7 @@ void ts::Names::loadFile(const UString& fileName)
     }
 
     ConfigSection* section = nullptr;
+    UString sectionName;
     UString line;
 
     // Read configuration file line by line.
@@ -445,6 +450,7 @@ void ts::Names::loadFile(const UString& fileName)
             line.erase(0, 1);
             line.pop_back();
             line.convertToLower();
+            sectionName = line;
 
             // Get or create associated section.
             ConfigSectionMap::iterator it = _sections.find(line);
@@ -458,7 +464,7 @@ void ts::Names::loadFile(const UString& fileName)
                 _sections.insert(std::make_pair(line, section));
             }
         }
-        else if (!decodeDefinition(line, section)) {
+        else if (!decodeDefinition(line, section, section == nullptr ? nullptr : binarySection(sectionName))) {
             // Invalid line.
             _log.error(u"%s: invalid line %d: %s", {fileName, lineNumber, line});
             if (++_configErrors >= 20) {
@@ -476,7 +482,7 @@ void ts::Names::loadFile(const UString& fileName)
 // Decode a line as "first[-last] = name". Return true on success.
 //----------------------------------------------------------------------------
 
-bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
+bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section, const BinarySection* binSection)
 {
     // Check the presence of the '=' and in a valid section.
     const size_t equal = line.find(UChar('='));
@@ -515,7 +521,7 @@ bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
 
     // Add the definition.
     if (valid) {
-        if (section->freeRange(first, last)) {
+        if (section->freeRange(first, last) && (binSection == nullptr || binaryFreeRange(binSection, first, last))) {
             section->addEntry(first, last, value);
         }
         else {
@@ -527,6 +533,175 @@ bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
 }
 
 
+//----------------------------------------------------------------------------
+// Compiled binary file.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Binary file identification.
+    const char BINARY_MAGIC[8] = {'T', 'S', 'N', 'A', 'M', 'E', 'S', '1'};
+    const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+}
+
+// Load a compiled binary file.
+bool ts::Names::loadBinary(const UString& fileName)
+{
+    // The binary file must exist and be more recent than the text file.
+    if (!FileExists(fileName) || GetFileModificationTimeUTC(fileName) < GetFileModificationTimeUTC(_configFile) || !_binary.open(fileName, NULLREP)) {
+        return false;
+    }
+
+    // Check the consistency of the header and sections.
+    const uint8_t* const base = _binary.data();
+    const size_t size = _binary.size();
+    const BinaryHeader* const header = reinterpret_cast<const BinaryHeader*>(base);
+    bool valid = size >= sizeof(BinaryHeader) &&
+        ::memcmp(header->magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0 &&
+        header->byteOrder == BINARY_BYTE_ORDER &&
+        int64_t(header->sourceSize) == GetFileSize(_configFile) &&
+        size >= sizeof(BinaryHeader) + size_t(header->sectionCount) * sizeof(BinarySection);
+
+    const BinarySection* const sections = reinterpret_cast<const BinarySection*>(base + sizeof(BinaryHeader));
+    for (size_t i = 0; valid && i < header->sectionCount; ++i) {
+        const BinarySection& sec(sections[i]);
+        valid = sec.entriesOffset % sizeof(Value) == 0 &&
+            sec.entriesOffset <= size &&
+            size_t(sec.entryCount) <= (size - size_t(sec.entriesOffset)) / sizeof(BinaryEntry) &&
+            size_t(sec.nameOffset) + 2 * size_t(sec.nameLength) <= size;
+    }
+
+    if (!valid) {
+        _log.debug(u"invalid or obsolete compiled names file %s", {fileName});
+        _binary.close();
+    }
+    return valid;
+}
+
+// Get a string from the binary file.
+ts::UString ts::Names::binaryString(uint32_t offset, uint32_t length) const
+{
+    if (size_t(offset) + sizeof(UChar) * size_t(length) > _binary.size()) {
+        return UString();
+    }
+    else {
+        return UString(reinterpret_cast<const UChar*>(_binary.data() + offset), length);
+    }
+}
+
+// Get a section in the binary file, null if not found.
+const ts::Names::BinarySection* ts::Names::binarySection(const UString& sectionName) const
+{
+    if (!_binary.isOpen()) {
+        return nullptr;
+    }
+
+    // Sections are sorted by name, use a binary search.
+    const uint8_t* const base = _binary.data();
+    const BinarySection* const sections = reinterpret_cast<const BinarySection*>(base + sizeof(BinaryHeader));
+    size_t low = 0;
+    size_t high = reinterpret_cast<const BinaryHeader*>(base)->sectionCount;
+
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const UChar* const name = reinterpret_cast<const UChar*>(base + sections[mid].nameOffset);
+        const UChar* const nameEnd = name + sections[mid].nameLength;
+        if (std::lexicographical_compare(name, nameEnd, sectionName.begin(), sectionName.end())) {
+            low = mid + 1;
+        }
+        else if (std::lexicographical_compare(sectionName.begin(), sectionName.end(), name, nameEnd)) {
+            high = mid;
+        }
+        else {
+            return &sections[mid];
+        }
+    }
+    return nullptr;
+}
+
+// Get a name from a value in a binary section, empty if not found.
+ts::UString ts::Names::binaryName(const BinarySection* section, Value val) const
+{
+    // Entries are sorted by first value. Find the first entry which starts after val.
+    const BinaryEntry* const begin = reinterpret_cast<const BinaryEntry*>(_binary.data() + section->entriesOffset);
+    const BinaryEntry* const end = begin + section->entryCount;
+    const BinaryEntry* it = std::upper_bound(begin, end, val, [](Value v, const BinaryEntry& e) { return v < e.first; });
+
+    // The previous entry, if any, is the only one which may contain val.
+    if (it == begin || (--it)->last < val) {
+        return UString();
+    }
+    else {
+        return binaryString(it->nameOffset, it->nameLength);
+    }
+}
+
+// Check if a range is free in a binary section.
+bool ts::Names::binaryFreeRange(const BinarySection* section, Value first, Value last) const
+{
+    // The last entry which starts before or at 'last' must end before 'first'.
+    const BinaryEntry* const begin = reinterpret_cast<const BinaryEntry*>(_binary.data() + section->entriesOffset);
+    const BinaryEntry* const end = begin + section->entryCount;
+    const BinaryEntry* it = std::upper_bound(begin, end, last, [](Value v, const BinaryEntry& e) { return v < e.first; });
+    return it == begin || (--it)->last < first;
+}
+
+// Save the names into a compiled binary file.
+bool ts::Names::saveBinary(const UString& fileName, Report& report) const
+{
+    // Compute the layout of the fixed-size parts.
+    size_t entryCount = 0;
+    for (ConfigSectionMap::const_iterator it = _sections.begin(); it != _sections.end(); ++it) {
+        entryCount += it->second->entries.size();
+    }
+    size_t sectionOffset = sizeof(BinaryHeader);
+    size_t entryOffset = sectionOffset + _sections.size() * sizeof(BinarySection);
+    ByteBlock data(entryOffset + entryCount * sizeof(BinaryEntry), 0);
+
+    // Append a string in the pool, return its offset.
+    auto addString = [&data](const UString& str) -> uint32_t {
+        const size_t offset = data.size();
+        data.append(str.data(), sizeof(UChar) * str.size());
+        return uint32_t(offset);
+    };
+
+    // Build the header.
+    BinaryHeader header;
+    ::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.byteOrder = BINARY_BYTE_ORDER;
+    header.sectionCount = uint32_t(_sections.size());
+    header.sourceSize = _configFile.empty() ? 0 : uint64_t(GetFileSize(_configFile));
+    ::memcpy(data.data(), &header, sizeof(header));
+
+    // The section map is sorted by name and each entry map is sorted by first value.
+    for (ConfigSectionMap::const_iterator sit = _sections.begin(); sit != _sections.end(); ++sit) {
+        BinarySection sec;
+        sec.nameOffset = addString(sit->first);
+        sec.nameLength = uint32_t(sit->first.size());
+        sec.bits = uint32_t(sit->second->bits);
+        sec.entryCount = uint32_t(sit->second->entries.size());
+        sec.entriesOffset = uint64_t(entryOffset);
+        ::memcpy(data.data() + sectionOffset, &sec, sizeof(sec));
+        sectionOffset += sizeof(sec);
+
+        for (ConfigEntryMap::const_iterator eit = sit->second->entries.begin(); eit != sit->second->entries.end(); ++eit) {
+            BinaryEntry ent;
+            ent.first = eit->first;
+            ent.last = eit->second->last;
+            ent.nameOffset = addString(eit->second->name);
+            ent.nameLength = uint32_t(eit->second->name.size());
+            ::memcpy(data.data() + entryOffset, &ent, sizeof(ent));
+            entryOffset += sizeof(ent);
+        }
+    }
+
+    if (data.size() > std::numeric_limits<uint32_t>::max()) {
+        report.error(u"too many names to save in %s", {fileName});
+        return false;
+    }
+    return data.saveToFile(fileName, &report);
+}
+
+
 //----------------------------------------------------------------------------
 // Destructor: free all resources.
 //----------------------------------------------------------------------------
@@ -732,15 +907,49 @@ ts::UString ts::Names::Formatted(Value value, const UString& name, names::Flags
 }
 
 
+//----------------------------------------------------------------------------
+// Get the name and number of bits for a value, from text and binary sections.
+//----------------------------------------------------------------------------
+
+bool ts::Names::getName(const UString& sectionName, Value value, UString& name, size_t& bits) const
+{
+    bool found = false;
+    name.clear();
+    bits = 0;
+
+    // Sections from text files are searched first.
+    const ConfigSectionMap::const_iterator it = _sections.find(sectionName);
+    if (it != _sections.end()) {
+        found = true;
+        name = it->second->getName(value);
+        bits = it->second->bits;
+    }
+
+    // Then the section from the compiled binary file.
+    const BinarySection* const bin = binarySection(sectionName);
+    if (bin != nullptr) {
+        found = true;
+        if (name.empty()) {
+            name = binaryName(bin, value);
+        }
+        if (bits == 0) {
+            bits = bin->bits;
+        }
+    }
+    return found;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a name exists in a specified section.
 //----------------------------------------------------------------------------
 
 bool ts::Names::nameExists(const UString& sectionName, Value value) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    return it != _sections.end() && !it->second->getName(value).empty();
+    // Normalize the section name.
+    UString name;
+    size_t sectionBits = 0;
+    return getName(sectionName.toTrimmed().toLower(), value, name, sectionBits) && !name.empty();
 }
 
 
@@ -750,16 +959,16 @@ bool ts::Names::nameExists(const UString& sectionName, Value value) const
 
 ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
+    // Get the name, normalize the section name.
+    UString name;
+    size_t sectionBits = 0;
 
-    if (section == nullptr) {
+    if (!getName(sectionName.toTrimmed().toLower(), value, name, sectionBits)) {
         // Non-existent section, no name.
         return Formatted(value, UString(), flags, bits, alternateValue);
     }
     else {
-        return Formatted(value, section->getName(value), flags, bits != 0 ? bits : section->bits, alternateValue);
+        return Formatted(value, name, flags, bits != 0 ? bits : sectionBits, alternateValue);
     }
 }
 
@@ -770,23 +979,22 @@ ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value,
 
 ts::UString ts::Names::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
+    // Get the name, normalize the section name.
+    const UString normalized(sectionName.toTrimmed().toLower());
+    UString name;
+    size_t sectionBits = 0;
 
-    if (section == nullptr) {
+    if (!getName(normalized, value1, name, sectionBits)) {
         // Non-existent section, no name.
         return Formatted(value1, UString(), flags, bits, alternateValue);
     }
+    else if (!name.empty()) {
+        // value1 has a name
+        return Formatted(value1, name, flags, bits != 0 ? bits : sectionBits, alternateValue);
+    }
     else {
-        const UString name(section->getName(value1));
-        if (!name.empty()) {
-            // value1 has a name
-            return Formatted(value1, name, flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
-        else {
-            // value1 has no name, use value2.
-            return Formatted(value2, section->getName(value2), flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
+        // value1 has no name, use value2.
+        getName(normalized, value2, name, sectionBits);
+        return Formatted(value2, name, flags, bits != 0 ? bits : sectionBits, alternateValue);
     }
 }
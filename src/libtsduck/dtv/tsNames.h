@@ -39,6 +39,7 @@
 #include "tsCASFamily.h"
 #include "tsMPEG.h"
 #include "tsReport.h"
+#include "tsMemoryMappedFile.h"
 #include "tsSingletonManager.h"
 
 // Forward declaration to allow using the '|' operator in the definition of the enum type.
@@ -363,6 +364,12 @@ namespace ts {
     //! A repository of names for MPEG/DVB entities.
     //! All names are loaded from configuration files @em tsduck*.names.
     //!
+    //! A configuration file can be compiled into a binary file with the same name
+    //! and an additional ".bin" suffix (see saveBinary()). When an up-to-date binary
+    //! file is found in the same directory as the text file, it is mapped in memory
+    //! and used without building any map. Names files from extensions are always
+    //! parsed from text and merged over the binary content.
+    //!
     class TSDUCKDLL Names
     {
         TS_NOBUILD_NOCOPY(Names);
@@ -371,8 +378,10 @@ namespace ts {
         //! Constructor.
         //! @param [in] fileName Configuration file name. Typically without directory name.
         //! @param [in] mergeExtensions If true, merge the content of names files from extensions.
+        //! @param [in] useBinary If true, use the compiled binary form of the configuration file
+        //! when it exists and is up to date. If false, always parse the text file.
         //!
-        Names(const UString& fileName, bool mergeExtensions = false);
+        Names(const UString& fileName, bool mergeExtensions = false, bool useBinary = true);
 
         //!
         //! Virtual destructor.
@@ -402,6 +411,35 @@ namespace ts {
             return _configErrors;
         }
 
+        //!
+        //! Check if the names were loaded from a compiled binary file.
+        //! @return True if the names were loaded from a compiled binary file.
+        //!
+        bool isBinary() const
+        {
+            return _binary.isOpen();
+        }
+
+        //!
+        //! Get the name of the compiled binary file for a text configuration file.
+        //! @param [in] fileName Name of a text configuration file.
+        //! @return The name of the corresponding compiled binary file.
+        //!
+        static UString BinaryFileName(const UString& fileName)
+        {
+            return fileName + u".bin";
+        }
+
+        //!
+        //! Save the names into a compiled binary file.
+        //! The binary file can be directly mapped in memory by all processes.
+        //! Only the names which were parsed from text files are saved.
+        //! @param [in] fileName Name of the binary file to create.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool saveBinary(const UString& fileName, Report& report) const;
+
         //!
         //! Check if a name exists in a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -483,8 +521,51 @@ namespace ts {
         // Map of configuration sections, indexed by name.
         typedef std::map<UString, ConfigSection*> ConfigSectionMap;
 
+        // Layout of a compiled binary file, all integers in native byte order.
+        // The file starts with a header, followed by the array of sections, sorted
+        // by name, the arrays of entries, sorted by first value, and all strings in
+        // UTF-16. All offsets are in bytes from the beginning of the file.
+        struct BinaryHeader {
+            char     magic[8];       // Binary file identification.
+            uint32_t byteOrder;      // Constant value to check the byte order.
+            uint32_t sectionCount;   // Number of sections.
+            uint64_t sourceSize;     // Size of the source text file.
+        };
+        struct BinarySection {
+            uint32_t nameOffset;     // Offset of section name (lowercase).
+            uint32_t nameLength;     // Number of characters in section name.
+            uint32_t bits;           // Number of significant bits in values of the type.
+            uint32_t entryCount;     // Number of entries in the section.
+            uint64_t entriesOffset;  // Offset of the array of entries.
+        };
+        struct BinaryEntry {
+            Value    first;          // First value in the range.
+            Value    last;           // Last value in the range.
+            uint32_t nameOffset;     // Offset of associated name.
+            uint32_t nameLength;     // Number of characters in associated name.
+        };
+
+        // Load a compiled binary file. Return false if not found, invalid or out of date.
+        bool loadBinary(const UString& fileName);
+
+        // Get a section in the binary file, null if not found.
+        const BinarySection* binarySection(const UString& sectionName) const;
+
+        // Get a string from the binary file.
+        UString binaryString(uint32_t offset, uint32_t length) const;
+
+        // Get a name from a value in a binary section, empty if not found.
+        UString binaryName(const BinarySection* section, Value val) const;
+
+        // Check if a range is free in a binary section.
+        bool binaryFreeRange(const BinarySection* section, Value first, Value last) const;
+
+        // Get the name and number of bits for a value. The section name must be normalized.
+        // Return false if the section does not exist.
+        bool getName(const UString& sectionName, Value value, UString& name, size_t& bits) const;
+
         // Decode a line as "first[-last] = name". Return true on success, false on error.
-        bool decodeDefinition(const UString& line, ConfigSection* section);
+        bool decodeDefinition(const UString& line, ConfigSection* section, const BinarySection* binSection);
 
         // Compute a number of hexa digits.
         static int HexaDigits(size_t bits);
@@ -500,6 +581,7 @@ namespace ts {
         const UString    _configFile;    // Configuration file path.
         size_t           _configErrors;  // Number of errors in configuration file.
         ConfigSectionMap _sections;      // Configuration sections.
+        MemoryMappedFile _binary;        // Compiled binary file, when used.
     };
 
     //!
@@ -41,12 +41,16 @@ TSDUCK_SOURCE;
 //----------------------------------------------------------------------------
 
 namespace {
-
-    // Start code prefix for ISO 11172-2 (MPEG-1 video) and ISO 13818-2 (MPEG-2 video)
-    const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
-
-    // End of AVC NALunit delimiter
-    const uint8_t Zero3[] = {0x00, 0x00, 0x00};
+    // Locate the next start code prefix 00 00 01 (MPEG-1/2 video, AVC), skipping 00 00 00 sequences.
+    // Return zero if not found.
+    const uint8_t* LocateStartCode(const uint8_t* data, const uint8_t* end)
+    {
+        const uint8_t* p = ts::LocateZeroZero(data, end - data);
+        while (p != nullptr && p[2] != 0x01) {
+            p = ts::LocateZeroZero(p + 1, end - p - 1);
+        }
+        return p;
+    }
 }
 
 
@@ -87,6 +91,7 @@ ts::PESDemux::PIDContext::PIDContext() :
     last_pkt(0),
     pcr(INVALID_PCR),
     ts(new ByteBlock()),
+    last_size(0),
     audio(),
     video(),
     avc(),
@@ -96,6 +101,75 @@ ts::PESDemux::PIDContext::PIDContext() :
 }
 
 
+//----------------------------------------------------------------------------
+// PIDContext: empty the PES buffer.
+//----------------------------------------------------------------------------
+
+void ts::PESDemux::PIDContext::resetBuffer()
+{
+    // The buffer may be shared with a PES packet which is still referenced
+    // by a handler. In that case, don't modify it, use a new one.
+    if (ts.count() > 1) {
+        ts = new ByteBlock();
+    }
+    else {
+        ts->clear();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// PIDContext: start a new PES packet.
+//----------------------------------------------------------------------------
+
+void ts::PESDemux::PIDContext::startPES(const uint8_t* payload, size_t size)
+{
+    // The previous PES packet may still be referenced by a handler which
+    // kept a shared copy of it. In that case, don't overwrite it.
+    if (ts.count() > 1) {
+        ts = new ByteBlock();
+    }
+
+    // Preallocate the buffer once for the complete PES packet to avoid copies
+    // during reallocations. Use the PES packet length when specified. Otherwise,
+    // the PES packet is unbounded (usually video), assume a size which is close
+    // to the previous PES packet on the same PID.
+    const size_t len = size >= 6 ? GetUInt16(payload + 4) : 0;
+    const size_t expected = len > 0 ? 6 + len : last_size + last_size / 4;
+    if (ts->capacity() < expected) {
+        ts->reserve(expected);
+    }
+    ts->copy(payload, size);
+}
+
+
+//----------------------------------------------------------------------------
+// PIDContext: append a TS payload in the current PES packet.
+//----------------------------------------------------------------------------
+
+void ts::PESDemux::PIDContext::appendPES(const uint8_t* payload, size_t size)
+{
+    const size_t capacity = ts->capacity();
+    if (ts->size() + size > capacity) {
+        // Internal reallocation needed in ts buffer.
+        // Do not allow implicit reallocation, do it manually for better performance.
+        // Use two predefined thresholds: 64 kB and 512 kB. Above that, double the size.
+        // Note that 64 kB is OK for audio PIDs. Video PIDs are usually unbounded. The
+        // maximum observed PES rate is 2 PES/s, meaning 512 kB / PES at 8 Mb/s.
+        if (capacity < 64 * 1024) {
+            ts->reserve(64 * 1024);
+        }
+        else if (capacity < 512 * 1024) {
+            ts->reserve(512 * 1024);
+        }
+        else {
+            ts->reserve(2 * capacity);
+        }
+    }
+    ts->append(payload, size);
+}
+
+
 //----------------------------------------------------------------------------
 // Reset the analysis context (partially built PES packets).
 //----------------------------------------------------------------------------
@@ -242,7 +316,7 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
             PIDContext& pc(_pids[pid]);
             pc.continuity = pkt.getCC();
             pc.sync = true;
-            pc.ts->copy(pl, pl_size);
+            pc.startPES(pl, pl_size);
             pc.first_pkt = _packet_count;
             pc.last_pkt = _packet_count;
             pc.pcr = pkt.getPCR(); // can be invalid
@@ -275,24 +349,7 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
     pc.continuity = pkt.getCC();
 
     // Append the TS payload in PID context.
-    size_t capacity = pc.ts->capacity();
-    if (pc.ts->size() + pl_size > capacity) {
-        // Internal reallocation needed in ts buffer.
-        // Do not allow implicit reallocation, do it manually for better performance.
-        // Use two predefined thresholds: 64 kB and 512 kB. Above that, double the size.
-        // Note that 64 kB is OK for audio PIDs. Video PIDs are usually unbounded. The
-        // maximum observed PES rate is 2 PES/s, meaning 512 kB / PES at 8 Mb/s.
-        if (capacity < 64 * 1024) {
-            pc.ts->reserve(64 * 1024);
-        }
-        else if (capacity < 512 * 1024) {
-            pc.ts->reserve(512 * 1024);
-        }
-        else {
-            pc.ts->reserve(2 * capacity);
-        }
-    }
-    pc.ts->append(pl, pl_size);
+    pc.appendPES(pl, pl_size);
 
     // Last TS packet containing actual data for this PES packet
     pc.last_pkt = _packet_count;
@@ -308,11 +365,11 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
         const size_t len = GetUInt16(pc.ts->data() + 4);
         // If the size is zero, the PES packet is "unbounded", meaning it ends at the next PUSI.
         // But if the PES packet size is specified, check if we have the complete PES packet.
-        if (len != 0 && pc.ts->size() >= 4 + len) {
+        // The PES packet length counts the bytes after the 6-byte fixed header.
+        if (len != 0 && pc.ts->size() >= 6 + len) {
             // We have the complete PES packet.
             processPESPacket(pid, pc);
-            // Reset PES buffer.
-            pc.ts->clear();
+            pc.resetBuffer();
         }
     }
 }
@@ -372,7 +429,10 @@ void ts::PESDemux::handlePESPacket(const PESPacket& packet)
 
 void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
 {
-    // Build a PES packet object around the TS buffer
+    // Remember the PES packet size to preallocate the next one.
+    pc.last_size = pc.ts->size();
+
+    // Build a PES packet object around the TS buffer, without copy.
     PESPacket pp(pc.ts, pid);
     if (!pp.isValid()) {
         return;
@@ -410,8 +470,8 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
             // The beginning of the payload is already a start code prefix.
             for (size_t offset = 0; offset < psize; ) {
                 // Look for next start code
-                const void* pnext = LocatePattern(pdata + offset + 1, psize - offset - 1, StartCodePrefix, sizeof(StartCodePrefix));
-                size_t next = pnext == nullptr ? psize : reinterpret_cast<const uint8_t*>(pnext) - pdata;
+                const uint8_t* pnext = LocateStartCode(pdata + offset + 1, pdata + psize);
+                size_t next = pnext == nullptr ? psize : pnext - pdata;
                 // Invoke handler
                 if (_pes_handler != nullptr) {
                     _pes_handler->handleVideoStartCode(*this, pp, pdata[offset + 3], offset, next - offset);
@@ -430,33 +490,16 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
         else if (pp.isAVC()) {
             for (size_t offset = 0; offset < psize; ) {
                 // Locate next access unit: starts with 00 00 01 (this start code is not part of the NALunit)
-                const uint8_t* p1 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, StartCodePrefix, sizeof(StartCodePrefix)));
+                const uint8_t* p1 = LocateStartCode(pdata + offset, pdata + psize);
                 if (p1 == nullptr) {
                     break;
                 }
-                offset = p1 - pdata + sizeof(StartCodePrefix);
+                offset = p1 - pdata + 3;
 
                 // Locate end of access unit: ends with 00 00 00, 00 00 01 or end of data.
-                const uint8_t* p2 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, StartCodePrefix, sizeof(StartCodePrefix)));
-                const uint8_t* p3 = reinterpret_cast<const uint8_t*>(
-                            LocatePattern(pdata + offset, psize - offset, Zero3, sizeof(Zero3)));
-                size_t nalunit_size = 0;
-                if (p2 == nullptr && p3 == nullptr) {
-                    // No 00 00 01, no 00 00 00, the NALunit extends up to the end of data.
-                    nalunit_size = psize - offset;
-                }
-                else if (p2 == nullptr || (p3 != nullptr && p3 < p2)) {
-                    // NALunit ends at 00 00 00.
-                    assert(p3 != nullptr);
-                    nalunit_size = p3 - pdata - offset;
-                }
-                else {
-                    // NALunit ends at 00 00 01.
-                    assert(p2 != nullptr);
-                    nalunit_size = p2 - pdata - offset;
-                }
+                // Both delimiters are found in one single pass.
+                const uint8_t* p2 = LocateZeroZero(pdata + offset, psize - offset);
+                const size_t nalunit_size = p2 == nullptr ? psize - offset : p2 - pdata - offset;
 
                 // Compute NALunit type.
                 const uint8_t nalunit_type = nalunit_size == 0 ? 0 : (pdata[offset] & 0x1F);
@@ -147,6 +147,7 @@ namespace ts {
             PacketCounter   last_pkt;    // Index of last TS packet for current PES packet
             uint64_t        pcr;         // First PCR for current PES packet
             ByteBlockPtr    ts;          // TS payload buffer
+            size_t          last_size;   // Size of last PES packet, used to preallocate the next one
             AudioAttributes audio;       // Current audio attributes
             VideoAttributes video;       // Current video attributes (MPEG-1, MPEG-2)
             AVCAttributes   avc;         // Current AVC attributes
@@ -157,7 +158,16 @@ namespace ts {
             PIDContext();
 
             // Called when packet synchronization is lost on the pid
-            void syncLost() {sync = false; ts->clear();}
+            void syncLost() {sync = false; resetBuffer();}
+
+            // Empty the PES buffer, reallocate it if still referenced by a handler.
+            void resetBuffer();
+
+            // Start a new PES packet with the payload of its first TS packet.
+            void startPES(const uint8_t* payload, size_t size);
+
+            // Append the payload of a TS packet in the current PES packet.
+            void appendPES(const uint8_t* payload, size_t size);
         };
 
         // Map of PID contexts, indexed by PID.
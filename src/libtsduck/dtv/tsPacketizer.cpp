@@ -45,7 +45,9 @@ ts::Packetizer::Packetizer(const DuckContext& duck, PID pid, SectionProviderInte
     _section(nullptr),
     _next_byte(0),
     _section_out_count(0),
-    _section_in_count(0)
+    _section_in_count(0),
+    _packets(),
+    _next_packet(0)
 {
 }
 
@@ -63,6 +65,46 @@ void ts::Packetizer::reset()
     AbstractPacketizer::reset();
     _section.clear();
     _next_byte = 0;
+    _packets.clear();
+    _next_packet = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the pre-packetized form of a section. Default: none.
+//----------------------------------------------------------------------------
+
+ts::Packetizer::TSPacketVectorPtr ts::Packetizer::packetizedSection(const SectionPtr&)
+{
+    return TSPacketVectorPtr();
+}
+
+
+//----------------------------------------------------------------------------
+// Packetize one section alone, with stuffing at end of last packet.
+//----------------------------------------------------------------------------
+
+void ts::Packetizer::BuildPackets(const Section& section, TSPacketVector& packets)
+{
+    const uint8_t* data = section.content();
+    size_t remain = section.size();
+
+    packets.resize(size_t(section.packetCount()));
+    for (size_t pi = 0; pi < packets.size(); ++pi) {
+        uint8_t* const b = packets[pi].b;
+        size_t offset = 4;
+        b[0] = SYNC_BYTE;
+        PutUInt16(b + 1, pi == 0 ? 0x4000 : 0x0000);
+        b[3] = 0x10;  // no adaptation field, has payload
+        if (pi == 0) {
+            b[offset++] = 0x00;  // pointer field, section starts immediately
+        }
+        const size_t length = std::min(remain, PKT_SIZE - offset);
+        ::memcpy(b + offset, data, length);  // Flawfinder: ignore: memcpy()
+        ::memset(b + offset + length, 0xFF, PKT_SIZE - offset - length);
+        data += length;
+        remain -= length;
+    }
 }
 
 
@@ -78,7 +120,29 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         _next_byte = 0;
         if (!_section.isNull()) {
             _section_in_count++;
+            // The new section starts at a packet boundary. When stuffing is required after it,
+            // the section is packetized alone and its pre-packetized form can be used.
+            if (_provider->doStuffing()) {
+                _packets = packetizedSection(_section);
+                _next_packet = 0;
+            }
+        }
+    }
+
+    // Send the next pre-packetized packet of the current section, only set PID and CC.
+    if (!_packets.isNull() && _next_packet < _packets->size()) {
+        pkt = (*_packets)[_next_packet++];
+        configurePacket(pkt, false);
+        _next_byte += _next_packet == 1 ? PKT_SIZE - 5 : PKT_SIZE - 4;
+        if (_next_packet >= _packets->size()) {
+            // End of section reached.
+            _section_out_count++;
+            _section.clear();
+            _next_byte = 0;
+            _packets.clear();
+            _next_packet = 0;
         }
+        return true;
     }
 
     // If there is still no current section, return a null packet
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsAbstractPacketizer.h"
 #include "tsSectionProviderInterface.h"
+#include "tsTSPacket.h"
 
 namespace ts {
     //!
@@ -105,6 +106,37 @@ namespace ts {
         virtual bool getNextPacket(TSPacket& packet) override;
         virtual std::ostream& display(std::ostream& strm) const override;
 
+    protected:
+        //!
+        //! Safe pointer to a vector of pre-packetized TS packets (not thread-safe).
+        //!
+        typedef SafePtr<TSPacketVector, NullMutex> TSPacketVectorPtr;
+
+        //!
+        //! Get the pre-packetized form of a section.
+        //!
+        //! This hook is invoked when a new section starts at a packet boundary and
+        //! the section provider requests stuffing after it. The section is then
+        //! packetized alone and its packets are identical each time the section
+        //! is sent, except for the PID and continuity counter which are set by the
+        //! packetizer. Subclasses which repeatedly send the same sections may
+        //! return a cached copy of these packets. The default implementation returns
+        //! a null pointer, meaning that the section is packetized on the fly.
+        //!
+        //! @param [in] section The new section to packetize.
+        //! @return A safe pointer to the packets of the section or a null pointer.
+        //! @see BuildPackets()
+        //!
+        virtual TSPacketVectorPtr packetizedSection(const SectionPtr& section);
+
+        //!
+        //! Packetize one section alone, with stuffing at end of last packet.
+        //! The PID and continuity counters of the packets are left to zero.
+        //! @param [in] section The section to packetize.
+        //! @param [out] packets The TS packets containing the section.
+        //!
+        static void BuildPackets(const Section& section, TSPacketVector& packets);
+
     private:
         SectionProviderInterface* _provider;
         bool           _split_headers;     // Allowed to split section header beetwen TS packets.
@@ -112,5 +144,7 @@ namespace ts {
         size_t         _next_byte;         // Next byte to insert in current section
         SectionCounter _section_out_count; // Number of output (packetized) sections
         SectionCounter _section_in_count;  // Number of input (provided) sections
+        TSPacketVectorPtr _packets;        // Pre-packetized form of current section, if any
+        size_t         _next_packet;       // Next packet to send in _packets
     };
 }
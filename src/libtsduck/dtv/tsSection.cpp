@@ -616,6 +616,5 @@ std::ostream& ts::Section::dump(std::ostream& strm, int indent, uint16_t cas, bo
     }
 
     // Display section body
-    strm << UString::Dump(content(), size(), UString::HEXA | UString::ASCII | UString::OFFSET, margin.size() + 2);
-    return strm;
+    return UString::Dump(strm, content(), size(), UString::HEXA | UString::ASCII | UString::OFFSET, margin.size() + 2);
 }
@@ -32,6 +32,7 @@
 #include "tsDuckContext.h"
 #include "tsBinaryTable.h"
 #include "tsTSPacket.h"
+#include "tsCRC32.h"
 #include "tsEIT.h"
 TSDUCK_SOURCE;
 
@@ -206,7 +207,18 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
     _pids(),
     _status(),
     _get_current(true),
-    _get_next(false)
+    _get_next(false),
+    _count_repetitions(false),
+    _skip_repetitions(false),
+    _repetitions()
+{
+}
+
+ts::SectionDemux::Repetitions::Repetitions() :
+    size(0),
+    crc32(0),
+    occurrences(0),
+    changes(0)
 {
 }
 
@@ -219,12 +231,37 @@ void ts::SectionDemux::immediateReset()
 {
     SuperClass::immediateReset();
     _pids.clear();
+    _repetitions.clear();
 }
 
 void ts::SectionDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
     _pids.erase(pid);
+    _repetitions.erase(_repetitions.lower_bound(uint64_t(pid) << 40), _repetitions.lower_bound(uint64_t(pid + 1) << 40));
+}
+
+
+//----------------------------------------------------------------------------
+// Track the repetition of a binary section.
+//----------------------------------------------------------------------------
+
+bool ts::SectionDemux::trackRepetition(PID pid, const ETID& etid, uint8_t section_number, const uint8_t* data, size_t size, bool long_header)
+{
+    const uint64_t index = (uint64_t(pid) << 40) | (uint64_t(etid.tid()) << 32) | (uint64_t(etid.tidExt()) << 16) | (uint64_t(section_number) << 8);
+
+    // Long sections end with a CRC32, use it without checking it. Short sections have no CRC32, compute one.
+    const uint32_t crc = long_header ? GetUInt32(data + size - 4) : CRC32(data, size).value();
+
+    Repetitions& rep(_repetitions[index]);
+    const bool repeated = rep.occurrences > 0 && rep.size == size && rep.crc32 == crc;
+    rep.occurrences++;
+    if (!repeated) {
+        rep.size = size;
+        rep.crc32 = crc;
+        rep.changes++;
+    }
+    return repeated;
 }
 
 
@@ -457,6 +494,10 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
 
         if (section_ok) {
 
+            // With repetition tracking, identical repetitions are detected on the binary section.
+            const bool repeated = (_count_repetitions || _skip_repetitions) && trackRepetition(pid, etid, section_number, ts_start, section_length, long_header);
+            const bool notify_section = _section_handler != nullptr && !(repeated && _skip_repetitions);
+
             // Get the list of standards which define this table id and add them in context.
             _duck.addStandards(PSIRepository::Instance()->getTableStandards(etid.tid(), pid));
 
@@ -487,11 +528,11 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 }
             }
 
-            // Create a new Section object if necessary (ie. if a section
-            // hendler is registered or if this is a new section).
+            // Create a new Section object if necessary (ie. if the section
+            // handler shall be notified or if this is a new section).
             SectionPtr sect_ptr;
 
-            if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
+            if (section_ok && (notify_section || (tc != nullptr && tc->sects[section_number].isNull()))) {
                 sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
@@ -507,7 +548,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             beforeCallingHandler(pid);
             try {
                 // If a handler is defined for sections, invoke it.
-                if (section_ok && _section_handler != nullptr) {
+                if (section_ok && notify_section) {
                     _section_handler->handleSection(*this, *sect_ptr);
                 }
 
@@ -135,6 +135,59 @@ namespace ts {
             _get_next = next;
         }
 
+        //!
+        //! Track identical repetitions of sections.
+        //!
+        //! A section is identified by its PID, table id, table id extension and section number.
+        //! The content of the last occurrence of each section is identified by its size and CRC32.
+        //! This is done on the binary data, before building a Section object. For long sections,
+        //! the CRC32 is read in the section, it is not recomputed. For short sections, which have
+        //! no CRC32, the CRC32 of the complete section is computed.
+        //!
+        //! @param [in] count When true, count the occurrences and changes of all sections.
+        //! See repetitions().
+        //! @param [in] skip When true, identical repetitions of a section are not notified
+        //! to the section handler. For these repetitions, no Section object is built and
+        //! their CRC32 is not checked. The table handler is not affected.
+        //!
+        void trackRepetitions(bool count, bool skip)
+        {
+            _count_repetitions = count;
+            _skip_repetitions = skip;
+        }
+
+        //!
+        //! Repetitions of one section, see trackRepetitions().
+        //!
+        struct TSDUCKDLL Repetitions
+        {
+            size_t   size;         //!< Size in bytes of the last occurrence of the section.
+            uint32_t crc32;        //!< CRC32 of the last occurrence of the section.
+            uint64_t occurrences;  //!< Number of occurrences of the section.
+            uint64_t changes;      //!< Number of changes in the content, including the first occurrence.
+
+            //!
+            //! Default constructor.
+            //!
+            Repetitions();
+        };
+
+        //!
+        //! Map of repetitions of all sections, see trackRepetitions().
+        //! The index packs the PID, table id, table id extension and section number
+        //! in one 64-bit integer: @c (PID << 40) | (TID << 32) | (TIDext << 16) | (section << 8).
+        //!
+        typedef std::map<uint64_t, Repetitions> RepetitionsMap;
+
+        //!
+        //! Get the repetitions of all sections, when counted (see trackRepetitions()).
+        //! @return A constant reference to the map of repetitions of all sections.
+        //!
+        const RepetitionsMap& repetitions() const
+        {
+            return _repetitions;
+        }
+
         //!
         //! Demux status information.
         //! It contains error counters.
@@ -253,6 +306,9 @@ namespace ts {
         // If fill_eit is true, add missing sections in EIT.
         void fixAndFlush(bool pack, bool fill_eit);
 
+        // Track the repetition of a binary section. Return true if identical to the previous occurrence.
+        bool trackRepetition(PID pid, const ETID& etid, uint8_t section_number, const uint8_t* data, size_t size, bool long_header);
+
         // Private members:
         TableHandlerInterface*   _table_handler;
         SectionHandlerInterface* _section_handler;
@@ -260,6 +316,9 @@ namespace ts {
         Status                   _status;
         bool                     _get_current;
         bool                     _get_next;
+        bool                     _count_repetitions;
+        bool                     _skip_repetitions;
+        RepetitionsMap           _repetitions;
     };
 }
 
@@ -49,7 +49,8 @@ ts::SectionFile::SectionFile(DuckContext& duck) :
     _sections(),
     _orphanSections(),
     _xmlTweaks(),
-    _crc_op(CRC32::IGNORE)
+    _crc_op(CRC32::IGNORE),
+    _model(nullptr)
 {
 }
 
@@ -466,7 +467,8 @@ bool ts::SectionFile::loadXML(const UString& file_name, Report& report)
     clear();
     xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    xml::PullParser parser(doc);
+    return parser.open(file_name) && parseIncremental(parser, doc);
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm, Report& report)
@@ -474,7 +476,8 @@ bool ts::SectionFile::loadXML(std::istream& strm, Report& report)
     clear();
     xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(strm) && parseDocument(doc);
+    xml::PullParser parser(doc);
+    return parser.open(strm) && parseIncremental(parser, doc);
 }
 
 bool ts::SectionFile::parseXML(const UString& xml_content, Report& report)
@@ -487,11 +490,12 @@ bool ts::SectionFile::parseXML(const UString& xml_content, Report& report)
 
 bool ts::SectionFile::parseDocument(const xml::Document& doc)
 {
-    // Load the XML model for TSDuck files. Search it in TSDuck directory.
-    xml::Document model(doc.report());
-    if (!LoadModel(model)) {
+    // Load the XML model for TSDuck files, unless a preloaded one is used. Search it in TSDuck directory.
+    xml::Document localModel(doc.report());
+    if (_model == nullptr && !LoadModel(localModel)) {
         return false;
     }
+    const xml::Document& model(_model != nullptr ? *_model : localModel);
 
     // Validate the input document according to the model.
     if (!doc.validate(model)) {
@@ -518,6 +522,47 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
 }
 
 
+//----------------------------------------------------------------------------
+// Load an XML document incrementally, one table at a time.
+// Large XML files are loaded with a bounded memory usage: the document
+// contains at most one table at a time under the root element.
+//----------------------------------------------------------------------------
+
+bool ts::SectionFile::parseIncremental(xml::PullParser& parser, xml::Document& doc)
+{
+    // Load the XML model for TSDuck files, unless a preloaded one is used. Search it in TSDuck directory.
+    xml::Document localModel(doc.report());
+    if (_model == nullptr && !LoadModel(localModel)) {
+        return false;
+    }
+    const xml::Document& model(_model != nullptr ? *_model : localModel);
+
+    // Validate the root element alone (with all its attributes), in case there is no table.
+    if (!doc.validate(model)) {
+        return false;
+    }
+
+    // Analyze all tables in the document. Validate each table as the only child of the root.
+    bool success = true;
+    const xml::Element* node = nullptr;
+    while ((node = parser.nextElement()) != nullptr) {
+        if (!doc.validate(model)) {
+            return false;
+        }
+        BinaryTablePtr bin(new BinaryTable);
+        CheckNonNull(bin.pointer());
+        if (bin->fromXML(_duck, node) && bin->isValid()) {
+            add(bin);
+        }
+        else {
+            doc.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+            success = false;
+        }
+    }
+    return success && parser.success();
+}
+
+
 //----------------------------------------------------------------------------
 // Create XML file or text.
 //----------------------------------------------------------------------------
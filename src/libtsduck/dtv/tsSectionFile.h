@@ -35,6 +35,7 @@
 #pragma once
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlPullParser.h"
 #include "tsMPEG.h"
 #include "tsSection.h"
 #include "tsBinaryTable.h"
@@ -164,6 +165,18 @@ namespace ts {
         //!
         void setCRCValidation(CRC32::Validation crc_op) { _crc_op = crc_op; }
 
+        //!
+        //! Set a preloaded XML model for tables and descriptors.
+        //! By default, the XML model is loaded each time an XML file is loaded or parsed.
+        //! When many XML files are processed, it is more efficient to load the model once
+        //! using LoadModel() and share it between all SectionFile instances.
+        //! @param [in] model Address of the XML model to use. The model is never modified
+        //! and can be simultaneously used by several SectionFile instances in distinct threads.
+        //! It must remain valid as long as this object is used. If null, the model is loaded
+        //! each time an XML file is loaded or parsed.
+        //!
+        void setModel(const xml::Document* model) { _model = model; }
+
         //!
         //! Load a binary or XML file.
         //! @param [in] file_name XML file name.
@@ -382,6 +395,7 @@ namespace ts {
         SectionPtrVector     _orphanSections;  //!< Sections which do not belong to any table.
         xml::Tweaks          _xmlTweaks;       //!< XML formatting and parsing tweaks.
         CRC32::Validation    _crc_op;          //!< Processing of CRC32 when loading sections.
+        const xml::Document* _model;           //!< Preloaded XML model, null if not set.
 
         //!
         //! Rebuild _tables and _orphanSections from _sections.
@@ -395,6 +409,14 @@ namespace ts {
         //!
         bool parseDocument(const xml::Document& doc);
 
+        //!
+        //! Load an XML document incrementally, one table at a time.
+        //! @param [in,out] parser Pull parser, already opened.
+        //! @param [in,out] doc Document into which @a parser loads the tables.
+        //! @return True on success, false on error.
+        //!
+        bool parseIncremental(xml::PullParser& parser, xml::Document& doc);
+
         //!
         //! Generate an XML document.
         //! @param [in,out] doc XML document.
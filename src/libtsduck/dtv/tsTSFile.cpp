@@ -33,6 +33,10 @@
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TSFile::DIRECT_IO_ALIGNMENT;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Default constructor.
@@ -51,6 +55,8 @@ ts::TSFile::TSFile() :
     _aborted(false),
     _rewindable(false),
     _regular(false),
+    _direct(false),
+    _preallocated(false),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
@@ -77,6 +83,8 @@ ts::TSFile::TSFile(const TSFile& other) :
     _aborted(false),
     _rewindable(false),
     _regular(false),
+    _direct(false),
+    _preallocated(false),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
@@ -103,6 +111,8 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _aborted(other._aborted),
     _rewindable(other._rewindable),
     _regular(other._regular),
+    _direct(other._direct),
+    _preallocated(other._preallocated),
 #if defined(TS_WINDOWS)
     _handle(other._handle)
 #else
@@ -365,24 +375,48 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         uflags |= O_EXCL;
     }
 
+#if defined(TS_LINUX)
+    // Direct I/O is used for write-only named files.
+    _direct = write_access && !read_access && (_flags & DIRECT) != 0 && !_filename.empty();
+    if (_direct) {
+        uflags |= O_DIRECT;
+    }
+#else
+    _direct = false;
+#endif
+
     if (_filename.empty()) {
         // File name is empty means standard input or output. No need to open.
         _fd = read_access ? STDIN_FILENO : STDOUT_FILENO;
     }
     else {
         // Open a named file.
-        if ((_fd = ::open(_filename.toUTF8().c_str(), uflags, mode)) < 0) {
+        _fd = ::open(_filename.toUTF8().c_str(), uflags, mode);
+#if defined(TS_LINUX)
+        // Some file systems (eg. tmpfs) do not support direct I/O, use cached I/O.
+        if (_fd < 0 && _direct && LastErrorCode() == EINVAL) {
+            report.debug(u"direct I/O not supported on %s", {getDisplayFileName()});
+            _direct = false;
+            _fd = ::open(_filename.toUTF8().c_str(), uflags & ~O_DIRECT, mode);
+        }
+#endif
+        if (_fd < 0) {
             const ErrorCode err = LastErrorCode();
             report.log(_severity, u"cannot open file %s: %s", {getDisplayFileName(), ErrorCodeMessage(err)});
             return false;
         }
         // Move to end of file if --append.
-        if (append_access && ::lseek(_fd, 0, SEEK_END) == off_t(-1)) {
+        const off_t end = append_access ? ::lseek(_fd, 0, SEEK_END) : 0;
+        if (end == off_t(-1)) {
             const ErrorCode err = LastErrorCode();
             report.log (_severity, u"error seeking at end of file %s: %s", {getDisplayFileName(), ErrorCodeMessage(err)});
             ::close(_fd);
             return false;
         }
+        // Direct I/O requires aligned file offsets.
+        if (_direct && end % DIRECT_IO_ALIGNMENT != 0) {
+            disableDirectIO(report);
+        }
         if (temporary) {
             // Immediately delete the file. It is removed from the directory.
             // It remains accessible as long as the file is open and is deleted on close.
@@ -402,6 +436,12 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
     }
     _regular = S_ISREG(st.st_mode);
 
+    // When standard input or output is a pipe, enlarge the pipe buffer to reduce
+    // context switches with the other process (eg. "tsp ... | tsp ...").
+    if (_filename.empty() && S_ISFIFO(st.st_mode)) {
+        SetPipeSize(_fd, DEFAULT_PIPE_SIZE, report);
+    }
+
     // Check if seek is required or possible.
     if (!seekCheck(report)) {
         if (!_filename.empty()) {
@@ -525,11 +565,17 @@ bool ts::TSFile::close(Report& report)
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
 #else
+        // Release unused preallocated disk space after end of file.
+        const off_t end = _preallocated ? ::lseek(_fd, 0, SEEK_CUR) : off_t(-1);
+        if (end != off_t(-1) && ::ftruncate(_fd, end) < 0) {
+            const ErrorCode err = LastErrorCode();
+            report.log(_severity, u"error truncating %s: %s", {getDisplayFileName(), ErrorCodeMessage(err)});
+        }
         ::close(_fd);
 #endif
     }
 
-    _is_open = _at_eof = _aborted = false;
+    _is_open = _at_eof = _aborted = _direct = _preallocated = false;
     _total_read = _total_write = 0;
     _flags = NONE;
     _filename.clear();
@@ -703,6 +749,12 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
     size_t remain = data_size;
     ssize_t outsize = 0;
 
+    // Direct I/O requires aligned addresses and sizes. Revert to cached I/O on the first
+    // unaligned write. After that, the file offset is no longer aligned anyway.
+    if (_direct && (size_t(data) % DIRECT_IO_ALIGNMENT != 0 || data_size % DIRECT_IO_ALIGNMENT != 0)) {
+        disableDirectIO(report);
+    }
+
     // Loop on write until everything is gone
     while (remain > 0) {
         outsize = ::write(_fd, data, remain);
@@ -712,8 +764,16 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
             data += outsize;
             remain -= outsize;
             written_size += size_t(outsize);
+            // A partial direct write leaves an unaligned remainder.
+            if (_direct && remain > 0) {
+                disableDirectIO(report);
+            }
+        }
+        else if ((error_code = LastErrorCode()) == EINVAL && _direct) {
+            // Direct I/O rejected by the underlying device, retry with cached I/O.
+            disableDirectIO(report);
         }
-        else if ((error_code = LastErrorCode()) != EINTR) {
+        else if (error_code != EINTR) {
             // Actual error (not an interrupt)
             // Don't report error on broken pipe.
             if (error_code != EPIPE) {
@@ -728,6 +788,56 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 }
 
 
+//----------------------------------------------------------------------------
+// Disable direct I/O on the file, if currently used.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::disableDirectIO(Report& report)
+{
+#if defined(TS_LINUX)
+    if (_direct) {
+        const int flags = ::fcntl(_fd, F_GETFL);
+        if (flags == -1 || ::fcntl(_fd, F_SETFL, flags & ~O_DIRECT) == -1) {
+            const ErrorCode err = LastErrorCode();
+            report.debug(u"error disabling direct I/O on %s: %s", {getDisplayFileName(), ErrorCodeMessage(err)});
+        }
+    }
+#endif
+    _direct = false;
+}
+
+
+//----------------------------------------------------------------------------
+// Preallocate disk space in a file which is open for write.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::preallocate(uint64_t offset, uint64_t size, Report& report)
+{
+    if (!_is_open || (_flags & WRITE) == 0) {
+        report.log(_severity, u"file %s not open for write", {getDisplayFileName()});
+        return false;
+    }
+
+#if defined(TS_LINUX)
+    // Keep the logical size of the file, only allocate disk blocks.
+    if (_regular && size > 0) {
+        if (::fallocate(_fd, FALLOC_FL_KEEP_SIZE, off_t(offset), off_t(size)) == 0) {
+            _preallocated = true;
+        }
+        else {
+            const ErrorCode err = LastErrorCode();
+            if (err != EOPNOTSUPP && err != ENOSYS) {
+                report.log(_severity, u"error preallocating %'d bytes in %s: %s", {size, getDisplayFileName(), ErrorCodeMessage(err)});
+                return false;
+            }
+        }
+    }
+#endif
+
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Abort any currenly read/write operation in progress.
 //----------------------------------------------------------------------------
@@ -120,8 +120,16 @@ namespace ts {
             TEMPORARY   = 0x0020,   //!< Temporary file, deleted on close, not always visible in the file system.
             REOPEN      = 0x0040,   //!< Close and reopen the file instead of rewind to start of file when looping on input file.
             REOPEN_SPEC = 0x0080,   //!< Force REOPEN when the file is not a regular file.
+            DIRECT      = 0x0100,   //!< Write using direct I/O, bypassing the system cache. Linux only, ignored otherwise.
         };
 
+        //!
+        //! Required alignment of memory addresses, sizes and file offsets for direct I/O.
+        //! With the open flag DIRECT, the first unaligned write operation reverts the file
+        //! to cached I/O. The last write operation of a file is typically unaligned.
+        //!
+        static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
         //!
         //! Open or create the file (generic form).
         //! The file is rewindable if the underlying file is seekable, eg. not a pipe.
@@ -160,6 +168,20 @@ namespace ts {
         //!
         bool close(Report& report);
 
+        //!
+        //! Preallocate disk space in a file which is open for write.
+        //! The logical size of the file is not modified. Preallocating large chunks
+        //! of disk space in advance reduces fragmentation and metadata updates during
+        //! long recordings. Unused preallocated space is released when the file is closed.
+        //! Currently implemented on Linux only, always successful on other systems or
+        //! when the file system does not support preallocation.
+        //! @param [in] offset Byte offset of the area to preallocate.
+        //! @param [in] size Size in bytes of the area to preallocate.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool preallocate(uint64_t offset, uint64_t size, Report& report);
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -209,6 +231,8 @@ namespace ts {
         volatile bool _aborted;        //!< Operation has been aborted, no operation available
         bool          _rewindable;     //!< Opened in rewindable mode
         bool          _regular;        //!< Is a regular file (ie. not a pipe or special device)
+        bool          _direct;         //!< Direct I/O is currently used
+        bool          _preallocated;   //!< Disk space was preallocated beyond end of file
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle;         //!< File handle
 #else
@@ -220,6 +244,12 @@ namespace ts {
         bool seekCheck(Report& report);
         bool seekInternal(uint64_t index, Report& report);
 
+        // Disable direct I/O on the file, if currently used.
+        void disableDirectIO(Report& report);
+
+        // The asynchronous writer directly writes formatted data.
+        friend class TSFileOutputAsync;
+
         // Inaccessible operations.
         TSFile& operator=(TSFile&) = delete;
         TSFile& operator=(TSFile&&) = delete;
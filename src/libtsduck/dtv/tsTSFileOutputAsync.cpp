@@ -0,0 +1,406 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileOutputAsync.h"
+#include "tsGuardCondition.h"
+#include "tsIntegerUtils.h"
+#include "tsNullReport.h"
+#include "tsSysUtils.h"
+#include "tsTime.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TSFileOutputAsync::DEFAULT_BUFFER_SIZE;
+constexpr size_t ts::TSFileOutputAsync::DEFAULT_QUEUE_DEPTH;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TSFileOutputAsync::TSFileOutputAsync() :
+    TSPacketStream(TSPacketFormat::TS, nullptr, this),
+    Thread(),
+    _buffer_size(DEFAULT_BUFFER_SIZE),
+    _queue_depth(DEFAULT_QUEUE_DEPTH),
+    _prealloc(0),
+    _max_size(0),
+    _max_duration(0),
+    _report(&NULLREP),
+    _filename(),
+    _flags(TSFile::NONE),
+    _is_open(false),
+    _memory(),
+    _base(nullptr),
+    _mutex(),
+    _todo(),
+    _done(),
+    _queue(),
+    _free(),
+    _terminate(false),
+    _error(false),
+    _current(NPOS),
+    _fill(0),
+    _rotate_next(false),
+    _file_bytes(0),
+    _file_start(),
+    _file(),
+    _last_name(),
+    _written(0),
+    _allocated(0)
+{
+}
+
+ts::TSFileOutputAsync::~TSFileOutputAsync()
+{
+    if (_is_open) {
+        close(NULLREP);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Configuration.
+//----------------------------------------------------------------------------
+
+void ts::TSFileOutputAsync::setBufferSize(size_t size)
+{
+    _buffer_size = RoundUp(std::max<size_t>(size, 1), TSFile::DIRECT_IO_ALIGNMENT);
+}
+
+void ts::TSFileOutputAsync::setQueueDepth(size_t count)
+{
+    _queue_depth = std::max<size_t>(count, 2);
+}
+
+
+//----------------------------------------------------------------------------
+// Open the file and start the writer thread.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::open(const UString& filename, TSFile::OpenFlags flags, Report& report, TSPacketFormat format)
+{
+    if (_is_open) {
+        report.error(u"already open");
+        return false;
+    }
+    else if ((flags & TSFile::READ) != 0) {
+        report.error(u"read access not allowed on asynchronous output file");
+        return false;
+    }
+    else if (filename.empty() && (_max_size > 0 || _max_duration > 0)) {
+        report.error(u"file rotation not allowed on standard output");
+        return false;
+    }
+
+    _report = &report;
+    _filename = filename;
+    _flags = flags | TSFile::WRITE;
+    _last_name.clear();
+
+    // Allocate all buffers in one block, the first buffer is aligned for direct I/O.
+    _memory.resize(_queue_depth * _buffer_size + TSFile::DIRECT_IO_ALIGNMENT);
+    _base = _memory.data() + (TSFile::DIRECT_IO_ALIGNMENT - size_t(_memory.data()) % TSFile::DIRECT_IO_ALIGNMENT) % TSFile::DIRECT_IO_ALIGNMENT;
+
+    _queue.clear();
+    _free.clear();
+    for (size_t i = 0; i < _queue_depth; ++i) {
+        _free.push_back(i);
+    }
+    _terminate = _error = false;
+    _current = NPOS;
+    _fill = 0;
+    _rotate_next = false;
+    _file_bytes = 0;
+    _file_start.getSystemTime();
+
+    // Open the first file in the context of the application to report errors immediately.
+    resetPacketStream(format, nullptr, this);
+    if (!openFile()) {
+        return false;
+    }
+    if (!start()) {
+        report.error(u"cannot start writer thread for %s", {_file.getDisplayFileName()});
+        _file.close(NULLREP);
+        return false;
+    }
+    _is_open = true;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Flush all buffers, stop the writer thread and close the file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::close(Report& report)
+{
+    if (!_is_open) {
+        report.error(u"not open");
+        return false;
+    }
+
+    // Push the last partial buffer and wait for the writer thread to write all chunks.
+    if (_current != NPOS) {
+        pushBuffer();
+    }
+    {
+        GuardCondition lock(_mutex, _todo);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+
+    bool ok = !_error;
+    if (_file.isOpen()) {
+        ok = _file.close(report) && ok;
+    }
+    _is_open = false;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Write packets, rotate files when necessary.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report)
+{
+    if (!_is_open) {
+        report.error(u"file not open");
+        return false;
+    }
+
+    bool ok = !_error;
+    while (ok && packet_count > 0) {
+
+        // Time-based rotation is checked once per call.
+        if (_max_duration > 0 && _file_bytes > 0 && Monotonic(true) - _file_start >= _max_duration * NanoSecPerMilliSec) {
+            rotate();
+        }
+
+        // Size-based rotation is checked on each packet boundary.
+        size_t count = packet_count;
+        if (_max_size > 0) {
+            const uint64_t pkt_size = PKT_SIZE + packetHeaderSize() + packetTrailerSize();
+            if (_file_bytes > 0 && _file_bytes + pkt_size > _max_size) {
+                rotate();
+            }
+            // Always write at least one packet per file.
+            const uint64_t remain = _file_bytes < _max_size ? (_max_size - _file_bytes) / pkt_size : 0;
+            count = size_t(std::max<uint64_t>(1, std::min<uint64_t>(count, remain)));
+        }
+
+        ok = TSPacketStream::writePackets(buffer, metadata, count, report);
+        buffer += count;
+        if (metadata != nullptr) {
+            metadata += count;
+        }
+        packet_count -= count;
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Start a new file with the next packet.
+//----------------------------------------------------------------------------
+
+void ts::TSFileOutputAsync::rotate()
+{
+    // The current partial buffer belongs to the previous file.
+    if (_current != NPOS) {
+        pushBuffer();
+    }
+    _rotate_next = true;
+    _file_bytes = 0;
+    _file_start.getSystemTime();
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of AbstractWriteStreamInterface: copy data in buffers.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::writeStream(const void* addr, size_t size, size_t& written_size, Report& report)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+    written_size = 0;
+
+    while (size > 0) {
+        if (_current == NPOS && !getBuffer()) {
+            return false;
+        }
+        const size_t count = std::min(size, _buffer_size - _fill);
+        ::memcpy(_base + _current * _buffer_size + _fill, data, count);
+        data += count;
+        size -= count;
+        _fill += count;
+        _file_bytes += count;
+        written_size += count;
+        if (_fill >= _buffer_size) {
+            pushBuffer();
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a free buffer, wait for one if necessary.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::getBuffer()
+{
+    GuardCondition lock(_mutex, _done);
+    while (_free.empty() && !_error) {
+        lock.waitCondition();
+    }
+    if (_error) {
+        return false;
+    }
+    _current = _free.back();
+    _free.pop_back();
+    _fill = 0;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Push the current buffer into the write queue.
+//----------------------------------------------------------------------------
+
+void ts::TSFileOutputAsync::pushBuffer()
+{
+    GuardCondition lock(_mutex, _todo);
+    _queue.push_back({_current, _fill, _rotate_next});
+    lock.signal();
+    _rotate_next = false;
+    _current = NPOS;
+    _fill = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer thread.
+//----------------------------------------------------------------------------
+
+void ts::TSFileOutputAsync::main()
+{
+    for (;;) {
+
+        // Wait for a chunk to write.
+        Chunk chunk;
+        {
+            GuardCondition lock(_mutex, _todo);
+            while (_queue.empty() && !_terminate) {
+                lock.waitCondition();
+            }
+            if (_queue.empty()) {
+                // Terminate only when all chunks are written.
+                break;
+            }
+            chunk = _queue.front();
+            _queue.pop_front();
+        }
+
+        // Write the chunk outside the mutex. After an error, continue to release
+        // the chunks without writing them, until the application stops.
+        bool ok = !_error;
+        if (ok && chunk.rotate) {
+            ok = _file.close(*_report) && openFile();
+        }
+        if (ok) {
+            ok = writeChunk(chunk);
+        }
+
+        // Release the buffer.
+        {
+            GuardCondition lock(_mutex, _done);
+            _free.push_back(chunk.index);
+            if (!ok) {
+                _error = true;
+            }
+            lock.signal();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Open the next output file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::openFile()
+{
+    UString name(_filename);
+
+    // With file rotation, build a unique time-stamped file name.
+    if (_max_size > 0 || _max_duration > 0) {
+        const Time::Fields now(Time::CurrentLocalTime());
+        const UString prefix(UString::Format(u"%s-%04d%02d%02d-%02d%02d%02d", {PathPrefix(_filename), now.year, now.month, now.day, now.hour, now.minute, now.second}));
+        const UString suffix(PathSuffix(_filename));
+        name = prefix + suffix;
+        for (int i = 1; name == _last_name || ((_flags & TSFile::APPEND) == 0 && FileExists(name)); ++i) {
+            name = UString::Format(u"%s-%d%s", {prefix, i, suffix});
+        }
+    }
+
+    // In append mode, preallocation starts after the end of the existing file.
+    _written = (_flags & TSFile::APPEND) != 0 && !name.empty() && FileExists(name) ? uint64_t(std::max<int64_t>(0, GetFileSize(name))) : 0;
+    _allocated = _written;
+    _last_name = name;
+
+    _report->debug(u"creating %s", {name});
+    return _file.open(name, _flags, *_report, TSPacketFormat::TS);
+}
+
+
+//----------------------------------------------------------------------------
+// Write a chunk into the current file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::writeChunk(const Chunk& chunk)
+{
+    // Preallocate the next chunk of disk space when necessary.
+    if (_prealloc > 0 && _written + chunk.size > _allocated) {
+        const uint64_t size = std::max<uint64_t>(_prealloc, chunk.size);
+        if (!_file.preallocate(_written, size, *_report)) {
+            return false;
+        }
+        _allocated = _written + size;
+    }
+
+    // Partial buffers are flushed only at end of file, where direct I/O is no longer needed.
+    size_t written = 0;
+    const bool ok = _file.writeStream(_base + chunk.index * _buffer_size, chunk.size, written, *_report);
+    _written += written;
+    return ok;
+}
@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream output file with asynchronous write and file rotation.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSFile.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsMonotonic.h"
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! Transport stream output file with asynchronous write and file rotation.
+    //! @ingroup mpeg
+    //!
+    //! Packets are formatted into a queue of large memory buffers. A background thread
+    //! writes the filled buffers into the file. Thus, the application is never blocked
+    //! by disk I/O, unless all buffers are full. The buffers are aligned for direct I/O
+    //! and disk space can be preallocated in large chunks.
+    //!
+    //! Optionally, the output file is closed and a new one is created when a maximum
+    //! size or duration is reached. The rotation is performed by the writer thread,
+    //! always on packet boundaries. In that case, the name of each file is built from
+    //! the specified file name with a "-YYYYMMDD-hhmmss" suffix before the extension,
+    //! based on the local time of creation of the file.
+    //!
+    //! The packet stream methods and open() / close() shall be called from the same
+    //! thread. Errors from the writer thread are reported on the Report object which
+    //! is given to open(). This object must be thread-safe.
+    //!
+    class TSDUCKDLL TSFileOutputAsync: public TSPacketStream, private AbstractWriteStreamInterface, private Thread
+    {
+        TS_NOCOPY(TSFileOutputAsync);
+    public:
+        //!
+        //! Default size in bytes of each buffer.
+        //!
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 1024 * TSFile::DIRECT_IO_ALIGNMENT;
+
+        //!
+        //! Default number of buffers.
+        //!
+        static constexpr size_t DEFAULT_QUEUE_DEPTH = 8;
+
+        //!
+        //! Default constructor.
+        //!
+        TSFileOutputAsync();
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~TSFileOutputAsync() override;
+
+        //!
+        //! Set the size of each buffer. Must be called before open().
+        //! @param [in] size Size in bytes of each buffer. It is rounded up to the direct I/O alignment.
+        //!
+        void setBufferSize(size_t size);
+
+        //!
+        //! Set the number of buffers. Must be called before open().
+        //! @param [in] count Number of buffers, at least 2.
+        //!
+        void setQueueDepth(size_t count);
+
+        //!
+        //! Set the disk space preallocation. Must be called before open().
+        //! @param [in] size Size in bytes of each preallocated chunk of disk space. Zero means no preallocation.
+        //!
+        void setPreallocation(uint64_t size) { _prealloc = size; }
+
+        //!
+        //! Set the maximum size of each file. Must be called before open().
+        //! @param [in] size Maximum size in bytes of each file. Zero means unlimited.
+        //!
+        void setMaxFileSize(uint64_t size) { _max_size = size; }
+
+        //!
+        //! Set the maximum duration of each file. Must be called before open().
+        //! @param [in] duration Maximum duration in milliseconds of each file. Zero means unlimited.
+        //!
+        void setMaxFileDuration(MilliSecond duration) { _max_duration = duration; }
+
+        //!
+        //! Open or create the output file and start the writer thread.
+        //! @param [in] filename File name. If empty, use standard output. File rotation requires a file name.
+        //! @param [in] flags Bit mask of open flags. WRITE is implicit, READ is not allowed.
+        //! @param [in,out] report Where to report errors. Also used by the writer thread.
+        //! @param [in] format Format of the TS file.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& filename, TSFile::OpenFlags flags, Report& report, TSPacketFormat format = TSPacketFormat::TS);
+
+        //!
+        //! Check if the file is open.
+        //! @return True if the file is open.
+        //!
+        bool isOpen() const { return _is_open; }
+
+        //!
+        //! Flush all buffers, stop the writer thread and close the file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false if an error occured, either now or previously in the writer thread.
+        //!
+        bool close(Report& report);
+
+        // Override TSPacketStream implementation.
+        virtual bool writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report) override;
+
+    private:
+        // A filled buffer in the write queue.
+        struct Chunk
+        {
+            size_t index;   // Buffer index.
+            size_t size;    // Size in bytes of data in buffer.
+            bool   rotate;  // Start a new file before writing this chunk.
+        };
+
+        // Configuration, set before open.
+        size_t              _buffer_size;
+        size_t              _queue_depth;
+        uint64_t            _prealloc;
+        uint64_t            _max_size;
+        MilliSecond         _max_duration;
+
+        // Common state, set at open.
+        Report*             _report;
+        UString             _filename;      // File name as specified by the application.
+        TSFile::OpenFlags   _flags;
+        volatile bool       _is_open;
+        ByteBlock           _memory;        // Memory of all buffers.
+        uint8_t*            _base;          // Address of first buffer, aligned for direct I/O.
+
+        // Shared between the application and the writer thread, protected by the mutex.
+        Mutex               _mutex;
+        Condition           _todo;          // Signaled when a chunk is queued or on termination.
+        Condition           _done;          // Signaled when a buffer is released by the writer thread.
+        std::deque<Chunk>   _queue;         // Chunks to write.
+        std::vector<size_t> _free;          // Indexes of free buffers.
+        volatile bool       _terminate;     // Request the writer thread to terminate.
+        volatile bool       _error;         // The writer thread got an error.
+
+        // Application side.
+        size_t              _current;       // Index of buffer being filled, NPOS if none.
+        size_t              _fill;          // Size of data in current buffer.
+        bool                _rotate_next;   // Next pushed chunk starts a new file.
+        uint64_t            _file_bytes;    // Bytes in current file.
+        Monotonic           _file_start;    // Start time of current file.
+
+        // Writer thread side.
+        TSFile              _file;          // Current output file.
+        UString             _last_name;     // Name of last created file.
+        uint64_t            _written;       // Size in bytes of current file.
+        uint64_t            _allocated;     // End of preallocated disk space in current file.
+
+        // Open the next output file.
+        bool openFile();
+
+        // Write a chunk into the current file.
+        bool writeChunk(const Chunk& chunk);
+
+        // Get a free buffer, wait for one if necessary.
+        bool getBuffer();
+
+        // Push the current buffer into the write queue.
+        void pushBuffer();
+
+        // Start a new file with the next packet.
+        void rotate();
+
+        // Implementation of AbstractWriteStreamInterface.
+        virtual bool writeStream(const void* addr, size_t size, size_t& written_size, Report& report) override;
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+}
@@ -91,9 +91,7 @@ bool ts::TSFileOutputResync::writePackets(const TSPacket* buffer, const TSPacket
 bool ts::TSFileOutputResync::writePackets(TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report)
 {
     // Update continuity counters
-    for (size_t n = 0; n < packet_count; ++n) {
-        _ccFixer.feedPacket(buffer[n]);
-    }
+    _ccFixer.feedPackets(buffer, packet_count);
 
     // Invoke superclass
     return TSFile::writePackets(buffer, metadata, packet_count, report);
@@ -1060,7 +1060,7 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
         if (flags & DUMP_TS_HEADER) {
             strm << UString::Format(u"PID: 0x%X, PUSI: %d, ", {getPID(), getPUSI()});
         }
-        strm << UString::Dump(display_data, display_size, flags & 0x0000FFFF) << std::endl;
+        UString::Dump(strm, display_data, display_size, flags & 0x0000FFFF) << std::endl;
         return strm;
     }
 
@@ -1139,7 +1139,7 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
             strm << margin << "---- TS Packet Payload (" << payload_size << " bytes) ----" << std::endl;
         }
         // The 16 LSB contains flags for Hexa.
-        strm << UString::Dump(display_data, display_size, flags & 0x0000FFFF, indent);
+        UString::Dump(strm, display_data, display_size, flags & 0x0000FFFF, indent);
     }
 
     return strm;
@@ -143,7 +143,7 @@ void ts::TablesDisplay::displayExtraData(const void* data, size_t size, const US
     std::ostream& strm(_duck.out());
     if (size > 0) {
         strm << margin << "Extraneous " << size << " bytes:" << std::endl;
-        strm << UString::Dump(data, size, UString::HEXA | UString::ASCII | UString::OFFSET, margin.size());
+        UString::Dump(strm, data, size, UString::HEXA | UString::ASCII | UString::OFFSET, margin.size());
     }
 }
 
@@ -158,7 +158,7 @@ void ts::TablesDisplay::displayPrivateData(const UString& title, const void* dat
 
     if (size > single_line_max) {
         strm << margin << title << " (" << size << " bytes):" << std::endl;
-        strm << UString::Dump(data, size, UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
+        UString::Dump(strm, data, size, UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
     }
     else if (size > 0) {
         strm << margin << title << " (" << size << " bytes): " << UString::Dump(data, size, UString::SINGLE_LINE) << std::endl;
@@ -30,6 +30,7 @@
 #include "tsTablesLogger.h"
 #include "tsTablesLoggerFilterRepository.h"
 #include "tsBinaryTable.h"
+#include "tsCRC32.h"
 #include "tsPAT.h"
 #include "tstlv.h"
 #include "tsTime.h"
@@ -76,6 +77,8 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _logger(false),
     _log_size(DEFAULT_LOG_SIZE),
     _no_duplicate(false),
+    _only_changes(false),
+    _count_repetitions(false),
     _pack_all_sections(false),
     _pack_and_flush(false),
     _fill_eit(false),
@@ -100,7 +103,8 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _shortSections(),
     _allSections(),
     _sectionsOnce(),
-    _section_filters()
+    _section_filters(),
+    _last_logged()
 {
     // Create an instance of each registered section filter.
     TablesLoggerFilterRepository::Instance()->createFilters(_section_filters);
@@ -149,6 +153,15 @@ void ts::TablesLogger::defineArgs(Args& args) const
               u"Save sections in the specified binary output file. "
               u"See also option -m, --multiple-files.");
 
+    args.option(u"count-repetitions");
+    args.help(u"count-repetitions",
+              u"Count the occurrences of all sections, including repetitions of identical "
+              u"sections which are not logged, and display a summary at the end. The summary "
+              u"indicates, for each combination of PID, table id, table id extension and "
+              u"section number, the number of occurrences of the section and the number of "
+              u"changes in its content. The sections are counted by the demux on the binary "
+              u"sections, their CRC32 is not checked. See also --only-changes.");
+
     args.option(u"fill-eit");
     args.help(u"fill-eit",
               u"Before exiting, add missing empty sections in EIT's and flush them. "
@@ -215,6 +228,19 @@ void ts::TablesLogger::defineArgs(Args& args) const
               u"With --ip-udp, send the tables as raw binary messages in UDP packets. "
               u"By default, the tables are formatted into TLV messages.");
 
+    args.option(u"only-changes");
+    args.help(u"only-changes",
+              u"Do not log sections or tables which are identical to the last logged ones with "
+              u"the same PID, table id, table id extension and section number. The content of "
+              u"sections is identified by their size and CRC32. With long sections, the CRC32 "
+              u"is already present in the section and is not recomputed. With --all-sections, "
+              u"identical repetitions are detected by the demux on the binary sections and are "
+              u"skipped before any other processing, including the CRC32 check. Without "
+              u"--all-sections, the check is applied on complete tables, after the demux. "
+              u"Unlike --no-duplicate, this option applies to all sections, not only short "
+              u"sections. This can be useful with --all-sections on long captures, where the "
+              u"same sections are repeated again and again.");
+
     args.option(u"output-file", 'o', Args::STRING);
     args.help(u"output-file", u"",
               u"Save the tables or sections in human-readable text format in the specified "
@@ -325,6 +351,8 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     _logger = args.present(u"log");
     _log_size = args.intValue<size_t>(u"log-size", DEFAULT_LOG_SIZE);
     _no_duplicate = args.present(u"no-duplicate");
+    _only_changes = args.present(u"only-changes");
+    _count_repetitions = args.present(u"count-repetitions");
     _udp_raw = args.present(u"no-encapsulation");
     _use_current = !args.present(u"exclude-current");
     _use_next = args.present(u"include-next");
@@ -368,6 +396,7 @@ bool ts::TablesLogger::open()
     _shortSections.clear();
     _allSections.clear();
     _sectionsOnce.clear();
+    _last_logged.clear();
 
     if (_binfile.is_open()) {
         _binfile.close();
@@ -389,6 +418,10 @@ bool ts::TablesLogger::open()
         _demux.setSectionHandler(nullptr);
     }
 
+    // Repetitions of sections are counted by the demux. With --all-sections, the identical
+    // repetitions are also skipped by the demux, on binary sections, without building a Section.
+    _demux.trackRepetitions(_count_repetitions, _only_changes && _all_sections);
+
     // Type of sections to get.
     _demux.setCurrentNext(_use_current, _use_next);
     _cas_mapper.setCurrentNext(_use_current, _use_next);
@@ -448,6 +481,11 @@ void ts::TablesLogger::close()
             _demux.fillAndFlushEITs();
         }
 
+        // Report repetitions of sections if required.
+        if (_count_repetitions) {
+            reportRepetitions();
+        }
+
         // Close files and documents.
         closeXML();
         if (_binfile.is_open()) {
@@ -492,6 +530,18 @@ void ts::TablesLogger::handleTable(SectionDemux&, const BinaryTable& table)
     const PID pid = table.sourcePID();
     const uint16_t cas = _cas_mapper.casId(table.sourcePID());
 
+    // Ignore table if all sections are identical to the last logged ones, before any other processing.
+    if (_only_changes) {
+        bool changed = false;
+        for (size_t i = 0; i < table.sectionCount(); ++i) {
+            // Always check all sections to update the last logged ones.
+            changed = !isRepetition(*table.sectionAt(i)) || changed;
+        }
+        if (!changed) {
+            return;
+        }
+    }
+
     // Ignore table if not to be filtered. Keep the table if at least one section shall be kept.
     bool keep = false;
     for (size_t i = 0; !keep && i < table.sectionCount(); ++i) {
@@ -575,15 +625,12 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
     const PID pid = sect.sourcePID();
     const uint16_t cas = _cas_mapper.casId(sect.sourcePID());
 
+    // With option --only-changes, identical repetitions were already skipped by the demux.
+
     // With option --all-once, track duplicate PID/TID/TDIext/secnum/version.
     if (_all_once) {
         // Pack PID/TID/TDIext/secnum/version into one single 64-bit integer.
-        const uint64_t id =
-            (uint64_t(pid) << 40) |
-            (uint64_t(sect.tableId()) << 32) |
-            (uint64_t(sect.tableIdExtension()) << 16) |
-            (uint64_t(sect.sectionNumber()) << 8) |
-            uint64_t(sect.version());
+        const uint64_t id = SectionIndex(sect) | uint64_t(sect.version());
         if (_sectionsOnce.count(id) != 0) {
             // Already found this one, give up.
             return;
@@ -667,6 +714,69 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
 }
 
 
+//----------------------------------------------------------------------------
+// Tracking of identical sections.
+//----------------------------------------------------------------------------
+
+uint64_t ts::TablesLogger::SectionIndex(const Section& sect)
+{
+    return (uint64_t(sect.sourcePID()) << 40) |
+           (uint64_t(sect.tableId()) << 32) |
+           (uint64_t(sect.tableIdExtension()) << 16) |
+           (uint64_t(sect.sectionNumber()) << 8);
+}
+
+ts::TablesLogger::ContentId ts::TablesLogger::GetContentId(const Section& sect)
+{
+    // Long sections end with a CRC32 which was already checked by the demux, don't recompute it.
+    // Short sections have no CRC32, compute one.
+    if (sect.isLongSection() && sect.size() >= 4) {
+        return ContentId(sect.size(), GetUInt32(sect.content() + sect.size() - 4));
+    }
+    else {
+        return ContentId(sect.size(), CRC32(sect.content(), sect.size()).value());
+    }
+}
+
+bool ts::TablesLogger::isRepetition(const Section& sect)
+{
+    const ContentId id(GetContentId(sect));
+    ContentId& logged(_last_logged[SectionIndex(sect)]);
+    if (id == logged) {
+        return true;
+    }
+    else {
+        logged = id;
+        return false;
+    }
+}
+
+void ts::TablesLogger::reportRepetitions()
+{
+    // The repetitions are counted by the demux on binary sections.
+    const SectionDemux::RepetitionsMap& reps(_demux.repetitions());
+
+    // Display in the text output, if there is one, as a log otherwise.
+    UStringList lines;
+    lines.push_back(u"Repetitions of sections:");
+    for (auto it = reps.begin(); it != reps.end(); ++it) {
+        if (it->second.occurrences > 0) {
+            lines.push_back(UString::Format(u"  PID 0x%04X, TID 0x%02X, TIDext 0x%04X, section %3d: %'d occurrences, %'d changes",
+                                            {(it->first >> 40) & 0x1FFF, (it->first >> 32) & 0xFF, (it->first >> 16) & 0xFFFF, (it->first >> 8) & 0xFF,
+                                             it->second.occurrences, it->second.changes}));
+        }
+    }
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+        if (_use_text) {
+            _display.out() << *it << std::endl;
+        }
+        else {
+            _report.info(*it);
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Send UDP table and section.
 //----------------------------------------------------------------------------
@@ -167,6 +167,8 @@ namespace ts {
         bool                     _logger;            // Table logger.
         size_t                   _log_size;          // Size of table to log.
         bool                     _no_duplicate;      // Exclude duplicated short sections on a PID.
+        bool                     _only_changes;      // Exclude sections which are identical to the last logged one.
+        bool                     _count_repetitions; // Count repetitions of identical sections.
         bool                     _pack_all_sections; // Pack all sections as if they were one table.
         bool                     _pack_and_flush;    // Pack and flush incomplete tables before exiting.
         bool                     _fill_eit;          // Add missing empty sections to incomplete EIT's before exiting.
@@ -195,6 +197,25 @@ namespace ts {
         std::set<uint64_t>       _sectionsOnce;      // Tracking sets of PID/TID/TDIext/secnum/version with --all-once.
         TablesLoggerFilterVector _section_filters;   // All registered section filters.
 
+        // Identification of the content of a section: size and CRC32.
+        typedef std::pair<size_t, uint32_t> ContentId;
+
+        // Content of the last logged sections per PID/TID/TDIext/secnum (--only-changes without --all-sections).
+        std::map<uint64_t, ContentId> _last_logged;
+
+        // Pack PID/TID/TDIext/secnum of a section into one single 64-bit integer (version in lowest byte is zero).
+        static uint64_t SectionIndex(const Section& section);
+
+        // Get the content identification of a section, without deserialization.
+        static ContentId GetContentId(const Section& section);
+
+        // Check if a section is identical to the last logged one with the same PID/TID/TDIext/secnum.
+        // If not, the section becomes the last logged one.
+        bool isRepetition(const Section& section);
+
+        // Report the repetitions of sections (option --count-repetitions).
+        void reportRepetitions();
+
         // Create a binary file. On error, set _abort and return false.
         bool createBinaryFile(const UString& name);
 
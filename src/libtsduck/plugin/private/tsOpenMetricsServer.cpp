@@ -0,0 +1,228 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsOpenMetricsServer.h"
+#include "tsNullMutex.h"
+#include "tsNullReport.h"
+#include "tsReportBuffer.h"
+TSDUCK_SOURCE;
+
+// Reception timeout of HTTP requests.
+#define METRICS_TIMEOUT 5000  // milliseconds
+
+const ts::UString ts::OpenMetricsServer::CONTENT_TYPE(u"application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::OpenMetricsServer::OpenMetricsServer(const SocketAddress& address, Report& log) :
+    _is_open(false),
+    _terminate(false),
+    _address(address),
+    _log(log, u"metrics server: "),
+    _server()
+{
+}
+
+ts::OpenMetricsServer::~OpenMetricsServer()
+{
+    // Terminate the thread and wait for actual thread termination.
+    close();
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Start/stop the HTTP server.
+//----------------------------------------------------------------------------
+
+bool ts::OpenMetricsServer::open()
+{
+    if (!_address.hasPort()) {
+        // No metrics server, do nothing.
+        return true;
+    }
+    else if (_is_open) {
+        _log.error(u"metrics server already started");
+        return false;
+    }
+    else {
+        // Open the TCP server.
+        if (!_server.open(_log) ||
+            !_server.reusePort(true, _log) ||
+            !_server.bind(_address, _log) ||
+            !_server.listen(5, _log))
+        {
+            _server.close(NULLREP);
+            _log.error(u"error starting TCP server for metrics");
+            return false;
+        }
+
+        // Start the thread.
+        _is_open = true;
+        return start();
+    }
+}
+
+void ts::OpenMetricsServer::close()
+{
+    if (_is_open) {
+        // Close the TCP server. This will force the server thread to terminate.
+        _terminate = true;
+        _server.close(NULLREP);
+
+        // Wait for the termination of the thread.
+        waitForTermination();
+        _is_open = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the server thread.
+//----------------------------------------------------------------------------
+
+void ts::OpenMetricsServer::main()
+{
+    _log.debug(u"metrics server thread started");
+
+    // Get accept errors in a buffer since some errors are normal.
+    ReportBuffer<NullMutex> error(_log.maxSeverity());
+
+    // Client address and connection.
+    SocketAddress source;
+    TelnetConnection conn;
+
+    // Loop on incoming connections, one request per connection.
+    while (_server.accept(conn, source, error)) {
+        _log.debug(u"connection from %s", {source});
+        if (conn.setReceiveTimeout(METRICS_TIMEOUT, _log)) {
+            processRequest(conn);
+        }
+        conn.closeWriter(_log);
+        conn.close(_log);
+    }
+
+    // If termination was requested, receive error is not an error.
+    if (!_terminate && !error.emptyMessages()) {
+        _log.error(error.getMessages());
+    }
+    _log.debug(u"metrics server thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Process one HTTP request.
+//----------------------------------------------------------------------------
+
+void ts::OpenMetricsServer::processRequest(TelnetConnection& conn)
+{
+    // Get the request line, then skip all headers until the empty line.
+    std::string request;
+    std::string header;
+    if (!conn.receiveLine(request, nullptr, _log)) {
+        return;
+    }
+    while (conn.receiveLine(header, nullptr, NULLREP) && !header.empty()) {
+    }
+
+    // Analyze the request line: method, URL, version.
+    UStringVector fields;
+    UString::FromUTF8(request).split(fields, u' ', true, true);
+    UString path(fields.size() < 2 ? UString() : fields[1]);
+    const size_t query = path.find(u'?');
+    if (query != NPOS) {
+        path.resize(query);
+    }
+
+    if (fields.size() < 2 || (fields[0] != u"GET" && fields[0] != u"HEAD")) {
+        sendResponse(conn, u"405 Method Not Allowed", u"text/plain", u"");
+    }
+    else if (path != u"/" && path != u"/metrics") {
+        sendResponse(conn, u"404 Not Found", u"text/plain", u"");
+    }
+    else {
+        UString text;
+        buildMetrics(text);
+        text.append(u"# EOF\n");
+        sendResponse(conn, u"200 OK", CONTENT_TYPE, fields[0] == u"HEAD" ? UString() : text);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Send an HTTP response.
+//----------------------------------------------------------------------------
+
+void ts::OpenMetricsServer::sendResponse(TelnetConnection& conn, const UString& status, const UString& type, const UString& content)
+{
+    const std::string body(content.toUTF8());
+    const UString header(UString::Format(u"HTTP/1.0 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", {status, type, body.size()}));
+    conn.send(header.toUTF8() + body, _log);
+}
+
+
+//----------------------------------------------------------------------------
+// Format metrics in OpenMetrics text format.
+//----------------------------------------------------------------------------
+
+void ts::OpenMetricsServer::AddFamily(UString& text, const UString& name, const UString& type, const UString& help, const UString& unit)
+{
+    text.format(u"# TYPE %s %s\n", {name, type});
+    if (!unit.empty()) {
+        text.format(u"# UNIT %s %s\n", {name, unit});
+    }
+    text.format(u"# HELP %s %s\n", {name, help});
+}
+
+void ts::OpenMetricsServer::AddSample(UString& text, const UString& name, const UString& labels, uint64_t value)
+{
+    if (labels.empty()) {
+        text.format(u"%s %d\n", {name, value});
+    }
+    else {
+        text.format(u"%s{%s} %d\n", {name, labels, value});
+    }
+}
+
+ts::UString ts::OpenMetricsServer::Label(const UString& name, const UString& value)
+{
+    UString escaped;
+    escaped.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        switch (value[i]) {
+            case u'\\': escaped.append(u"\\\\"); break;
+            case u'"': escaped.append(u"\\\""); break;
+            case u'\n': escaped.append(u"\\n"); break;
+            default: escaped.push_back(value[i]); break;
+        }
+    }
+    return name + u"=\"" + escaped + u"\"";
+}
@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Embedded HTTP server exposing metrics in OpenMetrics text format.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsThread.h"
+#include "tsTCPServer.h"
+#include "tsTelnetConnection.h"
+#include "tsReportWithPrefix.h"
+
+namespace ts {
+    //!
+    //! Embedded HTTP server exposing metrics in OpenMetrics text format.
+    //! This is the format which is scraped by Prometheus and compatible collectors.
+    //! This class is internal to the TSDuck library and cannot be called by applications.
+    //!
+    //! Subclasses implement buildMetrics() which is invoked in the context of the
+    //! server thread for each HTTP request. Since the metrics are collected from
+    //! another thread, subclasses should read counters which can be safely accessed
+    //! without locking the data of the application.
+    //!
+    //! @ingroup plugin
+    //!
+    class OpenMetricsServer : private Thread
+    {
+        TS_NOBUILD_NOCOPY(OpenMetricsServer);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] address Local socket address of the HTTP server.
+        //! If the port is unspecified, the server is not started.
+        //! @param [in,out] log Log report.
+        //!
+        OpenMetricsServer(const SocketAddress& address, Report& log);
+
+        //!
+        //! Destructor.
+        //! Subclasses must call close() in their destructor since the server thread
+        //! calls the virtual method buildMetrics().
+        //!
+        virtual ~OpenMetricsServer() override;
+
+        //!
+        //! Open and start the HTTP server.
+        //! @return True on success or when no server is required, false on error.
+        //!
+        bool open();
+
+        //!
+        //! Stop and close the HTTP server.
+        //!
+        void close();
+
+        //!
+        //! MIME type of the OpenMetrics text format.
+        //!
+        static const UString CONTENT_TYPE;
+
+    protected:
+        //!
+        //! Build all metrics in OpenMetrics text format.
+        //! Invoked in the context of the server thread.
+        //! @param [in,out] text Text to which the metrics are appended, without the final "# EOF" line.
+        //!
+        virtual void buildMetrics(UString& text) = 0;
+
+        //!
+        //! Append the description of a metric family in OpenMetrics text format.
+        //! @param [in,out] text Text to which the description is appended.
+        //! @param [in] name Name of the metric family.
+        //! @param [in] type Type of the metric family, typically "counter" or "gauge".
+        //! @param [in] help Description of the metric family.
+        //! @param [in] unit Optional unit of the metric family. The name of the family
+        //! must then end with the unit name.
+        //!
+        static void AddFamily(UString& text, const UString& name, const UString& type, const UString& help, const UString& unit = UString());
+
+        //!
+        //! Append a metric sample in OpenMetrics text format.
+        //! @param [in,out] text Text to which the sample is appended.
+        //! @param [in] name Name of the sample. For counters, this is the name of the family followed by "_total".
+        //! @param [in] labels Set of labels, as built by Label(), separated with commas. Can be empty.
+        //! @param [in] value Value of the sample.
+        //!
+        static void AddSample(UString& text, const UString& name, const UString& labels, uint64_t value);
+
+        //!
+        //! Build a label of a metric sample.
+        //! @param [in] name Name of the label.
+        //! @param [in] value Value of the label, will be escaped as required.
+        //! @return The label in OpenMetrics text format.
+        //!
+        static UString Label(const UString& name, const UString& value);
+
+    private:
+        volatile bool    _is_open;
+        volatile bool    _terminate;
+        SocketAddress    _address;
+        ReportWithPrefix _log;
+        TCPServer        _server;
+
+        // Implementation of Thread.
+        virtual void main() override;
+
+        // Process one HTTP request.
+        void processRequest(TelnetConnection& conn);
+
+        // Send an HTTP response.
+        void sendResponse(TelnetConnection& conn, const UString& status, const UString& type, const UString& content);
+    };
+}
@@ -53,12 +53,14 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, Mut
     _input(input),
     _output(nullptr),
     _plugins(),
-    _handlers{{TSPControlCommand::CMD_EXIT,    &ControlServer::executeExit},
-              {TSPControlCommand::CMD_SETLOG,  &ControlServer::executeSetLog},
-              {TSPControlCommand::CMD_LIST,    &ControlServer::executeList},
-              {TSPControlCommand::CMD_SUSPEND, &ControlServer::executeSuspend},
-              {TSPControlCommand::CMD_RESUME,  &ControlServer::executeResume},
-              {TSPControlCommand::CMD_RESTART, &ControlServer::executeRestart}}
+    _instr_report(),
+    _handlers{{TSPControlCommand::CMD_EXIT,       &ControlServer::executeExit},
+              {TSPControlCommand::CMD_SETLOG,     &ControlServer::executeSetLog},
+              {TSPControlCommand::CMD_LIST,       &ControlServer::executeList},
+              {TSPControlCommand::CMD_SUSPEND,    &ControlServer::executeSuspend},
+              {TSPControlCommand::CMD_RESUME,     &ControlServer::executeResume},
+              {TSPControlCommand::CMD_RESTART,    &ControlServer::executeRestart},
+              {TSPControlCommand::CMD_STATISTICS, &ControlServer::executeStatistics}}
 {
     // Locate output plugin, count packet processor plugins.
     if (_input != nullptr) {
@@ -356,3 +358,21 @@ void ts::tsp::ControlServer::executeRestart(const Args* args, Report& response)
         plugin->restart(params, response);
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Statistics command.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ControlServer::executeStatistics(const Args* args, Report& response)
+{
+    if (!_options.instrumentation) {
+        response.error(u"instrumentation is disabled, use tsp option --instrumentation");
+    }
+    else {
+        // Do not hold the global mutex, each plugin snapshot acquires it.
+        json::Object root;
+        _instr_report.build(root, _input);
+        response.info(root.printed());
+    }
+}
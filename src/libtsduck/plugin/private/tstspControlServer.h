@@ -37,6 +37,7 @@
 #include "tstspInputExecutor.h"
 #include "tstspProcessorExecutor.h"
 #include "tstspOutputExecutor.h"
+#include "tstspInstrumentation.h"
 #include "tsTSPControlCommand.h"
 #include "tsThread.h"
 #include "tsMutex.h"
@@ -90,6 +91,7 @@ namespace ts {
             InputExecutor*    _input;
             OutputExecutor*   _output;
             std::vector<ProcessorExecutor*> _plugins;  // Packet processing plugins
+            InstrumentationReport _instr_report;       // Instrumentation report, rates since previous command
 
             // Implementation of Thread.
             virtual void main() override;
@@ -106,6 +108,7 @@ namespace ts {
             void executeResume(const Args*, Report&);
             void executeSuspendResume(bool state, const Args*, Report&);
             void executeRestart(const Args*, Report&);
+            void executeStatistics(const Args*, Report&);
         };
     }
 }
@@ -199,6 +199,17 @@ void ts::tsp::InputExecutor::handleWatchDogTimeout(WatchDog& watchdog)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the current time in the reference of tsp-generated input time stamps.
+//----------------------------------------------------------------------------
+
+uint64_t ts::tsp::InputExecutor::currentTimeStamp() const
+{
+    // Convert nanoseconds in PCR units (27 MHz) without intermediate overflow.
+    return uint64_t(Monotonic(true) - _start_time) * (SYSTEM_CLOCK_FREQ / MicroSecPerSec) / NanoSecPerMicroSec;
+}
+
+
 //----------------------------------------------------------------------------
 // Receive null packets.
 //----------------------------------------------------------------------------
@@ -255,9 +266,9 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
     // Fill input time stamps with monotonic clock if none was provided by the input plugin.
     // Only check the first returned packet. Assume that the input plugin generates time stamps for all or none.
     if (count > 0 && !data[0].hasInputTimeStamp()) {
-        const NanoSecond current = Monotonic(true) - _start_time;
+        const uint64_t current = currentTimeStamp();
         for (size_t n = 0; n < count; ++n) {
-            data[n].setInputTimeStamp(current, NanoSecPerSec, TimeSource::TSP);
+            data[n].setInputTimeStamp(current, SYSTEM_CLOCK_FREQ, TimeSource::TSP);
         }
     }
 
@@ -291,6 +302,8 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
         }
     }
 
+    // Continuity analysis of the input packets, for the metrics server only.
+    checkContinuity(pkt, count);
     return count;
 }
 
@@ -86,6 +86,12 @@ namespace ts {
             //!
             bool initAllBuffers(PacketBuffer* buffer, PacketMetadataBuffer* metadata);
 
+            //!
+            //! Get the current time in the reference of the input time stamps which are generated by tsp.
+            //! @return The current time in PCR units since the creation of the input executor.
+            //!
+            uint64_t currentTimeStamp() const;
+
             // Overridden methods.
             virtual void setAbort() override;
             virtual size_t pluginIndex() const override;
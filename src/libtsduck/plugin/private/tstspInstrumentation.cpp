@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tstspInstrumentation.h"
+#include "tstspPluginExecutor.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::tsp::Instrumentation::LATENCY_BUCKETS;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Instrumentation counters.
+//----------------------------------------------------------------------------
+
+ts::tsp::Instrumentation::Instrumentation() :
+    packets(0),
+    wait_time(0),
+    cpu_time(0),
+    ring_samples(0),
+    ring_total(0),
+    ring_max(0),
+    latency()
+{
+}
+
+size_t ts::tsp::Instrumentation::LatencyBucket(uint64_t pcr_units)
+{
+    // Bucket index is the number of significant bits in the latency in microseconds.
+    uint64_t us = pcr_units / (SYSTEM_CLOCK_FREQ / MicroSecPerSec);
+    size_t index = 0;
+    while (us != 0 && index < LATENCY_BUCKETS - 1) {
+        us >>= 1;
+        index++;
+    }
+    return index;
+}
+
+ts::PacketCounter ts::tsp::Instrumentation::latencyCount() const
+{
+    PacketCounter count = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        count += latency[i];
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Instrumentation reports.
+//----------------------------------------------------------------------------
+
+ts::tsp::InstrumentationReport::InstrumentationReport() :
+    _previous_time(true),
+    _previous()
+{
+}
+
+ts::UString ts::tsp::InstrumentationReport::oneLiner(PluginExecutor* input)
+{
+    json::Object root;
+    build(root, input);
+
+    // JSON strings never contain raw new-lines, removing them is safe.
+    UString text(root.printed(0));
+    text.remove(u'\n');
+    return text;
+}
+
+void ts::tsp::InstrumentationReport::build(json::Object& root, PluginExecutor* input)
+{
+    const Monotonic now(true);
+    const NanoSecond duration = now - _previous_time;
+    _previous_time = now;
+
+    root.add(u"interval-ms", duration / NanoSecPerMilliSec);
+
+    // Loop on all plugins, from input to output.
+    size_t index = 0;
+    PluginExecutor* proc = input;
+    do {
+        // Get a consistent snapshot of the plugin counters and the previous one.
+        Instrumentation current;
+        proc->getInstrumentation(current);
+        if (_previous.size() <= index) {
+            _previous.resize(index + 1);
+        }
+        const Instrumentation& previous(_previous[index]);
+
+        // Cumulated values are since the start of tsp, rates are since the previous report.
+        // The busy ratio is the CPU time of the plugin thread over the interval.
+        const NanoSecond busy = current.cpu_time - previous.cpu_time;
+        const uint64_t samples = current.ring_samples - previous.ring_samples;
+
+        json::Value& jv(root.query(u"plugins[]", true));
+        jv.add(u"index", index);
+        jv.add(u"name", proc->pluginName());
+        jv.add(u"type", PluginTypeNames.name(proc->plugin()->type()));
+        jv.add(u"suspended", json::Bool(proc->getSuspended()));
+        jv.add(u"packets", current.packets);
+        jv.add(u"packets-per-second", duration <= 0 ? 0 : ((current.packets - previous.packets) * NanoSecPerSec) / duration);
+        jv.add(u"wait-ms", current.wait_time / NanoSecPerMilliSec);
+        jv.add(u"cpu-ms", current.cpu_time / NanoSecPerMilliSec);
+        jv.add(u"busy-percent", duration <= 0 ? 0 : (100 * busy) / duration);
+        jv.add(u"buffer-average", samples == 0 ? 0 : (current.ring_total - previous.ring_total) / samples);
+        jv.add(u"buffer-max", current.ring_max);
+
+        // Latency histogram over the interval, output plugin only.
+        if (proc->plugin()->type() == PluginType::OUTPUT) {
+            PacketCounter count = current.latencyCount() - previous.latencyCount();
+            PacketCounter cumul = 0;
+            int64_t p50 = -1;
+            int64_t p99 = -1;
+            for (size_t i = 0; i < Instrumentation::LATENCY_BUCKETS; ++i) {
+                const PacketCounter n = current.latency[i] - previous.latency[i];
+                jv.query(u"latency-histogram", true, json::TypeArray).set(n);
+                cumul += n;
+                // Report the upper bound of the bucket where each percentile is reached.
+                if (count > 0 && p50 < 0 && cumul * 100 >= count * 50) {
+                    p50 = int64_t(1) << i;
+                }
+                if (count > 0 && p99 < 0 && cumul * 100 >= count * 99) {
+                    p99 = int64_t(1) << i;
+                }
+            }
+            jv.add(u"latency-count", count);
+            if (count > 0) {
+                jv.add(u"latency-p50-us", p50);
+                jv.add(u"latency-p99-us", p99);
+            }
+        }
+
+        _previous[index++] = current;
+
+    } while ((proc = proc->ringNext<PluginExecutor>()) != input);
+}
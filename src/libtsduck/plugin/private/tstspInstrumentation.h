@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor: Instrumentation of the plugin executors.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsjsonObject.h"
+#include "tsMonotonic.h"
+#include "tsMPEG.h"
+
+namespace ts {
+    namespace tsp {
+
+        class PluginExecutor;
+
+        //!
+        //! Instrumentation counters of a tsp plugin executor.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup plugin
+        //!
+        class Instrumentation
+        {
+        public:
+            //!
+            //! Number of buckets in the latency histogram.
+            //! Bucket 0 counts latencies under 1 microsecond. Bucket n counts latencies
+            //! from 2^(n-1) to 2^n microseconds. The last bucket counts all longer latencies.
+            //!
+            static constexpr size_t LATENCY_BUCKETS = 24;
+
+            PacketCounter packets;       //!< Number of packets which were passed to the next plugin.
+            NanoSecond    wait_time;     //!< Cumulated elapsed time waiting for packets (or free buffer for the input plugin).
+            NanoSecond    cpu_time;      //!< Cumulated CPU time of the plugin thread (not including preemption).
+            uint64_t      ring_samples;  //!< Number of samples of the buffer occupancy.
+            uint64_t      ring_total;    //!< Sum of all samples of the buffer occupancy, in packets.
+            size_t        ring_max;      //!< Maximum sampled buffer occupancy, in packets.
+            PacketCounter latency[LATENCY_BUCKETS];  //!< Histogram of input-to-output latencies (output plugin only).
+
+            //!
+            //! Constructor.
+            //!
+            Instrumentation();
+
+            //!
+            //! Add the latency of one packet in the histogram.
+            //! @param [in] pcr_units Input-to-output latency in PCR units.
+            //!
+            void addLatency(uint64_t pcr_units) { latency[LatencyBucket(pcr_units)]++; }
+
+            //!
+            //! Get the index of the latency histogram bucket for a latency value.
+            //! @param [in] pcr_units Input-to-output latency in PCR units.
+            //! @return The bucket index in the latency histogram.
+            //!
+            static size_t LatencyBucket(uint64_t pcr_units);
+
+            //!
+            //! Count the total number of latency samples in the histogram.
+            //! @return The total number of latency samples.
+            //!
+            PacketCounter latencyCount() const;
+        };
+
+        //!
+        //! Build reports on the instrumentation of all plugins in a tsp chain.
+        //! Rates are computed over the interval since the previous report.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup plugin
+        //!
+        class InstrumentationReport
+        {
+            TS_NOCOPY(InstrumentationReport);
+        public:
+            //!
+            //! Constructor.
+            //! The first report computes rates since the construction of this object.
+            //!
+            InstrumentationReport();
+
+            //!
+            //! Build a JSON report of the instrumentation of all plugins.
+            //! Must not be called with the global mutex held.
+            //! @param [out] root JSON object receiving the report.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //!
+            void build(json::Object& root, PluginExecutor* input);
+
+            //!
+            //! Build a one-line JSON report of the instrumentation of all plugins.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //! @return The JSON text, on one line.
+            //!
+            UString oneLiner(PluginExecutor* input);
+
+        private:
+            Monotonic                    _previous_time;
+            std::vector<Instrumentation> _previous;
+        };
+    }
+}
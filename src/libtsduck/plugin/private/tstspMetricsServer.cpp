@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tstspMetricsServer.h"
+#include "tsGuard.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tsp::MetricsServer::MetricsServer(const TSProcessorArgs& options, Report& log, Mutex& global_mutex, InputExecutor* input) :
+    OpenMetricsServer(options.metrics_server, log),
+    _plugins(),
+    _labels()
+{
+    // Build the list of plugins, from input to output.
+    if (input != nullptr) {
+        Guard lock(global_mutex);
+        PluginExecutor* proc = input;
+        do {
+            _labels.push_back(Label(u"index", UString::Decimal(_plugins.size(), 0, true, UString())) + u"," + Label(u"name", proc->pluginName()));
+            _plugins.push_back(proc);
+        } while ((proc = proc->ringNext<PluginExecutor>()) != input);
+    }
+}
+
+ts::tsp::MetricsServer::~MetricsServer()
+{
+    // Terminate the thread before destructing the subclass.
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Build all metrics, invoked in the context of the server thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsServer::buildMetrics(UString& text)
+{
+    if (_plugins.empty()) {
+        return;
+    }
+
+    AddFamily(text, u"tsp_buffer_size_packets", u"gauge", u"Size of the global packet buffer", u"packets");
+    AddSample(text, u"tsp_buffer_size_packets", UString(), _plugins.front()->bufferSize());
+
+    AddFamily(text, u"tsp_plugin_packets", u"counter", u"Packets which were passed through the plugin thread");
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        AddSample(text, u"tsp_plugin_packets_total", _labels[i], _plugins[i]->totalPacketsInThread());
+    }
+
+    AddFamily(text, u"tsp_plugin_processed_packets", u"counter", u"Packets which were processed by the plugin, excluding dropped packets");
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        AddSample(text, u"tsp_plugin_processed_packets_total", _labels[i], _plugins[i]->pluginPackets());
+    }
+
+    AddFamily(text, u"tsp_plugin_bitrate_bits_per_second", u"gauge", u"Bitrate as seen by the plugin, the input bitrate is from the plugin or the PCR analysis", u"bits_per_second");
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        AddSample(text, u"tsp_plugin_bitrate_bits_per_second", _labels[i], _plugins[i]->bitrate());
+    }
+
+    AddFamily(text, u"tsp_plugin_buffer_packets", u"gauge", u"Packets in the buffer area of the plugin, free space for the input plugin", u"packets");
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        AddSample(text, u"tsp_plugin_buffer_packets", _labels[i], _plugins[i]->bufferedPackets());
+    }
+
+    AddFamily(text, u"tsp_plugin_suspended", u"gauge", u"The plugin is suspended");
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        AddSample(text, u"tsp_plugin_suspended", _labels[i], _plugins[i]->getSuspended());
+    }
+
+    // Continuity counters are checked on input and output packets only.
+    AddFamily(text, u"tsp_continuity_errors", u"counter", u"Continuity errors in packets from the input plugin or to the output plugin");
+    AddSample(text, u"tsp_continuity_errors_total", _labels.front(), _plugins.front()->continuityErrors());
+    AddSample(text, u"tsp_continuity_errors_total", _labels.back(), _plugins.back()->continuityErrors());
+}
@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor OpenMetrics server.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsOpenMetricsServer.h"
+#include "tsTSProcessorArgs.h"
+#include "tstspInputExecutor.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Transport stream processor OpenMetrics server.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //!
+        //! The counters of the plugin executors are read without locking the global mutex.
+        //! They are updated by the plugin threads only and a scrape may see values which
+        //! are one packet chunk late, which is acceptable for monitoring.
+        //!
+        //! @ingroup plugin
+        //!
+        class MetricsServer : public OpenMetricsServer
+        {
+            TS_NOBUILD_NOCOPY(MetricsServer);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] options Command line options for tsp.
+            //! @param [in,out] log Log report.
+            //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
+            //! Used only to explore the plugin chain during construction.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //!
+            MetricsServer(const TSProcessorArgs& options, Report& log, Mutex& global_mutex, InputExecutor* input);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~MetricsServer() override;
+
+        protected:
+            // Implementation of OpenMetricsServer.
+            virtual void buildMetrics(UString& text) override;
+
+        private:
+            std::vector<PluginExecutor*> _plugins;  // All plugins, from input to output.
+            UStringVector                _labels;   // Labels of each plugin.
+        };
+    }
+}
@@ -28,6 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tstspOutputExecutor.h"
+#include "tstspInputExecutor.h"
 TSDUCK_SOURCE;
 
 
@@ -43,8 +44,11 @@ ts::tsp::OutputExecutor::OutputExecutor(const TSProcessorArgs& options,
                                         Report* report) :
 
     PluginExecutor(options, handlers, PluginType::OUTPUT, pl_options, attributes, global_mutex, report),
-    _output(dynamic_cast<OutputPlugin*>(PluginThread::plugin()))
+    _output(dynamic_cast<OutputPlugin*>(PluginThread::plugin())),
+    _instr_report(),
+    _instr_next(options.instr_interval > 0)
 {
+    _instr_next += options.instr_interval * NanoSecPerMilliSec;
 }
 
 ts::tsp::OutputExecutor::~OutputExecutor()
@@ -146,7 +150,12 @@ void ts::tsp::OutputExecutor::main()
                 else if (_output->send(pkt, data, out_cnt)) {
                     // Packet successfully sent.
                     addPluginPackets(out_cnt);
+                    checkContinuity(pkt, out_cnt);
                     output_packets += out_cnt;
+                    if (_options.instrumentation) {
+                        // The next plugin of the output is the input, the time reference of tsp time stamps.
+                        addLatencies(data, out_cnt, ringNext<InputExecutor>()->currentTimeStamp());
+                    }
                 }
                 else {
                     // Send error.
@@ -163,6 +172,16 @@ void ts::tsp::OutputExecutor::main()
         // Do not transmit bitrate or input end to next (since next is input processor).
         aborted = !passPackets(pkt_cnt, 0, false, aborted);
 
+        // Periodically log the instrumentation report of all plugins.
+        if (_options.instr_interval > 0) {
+            const Monotonic now(true);
+            if (now >= _instr_next) {
+                info(u"instrumentation: %s", {_instr_report.oneLiner(ringNext<PluginExecutor>())});
+                _instr_next = now;
+                _instr_next += _options.instr_interval * NanoSecPerMilliSec;
+            }
+        }
+
     } while (!aborted);
 
     // Close the output processor
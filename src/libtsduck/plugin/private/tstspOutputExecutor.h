@@ -72,7 +72,9 @@ namespace ts {
             virtual size_t pluginIndex() const override;
 
         private:
-            OutputPlugin* _output;
+            OutputPlugin*         _output;
+            InstrumentationReport _instr_report;  // Periodic instrumentation report.
+            Monotonic             _instr_next;    // Time of next instrumentation report.
 
             // Inherited from Thread
             virtual void main() override;
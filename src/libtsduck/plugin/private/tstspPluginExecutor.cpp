@@ -31,6 +31,7 @@
 #include "tsPluginRepository.h"
 #include "tsGuardCondition.h"
 #include "tsGuard.h"
+#include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
 
@@ -58,12 +59,26 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _input_end(false),
     _bitrate(0),
     _restart(false),
-    _restart_data()
+    _restart_data(),
+    _instr(),
+    _instr_mark(options.instrumentation),
+    _instr_idle(false),
+    _latency(),
+    _latency_pending(false),
+    _cc_analyzer(),
+    _cc_errors(0)
 {
     // Preset common default options.
     if (plugin() != nullptr) {
         plugin()->resetContext(options.duck_args);
     }
+
+    // The continuity analyzer is large (one context per PID), allocate it only when used.
+    // Only errors are counted, don't keep a copy of the last packet in each PID.
+    if (options.metrics_server.hasPort()) {
+        _cc_analyzer = new ContinuityAnalyzer(AllPIDs);
+        _cc_analyzer->setDuplicateDetection(false);
+    }
 }
 
 ts::tsp::PluginExecutor::~PluginExecutor()
@@ -88,7 +103,7 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer* buffer,
     _buffer = buffer;
     _metadata = metadata;
     _pkt_first = pkt_first;
-    _pkt_cnt = pkt_cnt;
+    _pkt_cnt.store(pkt_cnt, std::memory_order_relaxed);
     _input_end = input_end;
     _tsp_aborting = aborted;
     _bitrate = bitrate;
@@ -124,7 +139,7 @@ void ts::tsp::PluginExecutor::signalPluginEvent(uint32_t event_code, Object* plu
 
 bool ts::tsp::PluginExecutor::passPackets(size_t count, BitRate bitrate, bool input_end, bool aborted)
 {
-    assert(count <= _pkt_cnt);
+    assert(count <= _pkt_cnt.load(std::memory_order_relaxed));
     assert(_pkt_first + count <= _buffer->count());
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
@@ -134,17 +149,33 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, BitRate bitrate, bool in
 
     // Update our buffer
     _pkt_first = (_pkt_first + count) % _buffer->count();
-    _pkt_cnt -= count;
+    _pkt_cnt.fetch_sub(count, std::memory_order_relaxed);
+    _instr.packets += count;
+
+    // Merge the latencies which were collected without lock by this plugin thread.
+    if (_latency_pending) {
+        for (size_t i = 0; i < Instrumentation::LATENCY_BUCKETS; ++i) {
+            _instr.latency[i] += _latency[i];
+            _latency[i] = 0;
+        }
+        _latency_pending = false;
+    }
 
     // Update next processor's buffer.
+    // All nodes in the ring are plugin executors, a null next executor is a fatal internal error.
     PluginExecutor* next = ringNext<PluginExecutor>();
-    next->_pkt_cnt += count;
+    if (next == nullptr) {
+        error(u"internal error, no next plugin executor");
+        _tsp_aborting = true;
+        return false;
+    }
+    next->_pkt_cnt.fetch_add(count, std::memory_order_relaxed);
     next->_input_end = next->_input_end || input_end;
     next->_bitrate = bitrate;
 
     // Wake the next processor when there is some data
     if (count > 0 || input_end) {
-        next->_to_do.signal();
+        next->signalWork();
     }
 
     // Force to abort our processor when the next one is aborting.
@@ -158,7 +189,7 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, BitRate bitrate, bool in
     // Wake the previous processor when we abort
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.signal();
+        ringPrevious<PluginExecutor>()->signalWork();
     }
 
     // Return false when the current processor shall stop.
@@ -174,7 +205,32 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     Guard lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.signal();
+    ringPrevious<PluginExecutor>()->signalWork();
+}
+
+
+//----------------------------------------------------------------------------
+// Start and wait for the execution of the plugin, in its own thread.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::startExecution()
+{
+    return start();
+}
+
+void ts::tsp::PluginExecutor::waitExecution()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Signal that there is something to do (global mutex held).
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::signalWork()
+{
+    _to_do.signal();
 }
 
 
@@ -192,17 +248,34 @@ bool ts::tsp::PluginExecutor::isRealTime() const
 // Wait for packets to process or some error condition.
 //----------------------------------------------------------------------------
 
-void ts::tsp::PluginExecutor::waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout)
+bool ts::tsp::PluginExecutor::waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout, bool wait)
 {
     log(10, u"waitWork(...)");
 
     // We access data under the protection of the global mutex.
     GuardCondition lock(_global_mutex, _to_do);
 
+    // With instrumentation, start of the wait. The processing cost is the CPU time of the plugin
+    // thread, not the elapsed time since the previous wait which includes preemption by other threads.
+    // In a thread pool, the CPU time is accounted by the caller, using addCPUTime().
+    if (_options.instrumentation && wait) {
+        _instr.cpu_time = GetThreadCPUTime();
+        _instr_mark.getSystemTime();
+    }
+
     PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
 
-    while (_pkt_cnt == 0 && !_input_end && !timeout && !next->_tsp_aborting) {
+    while (_pkt_cnt.load(std::memory_order_relaxed) == 0 && !_input_end && !timeout && !next->_tsp_aborting) {
+        if (!wait) {
+            // Nothing to do, don't wait. The waiting time is accounted from now until some work is found.
+            if (_options.instrumentation && !_instr_idle) {
+                _instr_mark.getSystemTime();
+                _instr_idle = true;
+            }
+            log(10, u"waitWork(), nothing to do");
+            return false;
+        }
         // If packet area for this processor is empty, wait for some packet.
         // The mutex is implicitely released, we wait for the condition
         // '_to_do' and, once we get it, implicitely relock the mutex.
@@ -211,18 +284,61 @@ void ts::tsp::PluginExecutor::waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRa
         timeout = !lock.waitCondition(_tsp_timeout) && !plugin()->handlePacketTimeout();
     }
 
+    const size_t avail = _pkt_cnt.load(std::memory_order_relaxed);
     pkt_first = _pkt_first;
-    pkt_cnt = timeout ? 0 : std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+    pkt_cnt = timeout ? 0 : std::min(avail, _buffer->count() - _pkt_first);
     bitrate = _bitrate;
-    input_end = _input_end && pkt_cnt == _pkt_cnt;
+    input_end = _input_end && pkt_cnt == avail;
 
     // Force to abort our processor when the next one is aborting.
     // Don't do that if current is output and next is input because
     // there is no propagation of packets from output back to input.
     aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
 
+    // With instrumentation, account the waiting time and sample the occupancy of our buffer area.
+    if (_options.instrumentation) {
+        if (wait || _instr_idle) {
+            _instr.wait_time += Monotonic(true) - _instr_mark;
+            _instr_idle = false;
+        }
+        _instr.ring_samples++;
+        _instr.ring_total += avail;
+        _instr.ring_max = std::max(_instr.ring_max, avail);
+    }
+
     log(10, u"waitWork(pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
         {pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Instrumentation.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::getInstrumentation(Instrumentation& instr) const
+{
+    Guard lock(_global_mutex);
+    instr = _instr;
+}
+
+void ts::tsp::PluginExecutor::addCPUTime(NanoSecond cpu_time)
+{
+    Guard lock(_global_mutex);
+    _instr.cpu_time += cpu_time;
+}
+
+void ts::tsp::PluginExecutor::addLatencies(const TSPacketMetadata* data, size_t count, uint64_t now)
+{
+    // No lock here, the latencies are merged in the instrumentation counters by passPackets().
+    now %= PCR_SCALE;
+    for (size_t i = 0; i < count; ++i) {
+        if (data[i].getInputTimeSource() == TimeSource::TSP && data[i].hasInputTimeStamp()) {
+            // Time stamps are in the range 0 to PCR_SCALE and wrap around.
+            _latency[Instrumentation::LatencyBucket((now + PCR_SCALE - data[i].getInputTimeStamp()) % PCR_SCALE)]++;
+            _latency_pending = true;
+        }
+    }
 }
 
 
@@ -260,7 +376,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
     // Acquire the global mutex to modify global data.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     {
-        GuardCondition lock1(_global_mutex, _to_do);
+        Guard lock1(_global_mutex);
 
         // If there was a previous pending restart operation, cancel it.
         if (!_restart_data.isNull()) {
@@ -276,7 +392,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        lock1.signal();
+        signalWork();
     }
 
     // Now wait for the restart operation to complete.
@@ -355,3 +471,16 @@ bool ts::tsp::PluginExecutor::processPendingRestart()
     debug(u"restarted plugin %s, status: %s", {pluginName(), success});
     return success;
 }
+
+
+//----------------------------------------------------------------------------
+// Check the continuity counters of packets for the metrics server.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::checkContinuity(const TSPacket* pkt, size_t count)
+{
+    if (!_cc_analyzer.isNull() && count > 0) {
+        _cc_analyzer->feedPackets(pkt, count);
+        _cc_errors.store(_cc_analyzer->errorCount(), std::memory_order_relaxed);
+    }
+}
@@ -34,10 +34,12 @@
 
 #pragma once
 #include "tstspJointTermination.h"
+#include "tstspInstrumentation.h"
 #include "tsRingNode.h"
 #include "tsTSProcessorArgs.h"
 #include "tsPluginEventHandlerRegistry.h"
 #include "tsPlugin.h"
+#include "tsContinuityAnalyzer.h"
 #include "tsUserInterrupt.h"
 #include "tsCondition.h"
 #include "tsMutex.h"
@@ -106,6 +108,18 @@ namespace ts {
             //!
             virtual void setAbort();
 
+            //!
+            //! Start the execution of the plugin.
+            //! By default, the plugin is executed in its own thread.
+            //! @return True on success, false on error.
+            //!
+            virtual bool startExecution();
+
+            //!
+            //! Wait for the end of the execution of the plugin.
+            //!
+            virtual void waitExecution();
+
             //!
             //! Check if the plugin a real time one.
             //! @return True if the plugin usually requires real-time responsiveness.
@@ -143,6 +157,37 @@ namespace ts {
             //!
             void restart(Report& report);
 
+            //!
+            //! Get a snapshot of the instrumentation counters of this plugin.
+            //! This method is called from another thread, not the plugin thread.
+            //! The counters are updated only when the tsp option --instrumentation is used.
+            //! @param [out] instr Returned instrumentation counters.
+            //!
+            void getInstrumentation(Instrumentation& instr) const;
+
+            //!
+            //! Get the number of packets in the buffer area of this plugin.
+            //! For the input plugin, this is the free space in the buffer.
+            //! The value is read without locking the global mutex and is suitable for monitoring only.
+            //! @return The number of packets in the buffer area of this plugin.
+            //!
+            size_t bufferedPackets() const { return _pkt_cnt.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the size of the global packet buffer.
+            //! @return The size of the global packet buffer in packets.
+            //!
+            size_t bufferSize() const { return _buffer == nullptr ? 0 : _buffer->count(); }
+
+            //!
+            //! Get the number of continuity errors in the packets of this plugin.
+            //! The continuity counters are checked only when the metrics server is active,
+            //! on packets from the input plugin and to the output plugin.
+            //! The value is read without locking the global mutex and is suitable for monitoring only.
+            //! @return The number of continuity errors.
+            //!
+            PacketCounter continuityErrors() const { return _cc_errors.load(std::memory_order_relaxed); }
+
             // Implementation of TSP virtual methods.
             virtual size_t pluginCount() const override;
             virtual void signalPluginEvent(uint32_t event_code, Object* plugin_data = nullptr) const override;
@@ -172,6 +217,12 @@ namespace ts {
             //!
             bool passPackets(size_t count, BitRate bitrate, bool input_end, bool aborted);
 
+            //!
+            //! Signal the plugin executor that there is something to do.
+            //! Must be called with the global mutex held.
+            //!
+            virtual void signalWork();
+
             //!
             //! Wait for something to do.
             //!
@@ -191,8 +242,19 @@ namespace ts {
             //! @param [out] aborted The *next* processor indicates that it aborts and will no longer accept packets.
             //! @param [out] timeout No packet could be returned within the timeout specified by the plugin and
             //! the plugin requested an abort.
+            //! @param [in] wait If false, do not wait when there is nothing to do, typically when the plugin is
+            //! executed in a thread pool. The caller is later notified by signalWork().
+            //! @return True when there is something to do, false when @a wait is false and there is nothing to do.
+            //!
+            bool waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout, bool wait = true);
+
+            //!
+            //! Add CPU time in the instrumentation counters.
+            //! Used when the plugin is executed in a thread pool, where the CPU time of
+            //! the thread is not the CPU time of the plugin.
+            //! @param [in] cpu_time CPU time of the plugin since the previous call.
             //!
-            void waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout);
+            void addCPUTime(NanoSecond cpu_time);
 
             //!
             //! Process a pending restart operation if there is one.
@@ -201,6 +263,25 @@ namespace ts {
             //!
             bool processPendingRestart();
 
+            //!
+            //! Add the input-to-output latencies of packets in the instrumentation counters.
+            //! Only the packets with input time stamps which were generated by tsp are used.
+            //! The global mutex is not used, the latencies are collected by the plugin thread
+            //! and merged in the instrumentation counters in the next call to passPackets().
+            //! @param [in] data Metadata of the packets.
+            //! @param [in] count Number of packets.
+            //! @param [in] now Current time in PCR units, in the same reference as the input time stamps.
+            //!
+            void addLatencies(const TSPacketMetadata* data, size_t count, uint64_t now);
+
+            //!
+            //! Check the continuity counters of packets for the metrics server.
+            //! Do nothing when the metrics server is not active.
+            //! @param [in] pkt Address of the first packet.
+            //! @param [in] count Number of packets.
+            //!
+            void checkContinuity(const TSPacket* pkt, size_t count);
+
         private:
             // Registry of plugin event handlers.
             const PluginEventHandlerRegistry& _handlers;
@@ -213,11 +294,22 @@ namespace ts {
             // Implementation details: see the file src/docs/developing-plugins.dox
             Condition      _to_do;         // Notify processor to do something.
             size_t         _pkt_first;     // Starting index of packets area
-            size_t         _pkt_cnt;       // Size of packets area
+            std::atomic<size_t> _pkt_cnt;  // Size of packets area (atomic, also read by the metrics server)
             bool           _input_end;     // No more packet after current ones
             BitRate        _bitrate;       // Input bitrate (set by previous plugin)
             bool           _restart;       // Restart the plugni asap using _restart_data
             RestartDataPtr _restart_data;  // How to restart the plugin
+            Instrumentation _instr;        // Instrumentation counters (with --instrumentation only)
+
+            // Accessed by the plugin thread only.
+            Monotonic      _instr_mark;    // Start of the current wait
+            bool           _instr_idle;    // Waiting since _instr_mark, without blocking
+            PacketCounter  _latency[Instrumentation::LATENCY_BUCKETS];  // Latencies to merge in _instr
+            bool           _latency_pending;                            // Some latencies to merge in _instr
+            SafePtr<ContinuityAnalyzer, NullMutex> _cc_analyzer;  // Continuity analysis (allocated with --metrics only)
+
+            // Written by the plugin thread, read by the metrics server.
+            std::atomic<PacketCounter> _cc_errors;  // Number of continuity errors
 
             // Description of a restart operation.
             class RestartData
@@ -28,6 +28,8 @@
 //----------------------------------------------------------------------------
 
 #include "tstspProcessorExecutor.h"
+#include "tsSysUtils.h"
+#include "tsGuard.h"
 TSDUCK_SOURCE;
 
 
@@ -40,17 +42,29 @@ ts::tsp::ProcessorExecutor::ProcessorExecutor(const TSProcessorArgs& options,
                                               size_t plugin_index,
                                               const ThreadAttributes& attributes,
                                               Mutex& global_mutex,
-                                              Report* report) :
+                                              Report* report,
+                                              TSProcessorPool* pool) :
 
     PluginExecutor(options, handlers, PluginType::PROCESSOR, options.plugins[plugin_index], attributes, global_mutex, report),
+    TSProcessorPool::Job(),
     _processor(dynamic_cast<ProcessorPlugin*>(PluginThread::plugin())),
-    _plugin_index(1 + plugin_index) // include first input plugin in the count
+    _plugin_index(1 + plugin_index), // include first input plugin in the count
+    _pool(pool),
+    _in_pool(false),
+    _only_labels(),
+    _passed_packets(0),
+    _dropped_packets(0),
+    _nullified_packets(0),
+    _output_bitrate(0),
+    _bitrate_never_modified(true),
+    _end_of_input(false),
+    _aborted(false)
 {
 }
 
 ts::tsp::ProcessorExecutor::~ProcessorExecutor()
 {
-    waitForTermination();
+    waitExecution();
 }
 
 
@@ -65,155 +79,250 @@ size_t ts::tsp::ProcessorExecutor::pluginIndex() const
 
 
 //----------------------------------------------------------------------------
-// Packet processor plugin thread
+// Start the execution of the plugin, in the thread pool when possible.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::ProcessorExecutor::startExecution()
+{
+    startProcessing();
+
+    // A plugin with a packet timeout must wait for packets in its own thread.
+    // A real-time plugin may wait in its packet processing and would block a thread of the pool.
+    // A plugin which requires a large stack cannot be executed in the pool.
+    if (_pool == nullptr || _tsp_timeout != Infinite || _processor->isRealTime() || _processor->stackUsage() > _pool->stackUsage()) {
+        return PluginExecutor::startExecution();
+    }
+    else {
+        {
+            Guard lock(_global_mutex);
+            _in_pool = true;
+        }
+        debug(u"packet processing started in thread pool");
+        return _pool->startJob(this);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for the end of the execution of the plugin.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::waitExecution()
+{
+    if (_in_pool) {
+        _pool->waitJob(this);
+    }
+    else {
+        PluginExecutor::waitExecution();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Signal that there is something to do (global mutex held).
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::signalWork()
+{
+    PluginExecutor::signalWork();
+    if (_in_pool) {
+        _pool->schedule(this);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Packet processor plugin thread, when the plugin is not in the thread pool.
 //----------------------------------------------------------------------------
 
 void ts::tsp::ProcessorExecutor::main()
 {
     debug(u"packet processing thread started");
+    while (processPackets(true) != Step::COMPLETED) {
+    }
+    stopProcessing();
+}
 
-    const TSPacketMetadata::LabelSet only_labels(_processor->getOnlyLabelOption());
-    PacketCounter passed_packets = 0;
-    PacketCounter dropped_packets = 0;
-    PacketCounter nullified_packets = 0;
-    BitRate output_bitrate = _tsp_bitrate;
-    bool bitrate_never_modified = true;
-    bool input_end = false;
-    bool aborted = false;
-
-    do {
-        // Wait for packets to process
-        size_t pkt_first = 0;
-        size_t pkt_cnt = 0;
-        bool timeout = false;
-        waitWork(pkt_first, pkt_cnt, _tsp_bitrate, input_end, aborted, timeout);
-
-        // If bit rate was never modified by the plugin, always copy the
-        // input bitrate as output bitrate. Otherwise, keep previous
-        // output bitrate, as modified by the plugin.
-        if (bitrate_never_modified) {
-            output_bitrate = _tsp_bitrate;
-        }
 
-        // Process restart requests.
-        if (!processPendingRestart()) {
-            timeout = true;
-        }
+//----------------------------------------------------------------------------
+// One step of the job in the thread pool.
+//----------------------------------------------------------------------------
 
-        // In case of abort on timeout, notify previous and next plugin, then exit.
-        if (timeout) {
-            passPackets(0, output_bitrate, true, true);
-            aborted = true;
-            break;
-        }
+ts::TSProcessorPool::Job::Step ts::tsp::ProcessorExecutor::runJob()
+{
+    // The CPU time of the thread is shared by all jobs of the pool, account the time of this step only.
+    const NanoSecond start = _options.instrumentation ? GetThreadCPUTime() : 0;
+    const Step step = processPackets(false);
+    if (step == Step::COMPLETED) {
+        stopProcessing();
+    }
+    if (_options.instrumentation) {
+        addCPUTime(GetThreadCPUTime() - start);
+    }
+    return step;
+}
 
-        // If next processor has aborted, abort as well.
-        // We call passPacket to inform our predecessor that we aborted.
-        if (aborted && !input_end) {
-            passPackets(0, output_bitrate, true, true);
-            break;
-        }
 
-        // Exit thread if no more packet to process.
-        // We call passPackets to inform our successor of end of input.
-        if (pkt_cnt == 0 && input_end) {
-            passPackets(0, output_bitrate, true, false);
-            break;
-        }
+//----------------------------------------------------------------------------
+// Prepare and terminate the processing.
+//----------------------------------------------------------------------------
 
-        // Now process the packets.
-        size_t pkt_done = 0;
-        size_t pkt_flush = 0;
+void ts::tsp::ProcessorExecutor::startProcessing()
+{
+    _only_labels = _processor->getOnlyLabelOption();
+    _passed_packets = 0;
+    _dropped_packets = 0;
+    _nullified_packets = 0;
+    _output_bitrate = _tsp_bitrate;
+    _bitrate_never_modified = true;
+    _end_of_input = false;
+    _aborted = false;
+}
 
-        while (pkt_done < pkt_cnt && !aborted) {
+void ts::tsp::ProcessorExecutor::stopProcessing()
+{
+    // Close the packet processor
+    _processor->stop();
 
-            TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
-            TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
+    debug(u"packet processing %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
+          {_end_of_input ? u"terminated" : u"aborted", pluginPackets(), _passed_packets, _dropped_packets, _nullified_packets});
+}
 
-            pkt_done++;
-            pkt_flush++;
 
-            if (pkt->b[0] == 0) {
-                // The packet has already been dropped by a previous packet processor.
-                addNonPluginPackets(1);
+//----------------------------------------------------------------------------
+// Process the next group of packets.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPool::Job::Step ts::tsp::ProcessorExecutor::processPackets(bool wait)
+{
+    // Wait for packets to process
+    size_t pkt_first = 0;
+    size_t pkt_cnt = 0;
+    bool timeout = false;
+    if (!waitWork(pkt_first, pkt_cnt, _tsp_bitrate, _end_of_input, _aborted, timeout, wait)) {
+        return Step::IDLE;
+    }
+
+    // If bit rate was never modified by the plugin, always copy the
+    // input bitrate as output bitrate. Otherwise, keep previous
+    // output bitrate, as modified by the plugin.
+    if (_bitrate_never_modified) {
+        _output_bitrate = _tsp_bitrate;
+    }
+
+    // Process restart requests.
+    if (!processPendingRestart()) {
+        timeout = true;
+    }
+
+    // In case of abort on timeout, notify previous and next plugin, then exit.
+    if (timeout) {
+        passPackets(0, _output_bitrate, true, true);
+        _aborted = true;
+        return Step::COMPLETED;
+    }
+
+    // If next processor has aborted, abort as well.
+    // We call passPacket to inform our predecessor that we aborted.
+    if (_aborted && !_end_of_input) {
+        passPackets(0, _output_bitrate, true, true);
+        return Step::COMPLETED;
+    }
+
+    // Exit thread if no more packet to process.
+    // We call passPackets to inform our successor of end of input.
+    if (pkt_cnt == 0 && _end_of_input) {
+        passPackets(0, _output_bitrate, true, false);
+        return Step::COMPLETED;
+    }
+
+    // Now process the packets.
+    size_t pkt_done = 0;
+    size_t pkt_flush = 0;
+
+    while (pkt_done < pkt_cnt && !_aborted) {
+
+        TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
+        TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
+
+        pkt_done++;
+        pkt_flush++;
+
+        if (pkt->b[0] == 0) {
+            // The packet has already been dropped by a previous packet processor.
+            addNonPluginPackets(1);
+        }
+        else {
+            // Apply the processing routine to the packet
+            const bool was_null = pkt->getPID() == PID_NULL;
+            pkt_data->setFlush(false);
+            pkt_data->setBitrateChanged(false);
+            ProcessorPlugin::Status status = ProcessorPlugin::TSP_OK;
+            if (!_suspended && (_only_labels.none() || pkt_data->hasAnyLabel(_only_labels))) {
+                // Either no --only-label option or the packet has a specified label => process it.
+                status = _processor->processPacket(*pkt, *pkt_data);
+                addPluginPackets(1);
             }
             else {
-                // Apply the processing routine to the packet
-                const bool was_null = pkt->getPID() == PID_NULL;
-                pkt_data->setFlush(false);
-                pkt_data->setBitrateChanged(false);
-                ProcessorPlugin::Status status = ProcessorPlugin::TSP_OK;
-                if (!_suspended && (only_labels.none() || pkt_data->hasAnyLabel(only_labels))) {
-                    // Either no --only-label option or the packet has a specified label => process it.
-                    status = _processor->processPacket(*pkt, *pkt_data);
-                    addPluginPackets(1);
-                }
-                else {
-                    // The plugin is suspended or some --only-label was specified but the packet does
-                    // not have any required label. Pass the packet without submitting it to the plugin.
-                    addNonPluginPackets(1);
-                }
-
-                // Use the returned status
-                switch (status) {
-                    case ProcessorPlugin::TSP_OK:
-                        // Normal case, pass packet
-                        passed_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_NULL:
-                        // Replace the packet with a complete null packet
-                        *pkt = NullPacket;
-                        break;
-                    case ProcessorPlugin::TSP_DROP:
-                        // Drop this packet.
-                        pkt->b[0] = 0;
-                        dropped_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_END:
-                        // Signal end of input to successors and abort
-                        // to predecessors
-                        input_end = aborted = true;
-                        pkt_done--;
-                        pkt_flush--;
-                        pkt_cnt = pkt_done;
-                        break;
-                    default:
-                        // Invalid status, report error and accept packet.
-                        error(u"invalid packet processing status %d", {status});
-                        break;
-                }
-
-                // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
-                if (!was_null && pkt->getPID() == PID_NULL) {
-                    pkt_data->setNullified(true);
-                    nullified_packets++;
-                }
+                // The plugin is suspended or some --only-label was specified but the packet does
+                // not have any required label. Pass the packet without submitting it to the plugin.
+                addNonPluginPackets(1);
+            }
 
-                // If the packet processor has signaled a new bitrate, get it.
-                if (pkt_data->getBitrateChanged()) {
-                    const BitRate new_bitrate = _processor->getBitrate();
-                    if (new_bitrate != 0) {
-                        bitrate_never_modified = false;
-                        output_bitrate = new_bitrate;
-                    }
-                }
+            // Use the returned status
+            switch (status) {
+                case ProcessorPlugin::TSP_OK:
+                    // Normal case, pass packet
+                    _passed_packets++;
+                    break;
+                case ProcessorPlugin::TSP_NULL:
+                    // Replace the packet with a complete null packet
+                    *pkt = NullPacket;
+                    break;
+                case ProcessorPlugin::TSP_DROP:
+                    // Drop this packet.
+                    pkt->b[0] = 0;
+                    _dropped_packets++;
+                    break;
+                case ProcessorPlugin::TSP_END:
+                    // Signal end of input to successors and abort
+                    // to predecessors
+                    _end_of_input = _aborted = true;
+                    pkt_done--;
+                    pkt_flush--;
+                    pkt_cnt = pkt_done;
+                    break;
+                default:
+                    // Invalid status, report error and accept packet.
+                    error(u"invalid packet processing status %d", {status});
+                    break;
             }
 
-            // Do not wait to process pkt_cnt packets before notifying
-            // the next processor. Perform periodic flush to avoid waiting
-            // too long before two output operations.
+            // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
+            if (!was_null && pkt->getPID() == PID_NULL) {
+                pkt_data->setNullified(true);
+                _nullified_packets++;
+            }
 
-            if (pkt_data->getFlush() || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush % _options.max_flush_pkt == 0)) {
-                aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
-                pkt_flush = 0;
+            // If the packet processor has signaled a new bitrate, get it.
+            if (pkt_data->getBitrateChanged()) {
+                const BitRate new_bitrate = _processor->getBitrate();
+                if (new_bitrate != 0) {
+                    _bitrate_never_modified = false;
+                    _output_bitrate = new_bitrate;
+                }
             }
         }
 
-    } while (!input_end && !aborted);
+        // Do not wait to process pkt_cnt packets before notifying
+        // the next processor. Perform periodic flush to avoid waiting
+        // too long before two output operations.
 
-    // Close the packet processor
-    _processor->stop();
+        if (pkt_data->getFlush() || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush % _options.max_flush_pkt == 0)) {
+            _aborted = !passPackets(pkt_flush, _output_bitrate, pkt_done == pkt_cnt && _end_of_input, _aborted);
+            pkt_flush = 0;
+        }
+    }
 
-    debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
-          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+    return _end_of_input || _aborted ? Step::COMPLETED : Step::CONTINUE;
 }
@@ -35,15 +35,17 @@
 #pragma once
 #include "tstspPluginExecutor.h"
 #include "tsProcessorPlugin.h"
+#include "tsTSProcessorPool.h"
 
 namespace ts {
     namespace tsp {
         //!
         //! Execution context of a tsp packet processor plugin.
         //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! The plugin is executed either in its own thread or as a job in a thread pool.
         //! @ingroup plugin
         //!
-        class ProcessorExecutor: public PluginExecutor
+        class ProcessorExecutor: public PluginExecutor, private TSProcessorPool::Job
         {
             TS_NOBUILD_NOCOPY(ProcessorExecutor);
         public:
@@ -55,13 +57,15 @@ namespace ts {
             //! @param [in] attributes Creation attributes for the thread executing this plugin.
             //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
             //! @param [in,out] report Where to report logs.
+            //! @param [in,out] pool Thread pool to execute the plugin. If null, use a dedicated thread.
             //!
             ProcessorExecutor(const TSProcessorArgs& options,
                               const PluginEventHandlerRegistry& handlers,
                               size_t plugin_index,
                               const ThreadAttributes& attributes,
                               Mutex& global_mutex,
-                              Report* report);
+                              Report* report,
+                              TSProcessorPool* pool);
 
             //!
             //! Virtual destructor.
@@ -70,13 +74,41 @@ namespace ts {
 
             // Overridden methods.
             virtual size_t pluginIndex() const override;
+            virtual bool startExecution() override;
+            virtual void waitExecution() override;
+
+        protected:
+            // Overridden methods.
+            virtual void signalWork() override;
 
         private:
-            ProcessorPlugin* _processor;
-            const size_t     _plugin_index;
+            ProcessorPlugin*  _processor;
+            const size_t      _plugin_index;
+            TSProcessorPool*  _pool;       // Thread pool, null if not used.
+            bool              _in_pool;    // The plugin is executed in the pool (set under the global mutex).
+
+            // Processing state, preserved between the steps of a job in the pool.
+            TSPacketMetadata::LabelSet _only_labels;
+            PacketCounter     _passed_packets;
+            PacketCounter     _dropped_packets;
+            PacketCounter     _nullified_packets;
+            BitRate           _output_bitrate;
+            bool              _bitrate_never_modified;
+            bool              _end_of_input;
+            bool              _aborted;
+
+            // Process the next group of packets. When wait is false, return IDLE if there is nothing to do.
+            Step processPackets(bool wait);
+
+            // Prepare and terminate the processing.
+            void startProcessing();
+            void stopProcessing();
 
             // Inherited from Thread
             virtual void main() override;
+
+            // Inherited from TSProcessorPool::Job
+            virtual Step runJob() override;
         };
     }
 }
@@ -100,7 +100,7 @@ bool ts::tsswitch::Core::start()
 
     // Start with the designated first input plugin.
     assert(_opt.firstInput < _inputs.size());
-    _curPlugin = _opt.firstInput;
+    _curPlugin.store(_opt.firstInput, std::memory_order_relaxed);
 
     // Start all input threads (but do not open the input "devices").
     bool success = true;
@@ -116,15 +116,15 @@ bool ts::tsswitch::Core::start()
     else if (_opt.fastSwitch) {
         // Option --fast-switch, start all plugins, they continue to receive in parallel.
         for (size_t i = 0; i < _inputs.size(); ++i) {
-            _inputs[i]->startInput(i == _curPlugin);
+            _inputs[i]->startInput(i == currentInput());
         }
     }
     else {
         // Start the first plugin only.
-        _inputs[_curPlugin]->startInput(true);
+        _inputs[currentInput()]->startInput(true);
 
         // If there is a primary input which is not the first one, start it as well.
-        if (_opt.primaryInput < _inputs.size() && _opt.primaryInput != _curPlugin) {
+        if (_opt.primaryInput < _inputs.size() && _opt.primaryInput != currentInput()) {
             _inputs[_opt.primaryInput]->startInput(false);
         }
     }
@@ -169,13 +169,13 @@ void ts::tsswitch::Core::setInput(size_t index)
 void ts::tsswitch::Core::nextInput()
 {
     Guard lock(_mutex);
-    setInputLocked((_curPlugin + 1) % _inputs.size(), false);
+    setInputLocked((currentInput() + 1) % _inputs.size(), false);
 }
 
 void ts::tsswitch::Core::previousInput()
 {
     Guard lock(_mutex);
-    setInputLocked((_curPlugin > 0 ? _curPlugin : _inputs.size()) - 1, false);
+    setInputLocked((currentInput() > 0 ? currentInput() : _inputs.size()) - 1, false);
 }
 
 
@@ -188,8 +188,8 @@ void ts::tsswitch::Core::setInputLocked(size_t index, bool abortCurrent)
     if (index >= _inputs.size()) {
         _log.warning(u"invalid input index %d", {index});
     }
-    else if (index != _curPlugin) {
-        _log.debug(u"switch input %d to %d", {_curPlugin, index});
+    else if (index != currentInput()) {
+        _log.debug(u"switch input %d to %d", {currentInput(), index});
 
         // The processing depends on the switching mode.
         if (_opt.delayedSwitch) {
@@ -201,16 +201,16 @@ void ts::tsswitch::Core::setInputLocked(size_t index, bool abortCurrent)
                 enqueue(Action(START, index, false));
             }
             enqueue(Action(WAIT_INPUT, index));
-            if (_curPlugin == _opt.primaryInput) {
-                enqueue(Action(NOTIF_CURRENT, _curPlugin, false));
+            if (currentInput() == _opt.primaryInput) {
+                enqueue(Action(NOTIF_CURRENT, currentInput(), false));
             }
             enqueue(Action(SET_CURRENT, index));
             enqueue(Action(NOTIF_CURRENT, index, true));
             enqueue(Action(RESTART_TIMEOUT));
-            if (_curPlugin != _opt.primaryInput) {
-                enqueue(Action(ABORT_INPUT, _curPlugin, abortCurrent));
-                enqueue(Action(STOP, _curPlugin));
-                enqueue(Action(WAIT_STOPPED, _curPlugin));
+            if (currentInput() != _opt.primaryInput) {
+                enqueue(Action(ABORT_INPUT, currentInput(), abortCurrent));
+                enqueue(Action(STOP, currentInput()));
+                enqueue(Action(WAIT_STOPPED, currentInput()));
             }
         }
         else {
@@ -218,13 +218,13 @@ void ts::tsswitch::Core::setInputLocked(size_t index, bool abortCurrent)
             // With --fast-switch, don't start/stop plugins. Just inform the plugin that it is current.
             // The primary input is never stopped (and consequently never restarted).
             enqueue(Action(SUSPEND_TIMEOUT));
-            if (_opt.fastSwitch || _curPlugin == _opt.primaryInput) {
-                enqueue(Action(NOTIF_CURRENT, _curPlugin, false));
+            if (_opt.fastSwitch || currentInput() == _opt.primaryInput) {
+                enqueue(Action(NOTIF_CURRENT, currentInput(), false));
             }
             else {
-                enqueue(Action(ABORT_INPUT, _curPlugin, abortCurrent));
-                enqueue(Action(STOP, _curPlugin));
-                enqueue(Action(WAIT_STOPPED, _curPlugin));
+                enqueue(Action(ABORT_INPUT, currentInput(), abortCurrent));
+                enqueue(Action(STOP, currentInput()));
+                enqueue(Action(WAIT_STOPPED, currentInput()));
             }
             enqueue(Action(SET_CURRENT, index));
             if (_opt.fastSwitch || index == _opt.primaryInput) {
@@ -253,7 +253,7 @@ void ts::tsswitch::Core::handleWatchDogTimeout(WatchDog& watchdog)
     _log.verbose(u"receive timeout, switching to next plugin");
 
     Guard lock(_mutex);
-    setInputLocked((_curPlugin + 1) % _inputs.size(), true);
+    setInputLocked((currentInput() + 1) % _inputs.size(), true);
 }
 
 
@@ -372,7 +372,7 @@ void ts::tsswitch::Core::execute(const Action& event)
                 break;
             }
             case STOP: {
-                if (action.index == _curPlugin) {
+                if (action.index == currentInput()) {
                     // Automatically stop the receive timeout when we stop the current plugin.
                     _receiveWatchDog.suspend();
                 }
@@ -399,7 +399,7 @@ void ts::tsswitch::Core::execute(const Action& event)
                 break;
             }
             case SET_CURRENT: {
-                _curPlugin = action.index;
+                _curPlugin.store(action.index, std::memory_order_relaxed);
                 break;
             }
             case WAIT_STARTED:
@@ -445,12 +445,12 @@ bool ts::tsswitch::Core::getOutputArea(size_t& pluginIndex, TSPacket*& first, TS
             count = 0;
         }
         else {
-            _inputs[_curPlugin]->getOutputArea(first, data, count);
+            _inputs[currentInput()]->getOutputArea(first, data, count);
         }
         // Return when there is something to output in current plugin or the application terminates.
         if (count > 0 || _terminate) {
             // Tell the output plugin which input plugin is used.
-            pluginIndex = _curPlugin;
+            pluginIndex = currentInput();
             // Return false when the application terminates.
             return !_terminate;
         }
@@ -490,7 +490,7 @@ bool ts::tsswitch::Core::inputStarted(size_t pluginIndex, bool success)
     execute(Action(WAIT_STARTED, pluginIndex, success));
 
     // Start the receive timeout, if any, when the current input is started.
-    if (pluginIndex == _curPlugin) {
+    if (pluginIndex == currentInput()) {
         _receiveWatchDog.restart();
     }
 
@@ -508,7 +508,7 @@ bool ts::tsswitch::Core::inputReceived(size_t pluginIndex)
     GuardCondition lock(_mutex, _gotInput);
 
     // Restart the receive timeout, if any, when the current input receives packets.
-    if (pluginIndex == _curPlugin) {
+    if (pluginIndex == currentInput()) {
         _receiveWatchDog.restart();
     }
 
@@ -517,26 +517,26 @@ bool ts::tsswitch::Core::inputReceived(size_t pluginIndex)
 
     // If input is detected on the primary input and the current plugin is not this one
     // after executing all actions, then automatically switch to it.
-    if (pluginIndex == _opt.primaryInput && _curPlugin != _opt.primaryInput) {
+    if (pluginIndex == _opt.primaryInput && currentInput() != _opt.primaryInput) {
         // Remove all pending actions.
         _actions.clear();
         // Define a new set of actions.
         enqueue(Action(SUSPEND_TIMEOUT));
-        enqueue(Action(NOTIF_CURRENT, _curPlugin, false));
+        enqueue(Action(NOTIF_CURRENT, currentInput(), false));
         enqueue(Action(SET_CURRENT, _opt.primaryInput));
         enqueue(Action(NOTIF_CURRENT, _opt.primaryInput, true));
         enqueue(Action(RESTART_TIMEOUT));
         if (!_opt.fastSwitch) {
-            enqueue(Action(ABORT_INPUT, _curPlugin, true));
-            enqueue(Action(STOP, _curPlugin));
-            enqueue(Action(WAIT_STOPPED, _curPlugin));
+            enqueue(Action(ABORT_INPUT, currentInput(), true));
+            enqueue(Action(STOP, currentInput()));
+            enqueue(Action(WAIT_STOPPED, currentInput()));
         }
         // Execute actions.
         execute();
-        assert(_curPlugin == _opt.primaryInput);
+        assert(currentInput() == _opt.primaryInput);
     }
 
-    if (pluginIndex == _curPlugin) {
+    if (pluginIndex == currentInput()) {
         // Wake up output plugin if it is sleeping, waiting for packets to output.
         lock.signal();
     }
@@ -561,11 +561,11 @@ bool ts::tsswitch::Core::inputStopped(size_t pluginIndex, bool success)
 
         // Count end of cycle when the last plugin terminates.
         if (pluginIndex == _inputs.size() - 1) {
-            _curCycle++;
+            _curCycle.store(currentCycle() + 1, std::memory_order_relaxed);
         }
 
         // Check if the complete processing is terminated.
-        stopRequest = _opt.terminate || (_opt.cycleCount > 0 && _curCycle >= _opt.cycleCount);
+        stopRequest = _opt.terminate || (_opt.cycleCount > 0 && currentCycle() >= _opt.cycleCount);
 
         if (stopRequest) {
             // Need to stop now. Remove any further action, except waiting for termination.
@@ -573,9 +573,9 @@ bool ts::tsswitch::Core::inputStopped(size_t pluginIndex, bool success)
             // Do not trigger receive timeout while terminating.
             enqueue(Action(SUSPEND_TIMEOUT), true);
         }
-        else if (pluginIndex == _curPlugin && _actions.empty()) {
+        else if (pluginIndex == currentInput() && _actions.empty()) {
             // The current plugin terminates and there is nothing else to execute, move to next plugin.
-            const size_t next = (_curPlugin + 1) % _inputs.size();
+            const size_t next = (currentInput() + 1) % _inputs.size();
             enqueue(Action(SUSPEND_TIMEOUT));
             enqueue(Action(SET_CURRENT, next));
             if (_opt.fastSwitch) {
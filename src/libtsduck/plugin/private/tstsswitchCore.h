@@ -99,6 +99,32 @@ namespace ts {
             //!
             void previousInput();
 
+            //!
+            //! Get the index of the current input plugin.
+            //! The value is read without locking and is suitable for monitoring only.
+            //! @return The index of the current input plugin.
+            //!
+            size_t currentInput() const { return _curPlugin.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the current input cycle number.
+            //! The value is read without locking and is suitable for monitoring only.
+            //! @return The current input cycle number.
+            //!
+            size_t currentCycle() const { return _curCycle.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the input plugin executors.
+            //! @return A constant reference to the vector of input plugin executors.
+            //!
+            const InputExecutorVector& inputs() const { return _inputs; }
+
+            //!
+            //! Get the output plugin executor.
+            //! @return A constant reference to the output plugin executor.
+            //!
+            const OutputExecutor& output() const { return _output; }
+
             //!
             //! Called by an input plugin when it started an input session.
             //! @param [in] pluginIndex Index of the input plugin.
@@ -191,8 +217,8 @@ namespace ts {
             WatchDog            _receiveWatchDog; // Handle reception timeout.
             Mutex               _mutex;           // Global mutex, protect access to all subsequent fields.
             Condition           _gotInput;        // Signaled each time an input plugin reports new packets.
-            size_t              _curPlugin;       // Index of current input plugin.
-            size_t              _curCycle;        // Current input cycle number.
+            std::atomic<size_t> _curPlugin;       // Index of current input plugin (also read without lock by the metrics server).
+            std::atomic<size_t> _curCycle;        // Current input cycle number (also read without lock by the metrics server).
             volatile bool       _terminate;       // Terminate complete processing.
             ActionQueue         _actions;         // Sequential queue list of actions to execute.
             ActionSet           _events;          // Pending events, waiting to be cleared.
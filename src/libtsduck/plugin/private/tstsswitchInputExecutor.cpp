@@ -59,10 +59,19 @@ ts::tsswitch::InputExecutor::InputExecutor(const InputSwitcherArgs& opt,
     _terminated(false),
     _outFirst(0),
     _outCount(0),
-    _start_time(true) // initialized with current system time
+    _start_time(true), // initialized with current system time
+    _ccAnalyzer(),
+    _ccErrors(0)
 {
     // Make sure that the input plugins display their index.
     setLogName(UString::Format(u"%s[%d]", {pluginName(), _pluginIndex}));
+
+    // The continuity analyzer is large (one context per PID), allocate it only when used.
+    // Only errors are counted, don't keep a copy of the last packet in each PID.
+    if (opt.metricsServer.hasPort()) {
+        _ccAnalyzer = new ContinuityAnalyzer(AllPIDs);
+        _ccAnalyzer->setDuplicateDetection(false);
+    }
 }
 
 ts::tsswitch::InputExecutor::~InputExecutor()
@@ -155,7 +164,7 @@ void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMe
     GuardCondition lock(_mutex, _todo);
     first = &_buffer[_outFirst];
     data = &_metadata[_outFirst];
-    count = std::min(_outCount, _buffer.size() - _outFirst);
+    count = std::min(_outCount.load(std::memory_order_relaxed), _buffer.size() - _outFirst);
     _outputInUse = count > 0;
     lock.signal();
 }
@@ -169,9 +178,9 @@ void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMe
 void ts::tsswitch::InputExecutor::freeOutput(size_t count)
 {
     GuardCondition lock(_mutex, _todo);
-    assert(count <= _outCount);
+    assert(count <= _outCount.load(std::memory_order_relaxed));
     _outFirst = (_outFirst + count) % _buffer.size();
-    _outCount -= count;
+    _outCount.store(_outCount.load(std::memory_order_relaxed) - count, std::memory_order_relaxed);
     _outputInUse = false;
     lock.signal();
 }
@@ -194,7 +203,7 @@ void ts::tsswitch::InputExecutor::main()
             GuardCondition lock(_mutex, _todo);
             // Reset input buffer.
             _outFirst = 0;
-            _outCount = 0;
+            _outCount.store(0, std::memory_order_relaxed);
             // Wait for start or terminate.
             while (!_startRequest && !_terminated) {
                 lock.waitCondition();
@@ -209,6 +218,10 @@ void ts::tsswitch::InputExecutor::main()
         }
 
         // Here, we need to start an input session.
+        // The continuity of the previous session is not related to the new one.
+        if (!_ccAnalyzer.isNull()) {
+            _ccAnalyzer->reset();
+        }
         debug(u"starting input plugin");
         const bool started = _input->start();
         debug(u"input plugin started, status: %s", {started});
@@ -232,7 +245,7 @@ void ts::tsswitch::InputExecutor::main()
             {
                 // Wait for free buffer or stop.
                 GuardCondition lock(_mutex, _todo);
-                while (_outCount >= _buffer.size() && !_stopRequest && !_terminated) {
+                while (_outCount.load(std::memory_order_relaxed) >= _buffer.size() && !_stopRequest && !_terminated) {
                     if (_isCurrent || !_opt.fastSwitch) {
                         // This is the current input, we must not lose packet.
                         // Wait for the output thread to free some packets.
@@ -243,9 +256,9 @@ void ts::tsswitch::InputExecutor::main()
                         // Drop older packets, free at most --max-input-packets.
                         assert(_outFirst < _buffer.size());
                         const size_t freeCount = std::min(_opt.maxInputPackets, _buffer.size() - _outFirst);
-                        assert(freeCount <= _outCount);
+                        assert(freeCount <= _outCount.load(std::memory_order_relaxed));
                         _outFirst = (_outFirst + freeCount) % _buffer.size();
-                        _outCount -= freeCount;
+                        _outCount.store(_outCount.load(std::memory_order_relaxed) - freeCount, std::memory_order_relaxed);
                     }
                 }
                 // Exit input when termination is requested.
@@ -254,8 +267,8 @@ void ts::tsswitch::InputExecutor::main()
                 }
                 // There is some free buffer, compute first index and size of receive area.
                 // The receive area is limited by end of buffer and max input size.
-                inFirst = (_outFirst + _outCount) % _buffer.size();
-                inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - _outCount, _buffer.size() - inFirst));
+                inFirst = (_outFirst + _outCount.load(std::memory_order_relaxed)) % _buffer.size();
+                inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - _outCount.load(std::memory_order_relaxed), _buffer.size() - inFirst));
             }
 
             assert(inFirst < _buffer.size());
@@ -274,6 +287,13 @@ void ts::tsswitch::InputExecutor::main()
             }
             addPluginPackets(inCount);
 
+            // Continuity analysis of the input packets, for the metrics server only.
+            if (!_ccAnalyzer.isNull()) {
+                const PacketCounter previous = _ccAnalyzer->errorCount();
+                _ccAnalyzer->feedPackets(&_buffer[inFirst], inCount);
+                _ccErrors.store(_ccErrors.load(std::memory_order_relaxed) + _ccAnalyzer->errorCount() - previous, std::memory_order_relaxed);
+            }
+
             // Fill input time stamps with monotonic clock if none was provided by the input plugin.
             // Only check the first returned packet. Assume that the input plugin generates time stamps for all or none.
             if (!_metadata[inFirst].hasInputTimeStamp()) {
@@ -286,7 +306,7 @@ void ts::tsswitch::InputExecutor::main()
             // Signal the presence of received packets.
             {
                 Guard lock(_mutex);
-                _outCount += inCount;
+                _outCount.store(_outCount.load(std::memory_order_relaxed) + inCount, std::memory_order_relaxed);
             }
             _core.inputReceived(_pluginIndex);
         }
@@ -296,13 +316,13 @@ void ts::tsswitch::InputExecutor::main()
             // Wait for the output plugin to release the buffer.
             // In case of normal end of input (no stop, no terminate), wait for all output to be gone.
             GuardCondition lock(_mutex, _todo);
-            while (_outputInUse || (_outCount > 0 && !_stopRequest && !_terminated)) {
+            while (_outputInUse || (_outCount.load(std::memory_order_relaxed) > 0 && !_stopRequest && !_terminated)) {
                 debug(u"input terminated, waiting for output plugin to release the buffer");
                 lock.waitCondition();
             }
             // And reset the output part of the buffer.
             _outFirst = 0;
-            _outCount = 0;
+            _outCount.store(0, std::memory_order_relaxed);
         }
 
         // End of input session.
@@ -39,6 +39,7 @@
 #include "tsMutex.h"
 #include "tsCondition.h"
 #include "tsMonotonic.h"
+#include "tsContinuityAnalyzer.h"
 
 namespace ts {
     namespace tsswitch {
@@ -120,6 +121,27 @@ namespace ts {
             //!
             void freeOutput(size_t count);
 
+            //!
+            //! Get the number of packets in the buffer, waiting to be output.
+            //! The value is read without locking and is suitable for monitoring only.
+            //! @return The number of packets in the buffer.
+            //!
+            size_t bufferedPackets() const { return _outCount.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the number of continuity errors in the input packets.
+            //! The continuity counters are checked only when the metrics server is active.
+            //! The value is read without locking and is suitable for monitoring only.
+            //! @return The number of continuity errors in all input sessions.
+            //!
+            PacketCounter continuityErrors() const { return _ccErrors.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the size of the packet buffer.
+            //! @return The size of the packet buffer in packets.
+            //!
+            size_t bufferSize() const { return _buffer.size(); }
+
             // Implementation of TSP.
             virtual size_t pluginIndex() const override;
 
@@ -136,8 +158,10 @@ namespace ts {
             bool                     _stopRequest;   // Stop input requested.
             bool                     _terminated;    // Terminate thread.
             size_t                   _outFirst;      // Index of first packet to output in _buffer.
-            size_t                   _outCount;      // Number of packets to output, not always contiguous, may wrap up.
+            std::atomic<size_t>      _outCount;      // Number of packets to output, not always contiguous, may wrap up.
             Monotonic                _start_time;    // Creation time in a monotonic clock.
+            SafePtr<ContinuityAnalyzer, NullMutex> _ccAnalyzer;  // Continuity analysis (allocated with --metrics only).
+            std::atomic<PacketCounter> _ccErrors;    // Number of continuity errors, read by the metrics server.
 
             // Implementation of Thread.
             virtual void main() override;
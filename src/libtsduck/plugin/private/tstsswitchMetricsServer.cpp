@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tstsswitchMetricsServer.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tsswitch::MetricsServer::MetricsServer(const Core& core, const InputSwitcherArgs& opt, Report& log) :
+    OpenMetricsServer(opt.metricsServer, log),
+    _core(core),
+    _labels()
+{
+    const InputExecutorVector& inputs(_core.inputs());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        _labels.push_back(Label(u"index", UString::Decimal(i, 0, true, UString())) + u"," + Label(u"name", inputs[i]->pluginName()));
+    }
+}
+
+ts::tsswitch::MetricsServer::~MetricsServer()
+{
+    // Terminate the thread before destructing the subclass.
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Build all metrics, invoked in the context of the server thread.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::MetricsServer::buildMetrics(UString& text)
+{
+    const InputExecutorVector& inputs(_core.inputs());
+
+    AddFamily(text, u"tsswitch_current_input", u"gauge", u"Index of the current input plugin");
+    AddSample(text, u"tsswitch_current_input", UString(), _core.currentInput());
+
+    AddFamily(text, u"tsswitch_input_cycle", u"gauge", u"Current input cycle number");
+    AddSample(text, u"tsswitch_input_cycle", UString(), _core.currentCycle());
+
+    AddFamily(text, u"tsswitch_input_current", u"gauge", u"The input plugin is the current one");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        AddSample(text, u"tsswitch_input_current", _labels[i], i == _core.currentInput());
+    }
+
+    AddFamily(text, u"tsswitch_input_packets", u"counter", u"Packets which were received by the input plugin");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        AddSample(text, u"tsswitch_input_packets_total", _labels[i], inputs[i]->pluginPackets());
+    }
+
+    AddFamily(text, u"tsswitch_input_continuity_errors", u"counter", u"Continuity errors in packets from the input plugin");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        AddSample(text, u"tsswitch_input_continuity_errors_total", _labels[i], inputs[i]->continuityErrors());
+    }
+
+    AddFamily(text, u"tsswitch_input_buffer_packets", u"gauge", u"Packets in the buffer of the input plugin, waiting to be output", u"packets");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        AddSample(text, u"tsswitch_input_buffer_packets", _labels[i], inputs[i]->bufferedPackets());
+    }
+
+    AddFamily(text, u"tsswitch_input_buffer_size_packets", u"gauge", u"Size of the buffer of the input plugin", u"packets");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        AddSample(text, u"tsswitch_input_buffer_size_packets", _labels[i], inputs[i]->bufferSize());
+    }
+
+    AddFamily(text, u"tsswitch_output_packets", u"counter", u"Packets which were sent by the output plugin");
+    AddSample(text, u"tsswitch_output_packets_total", UString(), _core.output().pluginPackets());
+}
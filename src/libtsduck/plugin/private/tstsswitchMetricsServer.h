@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Input switch (tsswitch) OpenMetrics server.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsOpenMetricsServer.h"
+#include "tsInputSwitcherArgs.h"
+#include "tstsswitchCore.h"
+
+namespace ts {
+    namespace tsswitch {
+        //!
+        //! Input switch (tsswitch) OpenMetrics server.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //!
+        //! The counters of the plugin executors and the state of the core are read without
+        //! locking. They are updated by the plugin threads only and a scrape may see values
+        //! which are slightly late, which is acceptable for monitoring.
+        //!
+        //! @ingroup plugin
+        //!
+        class MetricsServer : public OpenMetricsServer
+        {
+            TS_NOBUILD_NOCOPY(MetricsServer);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] core Command processor core.
+            //! @param [in] opt Command line options.
+            //! @param [in,out] log Log report.
+            //!
+            MetricsServer(const Core& core, const InputSwitcherArgs& opt, Report& log);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~MetricsServer() override;
+
+        protected:
+            // Implementation of OpenMetricsServer.
+            virtual void buildMetrics(UString& text) override;
+
+        private:
+            const Core&   _core;
+            UStringVector _labels;  // Labels of each input plugin.
+        };
+    }
+}
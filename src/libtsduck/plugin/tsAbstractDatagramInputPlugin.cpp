@@ -109,6 +109,11 @@ bool ts::AbstractDatagramInputPlugin::isRealTime()
     return true;
 }
 
+ts::TSPacketMetadata::LabelSet ts::AbstractDatagramInputPlugin::datagramLabels() const
+{
+    return TSPacketMetadata::LabelSet();
+}
+
 
 //----------------------------------------------------------------------------
 // Input command line options method
@@ -215,9 +220,14 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
                     break;
             }
 
-            // Build time stamps in packet metadata.
+            // Labels of the packets from this datagram.
+            const TSPacketMetadata::LabelSet labels(datagramLabels());
+
+            // Build time stamps and labels in packet metadata.
             _mdata_next = 0;
             for (size_t i = 0; i < _inbuf_count; ++i) {
+                _mdata[i].clearAllLabels();
+                _mdata[i].setLabels(labels);
                 if (use_rtp) {
                     // RTP time stamp unit is 90 kHz (RTP_RATE_MP2T)
                     _mdata[i].setInputTimeStamp(rtp_timestamp, RTP_RATE_MP2T, TimeSource::RTP);
@@ -87,6 +87,15 @@ namespace ts {
         //!
         virtual bool receiveDatagram(void* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) = 0;
 
+        //!
+        //! Get the labels to set on all TS packets of the last received datagram.
+        //! Invoked after each successful receiveDatagram(). The default implementation
+        //! returns no label. Can be overridden by subclasses which receive datagrams
+        //! from several sources.
+        //! @return The set of labels to set on the TS packets of the last datagram.
+        //!
+        virtual TSPacketMetadata::LabelSet datagramLabels() const;
+
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
         enum TimePriority {RTP_SYSTEM_TSP, SYSTEM_RTP_TSP, RTP_TSP, SYSTEM_TSP, TSP_ONLY};
@@ -53,7 +53,9 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
     _reopen(false),
     _retry_interval(DEF_RETRY_INTERVAL),
     _retry_max(0),
-    _file()
+    _async(false),
+    _file(),
+    _async_file()
 {
     option(u"", 0, STRING, 0, 1);
     help(u"", u"Name of the created output file. Use standard output by default.");
@@ -61,14 +63,59 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
     option(u"append", 'a');
     help(u"append", u"If the file already exists, append to the end of the file. By default, existing files are overwritten.");
 
+    option(u"asynchronous");
+    help(u"asynchronous",
+         u"Write the file asynchronously. The packets are copied into a queue of large memory buffers "
+         u"which are written to disk by a background thread. Thus, the chain of plugins is not blocked "
+         u"by slow disk operations, as long as the queue is not full. "
+         u"All options --buffer-size, --direct-io, --max-duration, --max-size, --preallocate "
+         u"and --queue-depth imply --asynchronous. "
+         u"With --reopen-on-error, the packets which are queued when a write error occurs are lost.");
+
+    option(u"buffer-size", 0, POSITIVE);
+    help(u"buffer-size", u"bytes",
+         u"Size in bytes of each buffer in asynchronous mode. "
+         u"The default is " + UString::Decimal(TSFileOutputAsync::DEFAULT_BUFFER_SIZE) + u" bytes.");
+
+    option(u"direct-io");
+    help(u"direct-io",
+         u"Write the file using direct I/O, bypassing the system cache, in asynchronous mode. "
+         u"On high-bitrate recorders, this avoids stalls when the system flushes large amounts of "
+         u"cached data. Linux only, ignored on other systems or on file systems which do not support direct I/O.");
+
     option(u"format", 0, TSPacketFormatEnum);
     help(u"format", u"name",
          u"Specify the format of the created file. "
          u"By default, the format is a standard TS file.");
 
+    option(u"max-duration", 0, POSITIVE);
+    help(u"max-duration", u"seconds",
+         u"Specify a maximum duration in seconds of each output file. "
+         u"When the duration is reached, the file is closed and a new one is created. "
+         u"The name of each file is built from the specified file name with a suffix "
+         u"-YYYYMMDD-hhmmss before the extension, based on the local time of creation of the file. "
+         u"The files are closed and created by the writer thread in asynchronous mode.");
+
+    option(u"max-size", 0, POSITIVE);
+    help(u"max-size", u"bytes",
+         u"Specify a maximum size in bytes of each output file. "
+         u"When the size is reached, the file is closed and a new one is created. "
+         u"See option --max-duration for the naming of files.");
+
     option(u"keep", 'k');
     help(u"keep", u"Keep existing file (abort if the specified file already exists). By default, existing files are overwritten.");
 
+    option(u"preallocate", 0, POSITIVE);
+    help(u"preallocate", u"bytes",
+         u"In asynchronous mode, preallocate disk space in the output file by chunks of the specified size. "
+         u"This reduces fragmentation and file system metadata updates during long recordings. "
+         u"Unused preallocated space is released when the file is closed. Linux only, ignored on other systems.");
+
+    option(u"queue-depth", 0, POSITIVE);
+    help(u"queue-depth",
+         u"Number of buffers in asynchronous mode. "
+         u"The default is " + UString::Decimal(TSFileOutputAsync::DEFAULT_QUEUE_DEPTH) + u".");
+
     option(u"reopen-on-error", 'r');
     help(u"reopen-on-error",
          u"In case of write error, close the file and try to reopen it several times. "
@@ -107,6 +154,22 @@ bool ts::FileOutputPlugin::getOptions()
     _retry_max = intValue<size_t>(u"max-retry", 0);
     _retry_interval = intValue<MilliSecond>(u"retry-interval", DEF_RETRY_INTERVAL);
     _file_format = enumValue<TSPacketFormat>(u"format", TSPacketFormat::TS);
+
+    // Asynchronous mode.
+    _async = present(u"asynchronous") || present(u"buffer-size") || present(u"direct-io") || present(u"max-duration") ||
+             present(u"max-size") || present(u"preallocate") || present(u"queue-depth");
+    if (present(u"direct-io")) {
+        _flags |= TSFile::DIRECT;
+    }
+    if (_async && _name.empty() && (present(u"max-duration") || present(u"max-size"))) {
+        tsp->error(u"--max-duration and --max-size require an output file name");
+        return false;
+    }
+    _async_file.setBufferSize(intValue<size_t>(u"buffer-size", TSFileOutputAsync::DEFAULT_BUFFER_SIZE));
+    _async_file.setQueueDepth(intValue<size_t>(u"queue-depth", TSFileOutputAsync::DEFAULT_QUEUE_DEPTH));
+    _async_file.setPreallocation(intValue<uint64_t>(u"preallocate", 0));
+    _async_file.setMaxFileSize(intValue<uint64_t>(u"max-size", 0));
+    _async_file.setMaxFileDuration(intValue<MilliSecond>(u"max-duration", 0) * MilliSecPerSec);
     return true;
 }
 
@@ -118,7 +181,12 @@ bool ts::FileOutputPlugin::start()
 
 bool ts::FileOutputPlugin::stop()
 {
-    return _file.close(*tsp);
+    return closeFile(*tsp);
+}
+
+bool ts::FileOutputPlugin::closeFile(Report& report)
+{
+    return _async ? _async_file.close(report) : _file.close(report);
 }
 
 bool ts::FileOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
@@ -127,11 +195,14 @@ bool ts::FileOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata*
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     bool done_once = false;
 
+    // In asynchronous mode, packets are only queued, a write error is reported on a subsequent call.
+    TSPacketStream& stream(_async ? static_cast<TSPacketStream&>(_async_file) : _file);
+
     for (;;) {
 
         // Write some packets.
-        const PacketCounter where = _file.writePacketsCount();
-        const bool success = _file.writePackets(buffer, pkt_data, packet_count, *tsp);
+        const PacketCounter where = stream.writePacketsCount();
+        const bool success = stream.writePackets(buffer, pkt_data, packet_count, *tsp);
 
         // In case of success or no retry, return now.
         if (success || !_reopen || tsp->aborting()) {
@@ -139,13 +210,13 @@ bool ts::FileOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata*
         }
 
         // Update counters of actually written packets.
-        const size_t written = std::min(size_t(_file.writePacketsCount() - where), packet_count);
+        const size_t written = std::min(size_t(stream.writePacketsCount() - where), packet_count);
         buffer += written;
         pkt_data += written;
         packet_count -= written;
 
         // Close the file and try to reopen it a number of times.
-        _file.close(NULLREP);
+        closeFile(NULLREP);
 
         // Reopen multiple times. Wait before open only when we already waited and reopened.
         if (!openAndRetry(done_once, retry_allowed)) {
@@ -174,7 +245,7 @@ bool ts::FileOutputPlugin::openAndRetry(bool initial_wait, size_t& retry_allowed
 
         // Try to open the file.
         tsp->debug(u"opening output file %s", {_name});
-        const bool success = _file.open(_name, _flags, *tsp, _file_format);
+        const bool success = _async ? _async_file.open(_name, _flags, *tsp, _file_format) : _file.open(_name, _flags, *tsp, _file_format);
 
         // Update remaining open count.
         if (retry_allowed > 0) {
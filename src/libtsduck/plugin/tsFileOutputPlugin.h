@@ -35,6 +35,7 @@
 #pragma once
 #include "tsOutputPlugin.h"
 #include "tsTSFile.h"
+#include "tsTSFileOutputAsync.h"
 
 namespace ts {
     //!
@@ -69,10 +70,15 @@ namespace ts {
         bool              _reopen;
         MilliSecond       _retry_interval;
         size_t            _retry_max;
+        bool              _async;
         TSFile            _file;
+        TSFileOutputAsync _async_file;
 
         // Open the file, retry on error if necessary.
         // Use max number of retries. Updated with remaining number of retries.
         bool openAndRetry(bool initial_wait, size_t& retry_allowed);
+
+        // Close the synchronous or asynchronous file.
+        bool closeFile(Report& report);
     };
 }
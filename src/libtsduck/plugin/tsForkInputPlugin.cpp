@@ -53,7 +53,11 @@ ts::ForkInputPlugin::ForkInputPlugin(TSP* tsp_) :
     help(u"", u"Specifies the command line to execute in the created process.");
 
     option(u"buffered-packets", 'b', POSITIVE);
-    help(u"buffered-packets", u"Windows only: Specifies the pipe buffer size in number of TS packets.");
+    help(u"buffered-packets",
+         u"Windows and Linux only: Specifies the pipe buffer size in number of TS packets. "
+         u"On Linux, the default pipe buffer size is " + UString::Decimal(DEFAULT_PIPE_SIZE) + u" bytes "
+         u"(or the maximum allowed size if lower). A large pipe buffer reduces the number of context "
+         u"switches with the created process at high bitrates.");
 
     option(u"format", 0, TSPacketFormatEnum);
     help(u"format", u"name",
@@ -88,7 +92,7 @@ bool ts::ForkInputPlugin::start()
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only, zero meaning default).
+                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows and Linux, zero meaning default).
                       *tsp,                     // Error reporting.
                       ForkPipe::STDOUT_PIPE,    // Output: send stdout to pipe, keep same stderr as tsp.
                       ForkPipe::STDIN_NONE,     // Input: null device (do not use the same stdin as tsp).
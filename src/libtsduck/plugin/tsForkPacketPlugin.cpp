@@ -60,7 +60,9 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
          u"Specifies the number of TS packets to buffer before sending them through "
          u"the pipe to the forked process. When set to zero, the packets are not "
          u"buffered and sent one by one. The default is 500 packets in real-time mode "
-         u"and 1000 packets in offline mode.");
+         u"and 1000 packets in offline mode. On Windows and Linux, the pipe buffer size "
+         u"is the size of this buffer, with a minimum of " + UString::Decimal(DEFAULT_PIPE_SIZE) + u" bytes "
+         u"(on Linux, or the maximum allowed size if lower).");
 
     option(u"format", 0, TSPacketFormatEnum);
     help(u"format", u"name",
@@ -107,7 +109,7 @@ bool ts::ForkPacketPlugin::start()
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only), same as internal buffer size.
+                      std::max(DEFAULT_PIPE_SIZE, PKT_SIZE * _buffer_size),  // Pipe buffer size (Windows and Linux).
                       *tsp,                     // Error reporting.
                       ForkPipe::KEEP_BOTH,      // Output: same stdout and stderr as tsp process.
                       ForkPipe::STDIN_PIPE,     // Input: use the pipe.
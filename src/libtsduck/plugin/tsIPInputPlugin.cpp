@@ -44,9 +44,13 @@ const int ts::IPInputPlugin::REFERENCE = 0;
 //----------------------------------------------------------------------------
 
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
-    AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
+    AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port ...",
                                 u"kernel", u"A kernel-provided time-stamp for the packet, when available (Linux only)"),
-    _sock(*tsp_)
+    _sock(*tsp_, true, true, true),
+    _more_socks(),
+    _pollfds(),
+    _next_poll(0),
+    _labels()
 {
     // Add UDP receiver common options.
     _sock.defineArgs(*this);
@@ -59,8 +63,20 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
 
 bool ts::IPInputPlugin::getOptions()
 {
-    // Get command line arguments for superclass and socket.
-    return AbstractDatagramInputPlugin::getOptions() && _sock.loadArgs(duck, *this);
+    // Get command line arguments for superclass and first socket.
+    bool ok = AbstractDatagramInputPlugin::getOptions() && _sock.loadArgs(duck, *this);
+
+    // Additional destinations use the same options.
+    _more_socks.clear();
+    for (size_t i = 1; ok && i < _sock.destinationCount(); ++i) {
+        UDPReceiverPtr sock(new UDPReceiver(*tsp, true, true, true));
+        ok = sock->loadArgs(duck, *this, i);
+        _more_socks.push_back(sock);
+    }
+    if (ok && _sock.destinationCount() > TSPacketMetadata::LABEL_COUNT) {
+        tsp->warning(u"%d destinations, only the first %d ones are identified by a packet label", {_sock.destinationCount(), TSPacketMetadata::LABEL_COUNT});
+    }
+    return ok;
 }
 
 
@@ -70,8 +86,29 @@ bool ts::IPInputPlugin::getOptions()
 
 bool ts::IPInputPlugin::start()
 {
-    // Initialize superclass and UDP socket.
-    return AbstractDatagramInputPlugin::start() && _sock.open(*tsp);
+    // Initialize superclass and UDP sockets.
+    bool ok = AbstractDatagramInputPlugin::start();
+    for (size_t i = 0; ok && i <= _more_socks.size(); ++i) {
+        ok = socket(i).open(*tsp);
+    }
+
+    // With several sockets, build the list of poll descriptors.
+    _pollfds.clear();
+    _next_poll = 0;
+    _labels.reset();
+    if (ok && !_more_socks.empty()) {
+        _pollfds.resize(_more_socks.size() + 1);
+        for (size_t i = 0; i < _pollfds.size(); ++i) {
+            TS_ZERO(_pollfds[i]);
+            _pollfds[i].fd = socket(i).getSocket();
+            _pollfds[i].events = POLLIN;
+        }
+        tsp->verbose(u"receiving %d destinations, packets from destination #n get label n-1", {_pollfds.size()});
+    }
+    if (!ok) {
+        closeAll();
+    }
+    return ok;
 }
 
 
@@ -81,7 +118,7 @@ bool ts::IPInputPlugin::start()
 
 bool ts::IPInputPlugin::stop()
 {
-    _sock.close(*tsp);
+    closeAll();
     return AbstractDatagramInputPlugin::stop();
 }
 
@@ -92,11 +129,23 @@ bool ts::IPInputPlugin::stop()
 
 bool ts::IPInputPlugin::abortInput()
 {
-    _sock.close(*tsp);
+    closeAll();
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Close all sockets.
+//----------------------------------------------------------------------------
+
+void ts::IPInputPlugin::closeAll()
+{
+    for (size_t i = 0; i <= _more_socks.size(); ++i) {
+        socket(i).close(*tsp);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Set receive timeout from tsp.
 //----------------------------------------------------------------------------
@@ -104,7 +153,9 @@ bool ts::IPInputPlugin::abortInput()
 bool ts::IPInputPlugin::setReceiveTimeout(MilliSecond timeout)
 {
     if (timeout > 0) {
-        _sock.setReceiveTimeoutArg(timeout);
+        for (size_t i = 0; i <= _more_socks.size(); ++i) {
+            socket(i).setReceiveTimeoutArg(timeout);
+        }
     }
     return true;
 }
@@ -118,5 +169,67 @@ bool ts::IPInputPlugin::receiveDatagram(void* buffer, size_t buffer_size, size_t
 {
     SocketAddress sender;
     SocketAddress destination;
-    return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp, &timestamp);
+
+    // Simple case, only one socket.
+    if (_pollfds.empty()) {
+        return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp, &timestamp);
+    }
+
+    // Several sockets, all sockets are checked in one poll() call. All sockets which
+    // were reported as ready are read, in turn, before polling again. A readiness
+    // indication guarantees only one datagram: exactly one datagram is read per ready
+    // socket. If it is rejected by the socket filters (source, destination), we move
+    // to the next ready socket or poll() again instead of blocking on this socket.
+    for (;;) {
+        for (size_t n = 0; n < _pollfds.size(); ++n) {
+            const size_t index = (_next_poll + n) % _pollfds.size();
+            if (_pollfds[index].revents != 0) {
+                _pollfds[index].revents = 0;
+                _next_poll = index + 1;
+                bool accepted = false;
+                if (!socket(index).receiveOne(buffer, buffer_size, ret_size, sender, destination, accepted, tsp, *tsp, &timestamp)) {
+                    return false;
+                }
+                else if (accepted) {
+                    _labels.reset();
+                    if (index < _labels.size()) {
+                        _labels.set(index);
+                    }
+                    return true;
+                }
+            }
+        }
+
+        // No more ready socket, wait for new datagrams.
+        const MilliSecond timeout = _sock.receiveTimeout();
+        const int count = TS_SOCKET_POLL(_pollfds.data(), _pollfds.size(), timeout < 0 ? -1 : int(timeout));
+        if (tsp->aborting()) {
+            return false;
+        }
+        else if (count == 0) {
+            tsp->error(u"receive timeout on %d destinations", {_pollfds.size()});
+            return false;
+        }
+        else if (count < 0) {
+            const SocketErrorCode err = LastSocketErrorCode();
+#if defined(TS_UNIX)
+            if (err == EINTR) {
+                // Interrupted by a signal, retry.
+                continue;
+            }
+#endif
+            tsp->error(u"error waiting for UDP datagrams: %s", {SocketErrorCodeMessage(err)});
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Labels to set on packets of the last datagram.
+//----------------------------------------------------------------------------
+
+ts::TSPacketMetadata::LabelSet ts::IPInputPlugin::datagramLabels() const
+{
+    return _labels;
 }
@@ -66,8 +66,21 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(void* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) override;
+        virtual TSPacketMetadata::LabelSet datagramLabels() const override;
 
     private:
-        UDPReceiver _sock; // Incoming socket with associated command line options.
+        typedef SafePtr<UDPReceiver, NullMutex> UDPReceiverPtr;
+
+        UDPReceiver                     _sock;       // Incoming socket with associated command line options.
+        std::vector<UDPReceiverPtr>     _more_socks; // Additional sockets, one per additional destination.
+        std::vector<TS_SOCKET_POLLFD_T> _pollfds;    // Poll descriptors of all sockets, when there are several ones.
+        size_t                          _next_poll;  // Next socket to check in _pollfds.
+        TSPacketMetadata::LabelSet      _labels;     // Labels of last received datagram.
+
+        // Get the socket for a destination index.
+        UDPReceiver& socket(size_t index) { return index == 0 ? _sock : *_more_socks[index - 1]; }
+
+        // Close all sockets.
+        void closeAll();
     };
 }
@@ -31,6 +31,7 @@
 #include "tsSystemMonitor.h"
 #include "tstsswitchCore.h"
 #include "tstsswitchCommandListener.h"
+#include "tstsswitchMetricsServer.h"
 TSDUCK_SOURCE;
 
 
@@ -63,6 +64,12 @@ ts::InputSwitcher::InputSwitcher(const InputSwitcherArgs& args, Report& report)
         return; // error
     }
 
+    // If a metrics server is specified, start an HTTP server thread.
+    tsswitch::MetricsServer metrics(core, args, report);
+    if (args.metricsServer.hasPort() && !metrics.open()) {
+        return; // error
+    }
+
     // Start the processing.
     if (!core.start()) {
         return; // error
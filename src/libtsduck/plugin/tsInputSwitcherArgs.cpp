@@ -62,6 +62,7 @@ ts::InputSwitcherArgs::InputSwitcherArgs() :
     sockBuffer(0),
     remoteServer(),
     allowedRemote(),
+    metricsServer(),
     receiveTimeout(0),
     inputs(),
     output()
@@ -84,6 +85,7 @@ ts::InputSwitcherArgs::InputSwitcherArgs(const InputSwitcherArgs& other) :
     sockBuffer(other.sockBuffer),
     remoteServer(other.remoteServer),
     allowedRemote(other.allowedRemote),
+    metricsServer(other.metricsServer),
     receiveTimeout(other.receiveTimeout),
     inputs(other.inputs),
     output(other.output)
@@ -160,6 +162,14 @@ void ts::InputSwitcherArgs::defineArgs(Args& args) const
               u"Specify the maximum number of TS packets to write at a time. "
               u"The default is " + UString::Decimal(DEFAULT_MAX_OUTPUT_PACKETS) + u" packets.");
 
+    args.option(u"metrics", 0, Args::STRING);
+    args.help(u"metrics", u"[address:]port",
+              u"Specify the local TCP port of an embedded HTTP server which exposes the "
+              u"state of all plugins and the current input in OpenMetrics text format "
+              u"(Prometheus scraping). The counters are available at URL /metrics. "
+              u"If the optional address is specified, listen on this local interface only. "
+              u"By default, there is no metrics server.");
+
     args.option(u"monitor", 'm');
     args.help(u"monitor",
               u"Continuously monitor the system resources which are used by tsswitch. "
@@ -220,6 +230,7 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
     maxInputPackets = std::min(args.intValue<size_t>(u"max-input-packets", DEFAULT_MAX_INPUT_PACKETS), bufferedPackets / 2);
     maxOutputPackets = args.intValue<size_t>(u"max-output-packets", DEFAULT_MAX_OUTPUT_PACKETS);
     const UString remoteName(args.value(u"remote"));
+    const UString metricsName(args.value(u"metrics"));
     reusePort = !args.present(u"no-reuse-port");
     sockBuffer = args.intValue<size_t>(u"udp-buffer-size");
     firstInput = args.intValue<size_t>(u"first-input", 0);
@@ -239,6 +250,12 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"missing UDP port number in --remote");
     }
 
+    // Resolve metrics server name.
+    metricsServer.clear();
+    if (!metricsName.empty() && metricsServer.resolve(metricsName, args) && !metricsServer.hasPort()) {
+        args.error(u"missing TCP port number in --metrics");
+    }
+
     // Resolve all allowed remote.
     UStringVector remotes;
     args.getValues(remotes, u"allow");
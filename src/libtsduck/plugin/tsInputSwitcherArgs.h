@@ -60,6 +60,7 @@ namespace ts {
         size_t              sockBuffer;        //!< Socket buffer size.
         SocketAddress       remoteServer;      //!< UDP server addres for remote control.
         IPAddressSet        allowedRemote;     //!< Set of allowed remotes.
+        SocketAddress       metricsServer;     //!< TCP server address for OpenMetrics (no port means none).
         MilliSecond         receiveTimeout;    //!< Receive timeout before switch (0=none).
         PluginOptionsVector inputs;            //!< Input plugins descriptions.
         PluginOptions       output;            //!< Output plugin description.
@@ -36,6 +36,7 @@
 #include "tsReport.h"
 #include "tsAbortInterface.h"
 #include "tsMPEG.h"
+#include <atomic>
 
 namespace ts {
 
@@ -120,14 +121,14 @@ namespace ts {
         //! by the current plugin).
         //! @return The total number of packets in this plugin object.
         //!
-        PacketCounter pluginPackets() const { return _plugin_packets; }
+        PacketCounter pluginPackets() const { return _plugin_packets.load(std::memory_order_relaxed); }
 
         //!
         //! Get total number of packets in the execution of the plugin thread.
         //! This includes the number of extra stuffing or dropped packets.
         //! @return The total number of packets in this plugin thread.
         //!
-        PacketCounter totalPacketsInThread() const { return _total_packets; }
+        PacketCounter totalPacketsInThread() const { return _total_packets.load(std::memory_order_relaxed); }
 
         //!
         //! Check if the current plugin environment should use defaults for real-time.
@@ -221,16 +222,25 @@ namespace ts {
         //! Account for more processed packets in this plugin object.
         //! @param [in] incr Add this number of processed packets in the plugin object.
         //!
-        void addPluginPackets(size_t incr) {_plugin_packets += incr; _total_packets += incr;}
+        void addPluginPackets(size_t incr)
+        {
+            _plugin_packets.store(_plugin_packets.load(std::memory_order_relaxed) + incr, std::memory_order_relaxed);
+            addNonPluginPackets(incr);
+        }
 
         //!
         //! Account for more processed packets in this plugin thread, but excluded from plugin object.
         //! @param [in] incr Add this number of processed packets in the plugin thread.
         //!
-        void addNonPluginPackets(size_t incr) {_total_packets += incr;}
+        void addNonPluginPackets(size_t incr)
+        {
+            _total_packets.store(_total_packets.load(std::memory_order_relaxed) + incr, std::memory_order_relaxed);
+        }
 
     private:
-        PacketCounter _total_packets;   // Total processed packets in the plugin thread.
-        PacketCounter _plugin_packets;  // Total processed packets in the plugin object.
+        // The packet counters are written by the plugin thread only but they can be read from
+        // other threads (metrics server for instance). Only atomicity is required, not ordering.
+        std::atomic<PacketCounter> _total_packets;   // Total processed packets in the plugin thread.
+        std::atomic<PacketCounter> _plugin_packets;  // Total processed packets in the plugin object.
     };
 }
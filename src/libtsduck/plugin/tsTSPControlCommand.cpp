@@ -32,12 +32,13 @@ TSDUCK_SOURCE;
 
 // Enumeration description of ControlCommand.
 const ts::Enumeration ts::TSPControlCommand::ControlCommandEnum({
-    {u"exit",    ts::TSPControlCommand::ControlCommand::CMD_EXIT},
-    {u"set-log", ts::TSPControlCommand::ControlCommand::CMD_SETLOG},
-    {u"list",    ts::TSPControlCommand::ControlCommand::CMD_LIST},
-    {u"suspend", ts::TSPControlCommand::ControlCommand::CMD_SUSPEND},
-    {u"resume",  ts::TSPControlCommand::ControlCommand::CMD_RESUME},
-    {u"restart", ts::TSPControlCommand::ControlCommand::CMD_RESTART},
+    {u"exit",       ts::TSPControlCommand::ControlCommand::CMD_EXIT},
+    {u"set-log",    ts::TSPControlCommand::ControlCommand::CMD_SETLOG},
+    {u"list",       ts::TSPControlCommand::ControlCommand::CMD_LIST},
+    {u"suspend",    ts::TSPControlCommand::ControlCommand::CMD_SUSPEND},
+    {u"resume",     ts::TSPControlCommand::ControlCommand::CMD_RESUME},
+    {u"restart",    ts::TSPControlCommand::ControlCommand::CMD_RESTART},
+    {u"statistics", ts::TSPControlCommand::ControlCommand::CMD_STATISTICS},
 });
 
 
@@ -87,6 +88,13 @@ ts::TSPControlCommand::TSPControlCommand() :
     arg->help(u"same",
               u"Restart the plugin with the same options and parameters. "
               u"By default, when no plugin options are specified, restart with no option at all.");
+
+    arg = newCommand(CMD_STATISTICS, u"Display instrumentation counters of all plugins", u"[options]");
+    arg->setIntro(u"Display the instrumentation counters of all plugins in JSON format: number of packets, "
+                  u"packets per second, time spent waiting for packets and processing them, occupancy of "
+                  u"the buffer area of each plugin, latency of the packets between input and output. "
+                  u"The rates are computed since the previous statistics command. "
+                  u"The tsp command shall be started with option --instrumentation.");
 }
 
 
@@ -56,13 +56,14 @@ namespace ts {
         //! Definition of TSP control command.
         //!
         enum ControlCommand {
-            CMD_NONE,     //!< No command specified, do nothing.
-            CMD_EXIT,     //!< Exit tsp.
-            CMD_SETLOG,   //!< Change log level.
-            CMD_LIST,     //!< List all plugins.
-            CMD_SUSPEND,  //!< Suspend a plugin.
-            CMD_RESUME,   //!< Resume a suspended plugin.
-            CMD_RESTART,  //!< Restart a plugin with different parameters.
+            CMD_NONE,       //!< No command specified, do nothing.
+            CMD_EXIT,       //!< Exit tsp.
+            CMD_SETLOG,     //!< Change log level.
+            CMD_LIST,       //!< List all plugins.
+            CMD_SUSPEND,    //!< Suspend a plugin.
+            CMD_RESUME,     //!< Resume a suspended plugin.
+            CMD_RESTART,    //!< Restart a plugin with different parameters.
+            CMD_STATISTICS, //!< Display instrumentation counters of all plugins.
         };
 
         //!
@@ -32,6 +32,7 @@
 #include "tstspOutputExecutor.h"
 #include "tstspProcessorExecutor.h"
 #include "tstspControlServer.h"
+#include "tstspMetricsServer.h"
 #include "tsMonotonic.h"
 #include "tsGuard.h"
 TSDUCK_SOURCE;
@@ -49,8 +50,10 @@ ts::TSProcessor::TSProcessor(Report& report) :
     _args(),
     _input(nullptr),
     _output(nullptr),
+    _pool(nullptr),
     _monitor(nullptr),
     _control(nullptr),
+    _metrics(nullptr),
     _packet_buffer(nullptr),
     _metadata_buffer(nullptr)
 {
@@ -69,11 +72,17 @@ ts::TSProcessor::~TSProcessor()
 
 void ts::TSProcessor::cleanupInternal()
 {
+    // Terminate the metrics server first since it reads the plugin executors.
+    if (_metrics != nullptr) {
+        delete _metrics;
+        _metrics = nullptr;
+    }
+
     // Abort and wait for threads to terminate
     tsp::PluginExecutor* proc = _input;
     do {
         proc->setAbort();
-        proc->waitForTermination();
+        proc->waitExecution();
     } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
 
     // Deallocate all plugin executors.
@@ -114,6 +123,17 @@ void ts::TSProcessor::cleanupInternal()
 }
 
 
+//----------------------------------------------------------------------------
+// Use a thread pool to execute the packet processor plugins.
+//----------------------------------------------------------------------------
+
+void ts::TSProcessor::setProcessorPool(TSProcessorPool* pool)
+{
+    Guard lock(_mutex);
+    _pool = pool;
+}
+
+
 //----------------------------------------------------------------------------
 // Start the TS processing.
 //----------------------------------------------------------------------------
@@ -158,7 +178,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::TRUE || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _mutex, &_report, _pool);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -238,10 +258,10 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // End of locked section.
     }
 
-    // Start all plugin executors threads.
+    // Start all plugin executors threads. With a thread pool, packet processor plugins are executed in the pool.
     tsp::PluginExecutor* proc = _input;
     do {
-        proc->start();
+        proc->startExecution();
     } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
 
     // Create a control server thread. Display but ignore errors (not a fatal error).
@@ -249,6 +269,11 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
     CheckNonNull(_control);
     _control->open();
 
+    // Create an OpenMetrics server thread. Display but ignore errors (not a fatal error).
+    _metrics = new tsp::MetricsServer(_args, _report, _mutex, _input);
+    CheckNonNull(_metrics);
+    _metrics->open();
+
     return true;
 }
 
@@ -293,7 +318,7 @@ void ts::TSProcessor::waitForTermination()
         // Wait for threads to terminate
         tsp::PluginExecutor* proc = _input;
         do {
-            proc->waitForTermination();
+            proc->waitExecution();
         } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
 
         // Make sure the control server thread is terminated before deleting plugins.
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsPluginEventHandlerRegistry.h"
 #include "tsTSProcessorArgs.h"
+#include "tsTSProcessorPool.h"
 #include "tsTSPacketMetadata.h"
 #include "tsSystemMonitor.h"
 #include "tsMutex.h"
@@ -47,6 +48,7 @@ namespace ts {
         class InputExecutor;
         class OutputExecutor;
         class ControlServer;
+        class MetricsServer;
     }
     //! @endcond
 
@@ -81,6 +83,17 @@ namespace ts {
         //!
         Report& report() const { return _report; }
 
+        //!
+        //! Use a thread pool to execute the packet processor plugins.
+        //! By default, each plugin is executed in its own thread.
+        //! Must be called before start(). The pool must be started and must remain
+        //! started until the termination of the TS processing. The same pool can
+        //! be used by several TSProcessor instances.
+        //! @param [in,out] pool The thread pool to use or null to use one thread per plugin.
+        //! @see TSProcessorPool
+        //!
+        void setProcessorPool(TSProcessorPool* pool);
+
         //!
         //! Start the TS processing.
         //! @param [in] args Arguments and options.
@@ -116,8 +129,10 @@ namespace ts {
         TSProcessorArgs       _args;             // Processing options.
         tsp::InputExecutor*   _input;            // Input processor execution thread.
         tsp::OutputExecutor*  _output;           // Output processor execution thread.
+        TSProcessorPool*      _pool;             // Thread pool for packet processor plugins, if any.
         SystemMonitor*        _monitor;          // System monitor thread.
         tsp::ControlServer*   _control;          // TSP control command server thread.
+        tsp::MetricsServer*   _metrics;          // TSP OpenMetrics server thread.
         PacketBuffer*         _packet_buffer;    // Global TS packet buffer.
         PacketMetadataBuffer* _metadata_buffer;  // Global packet metabata buffer.
 
@@ -54,6 +54,8 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     app_name(),
     monitor(false),
     ignore_jt(false),
+    instrumentation(false),
+    instr_interval(0),
     ts_buffer_size(DEFAULT_BUFFER_SIZE),
     max_flush_pkt(0),
     max_input_pkt(0),
@@ -72,6 +74,7 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     control_reuse(false),
     control_sources(),
     control_timeout(DEF_CONTROL_TIMEOUT),
+    metrics_server(),
     duck_args(),
     input(),
     plugins(),
@@ -174,6 +177,19 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"a valid bitrate value from the beginning. "
               u"The default initial load is half the size of the global buffer.");
 
+    args.option(u"instrumentation");
+    args.help(u"instrumentation",
+              u"Collect instrumentation counters on all plugins: number of packets, time spent "
+              u"waiting for packets, CPU time of the plugin thread, occupancy of the buffer area of each "
+              u"plugin, latency of the packets between input and output. The counters can be "
+              u"displayed using the tspcontrol command \"statistics\". Instrumentation is "
+              u"disabled by default because it adds some time measurements on each packet chunk.");
+
+    args.option(u"instrumentation-interval", 0, Args::POSITIVE);
+    args.help(u"instrumentation-interval", u"seconds",
+              u"Periodically log the instrumentation counters of all plugins as a one-line JSON "
+              u"text, every specified number of seconds. This option implies --instrumentation.");
+
     args.option(u"receive-timeout", 0, Args::POSITIVE);
     args.help(u"receive-timeout", u"milliseconds",
               u"Specify a timeout in milliseconds for all input operations. "
@@ -195,6 +211,14 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"as it can, depending on the free space in the buffer. In real-time mode, "
               u"the default is " + UString::Decimal(DEF_MAX_INPUT_PKT_RT) + u" packets.");
 
+    args.option(u"metrics", 0, Args::STRING);
+    args.help(u"metrics", u"[address:]port",
+              u"Specify the local TCP port of an embedded HTTP server which exposes the "
+              u"state of all plugins in OpenMetrics text format (Prometheus scraping). "
+              u"The counters are available at URL /metrics. If the optional address is "
+              u"specified, listen on this local interface only. "
+              u"By default, there is no metrics server.");
+
     args.option(u"monitor", 'm');
     args.help(u"monitor",
               u"Continuously monitor the system resources which are used by tsp. "
@@ -230,6 +254,8 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     instuff_start = args.intValue<size_t>(u"add-start-stuffing", 0);
     instuff_stop = args.intValue<size_t>(u"add-stop-stuffing", 0);
     ignore_jt = args.present(u"ignore-joint-termination");
+    instr_interval = MilliSecPerSec * args.intValue<MilliSecond>(u"instrumentation-interval", 0);
+    instrumentation = instr_interval > 0 || args.present(u"instrumentation");
     realtime = args.tristateValue(u"realtime");
     receive_timeout = args.intValue<MilliSecond>(u"receive-timeout", 0);
     control_port = args.intValue<uint16_t>(u"control-port", 0);
@@ -247,6 +273,12 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
         control_local.resolve(args.value(u"control-local"), args);
     }
 
+    // Get and resolve optional metrics server address.
+    metrics_server.clear();
+    if (args.present(u"metrics") && metrics_server.resolve(args.value(u"metrics"), args) && !metrics_server.hasPort()) {
+        args.error(u"missing TCP port number in --metrics");
+    }
+
     // Get and resolve optional allowed remote addresses.
     control_sources.clear();
     if (!args.present(u"control-source")) {
@@ -37,6 +37,7 @@
 #include "tsPluginOptions.h"
 #include "tsDuckContext.h"
 #include "tsIPAddress.h"
+#include "tsSocketAddress.h"
 
 namespace ts {
     //!
@@ -49,6 +50,8 @@ namespace ts {
         UString         app_name;         //!< Application name, for help messages.
         bool            monitor;          //!< Run a resource monitoring thread.
         bool            ignore_jt;        //!< Ignore "joint termination" options in plugins.
+        bool            instrumentation;  //!< Collect instrumentation counters on all plugins.
+        MilliSecond     instr_interval;   //!< Interval between instrumentation reports in the log (zero means none).
         size_t          ts_buffer_size;   //!< Size in bytes of the global TS packet buffer.
         size_t          max_flush_pkt;    //!< Max processed packets before flush.
         size_t          max_input_pkt;    //!< Max packets per input operation.
@@ -67,6 +70,7 @@ namespace ts {
         bool            control_reuse;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPAddressVector control_sources;  //!< Remote IP addresses which are allowed to send control commands.
         MilliSecond     control_timeout;  //!< Reception timeout in milliseconds for control commands.
+        SocketAddress   metrics_server;   //!< Local TCP address of the OpenMetrics HTTP server (no port means none).
         DuckContext::SavedArgs duck_args; //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
         PluginOptions          input;     //!< Input plugin description.
         PluginOptionsVector    plugins;   //!< Packet processor plugins descriptions.
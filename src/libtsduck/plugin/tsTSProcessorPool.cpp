@@ -0,0 +1,302 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSProcessorPool.h"
+#include "tsPluginThread.h"
+#include "tsGuardCondition.h"
+#include "tsGuard.h"
+#include <thread>
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPool::TSProcessorPool(size_t thread_count, size_t stack_usage) :
+    _thread_count(thread_count > 0 ? thread_count : std::max<size_t>(1, std::thread::hardware_concurrency())),
+    _stack_usage(stack_usage),
+    _mutex(),
+    _workers(),
+    _next_queue(0),
+    _terminate(false)
+{
+}
+
+ts::TSProcessorPool::~TSProcessorPool()
+{
+    stop();
+}
+
+
+//----------------------------------------------------------------------------
+// Start the threads of the pool.
+//----------------------------------------------------------------------------
+
+bool ts::TSProcessorPool::start()
+{
+    {
+        Guard lock(_mutex);
+
+        if (!_workers.empty()) {
+            return false;
+        }
+        _terminate = false;
+
+        // The threads are started in the critical section, they wait until it is released.
+        ThreadAttributes attributes;
+        attributes.setStackSize(PluginThread::STACK_SIZE_OVERHEAD + _stack_usage);
+        bool success = true;
+        for (size_t i = 0; success && i < _thread_count; ++i) {
+            WorkerPtr worker(new Worker(*this, i, attributes));
+            CheckNonNull(worker.pointer());
+            _workers.push_back(worker);
+            success = worker->start();
+        }
+        if (success) {
+            return true;
+        }
+    }
+
+    // Failed to start a thread, terminate the others.
+    stop();
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate the threads of the pool.
+//----------------------------------------------------------------------------
+
+void ts::TSProcessorPool::stop()
+{
+    {
+        Guard lock(_mutex);
+        _terminate = true;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            _workers[i]->wakeup.signal();
+        }
+    }
+
+    // The vector of threads is modified by start() and stop() only, in the same thread.
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        _workers[i]->waitForTermination();
+    }
+
+    Guard lock(_mutex);
+    _workers.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Jobs.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPool::Job::Job() :
+    _done(),
+    _queued(false),
+    _running(false),
+    _again(false),
+    _completed(true)
+{
+}
+
+ts::TSProcessorPool::Job::~Job()
+{
+}
+
+bool ts::TSProcessorPool::startJob(Job* job)
+{
+    Guard lock(_mutex);
+    if (_workers.empty() || _terminate) {
+        return false;
+    }
+    job->_queued = false;
+    job->_running = false;
+    job->_again = false;
+    job->_completed = false;
+    enqueue(job, currentWorker(), true);
+    return true;
+}
+
+void ts::TSProcessorPool::schedule(Job* job)
+{
+    Guard lock(_mutex);
+    if (job->_running) {
+        // Execute another step after the current one.
+        job->_again = true;
+    }
+    else if (!job->_queued && !job->_completed) {
+        enqueue(job, currentWorker(), true);
+    }
+}
+
+void ts::TSProcessorPool::waitJob(Job* job)
+{
+    GuardCondition lock(_mutex, job->_done);
+    while (!job->_completed) {
+        lock.waitCondition();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Internal methods, must be called with the mutex held.
+//----------------------------------------------------------------------------
+
+// Index of the calling thread in the pool, NPOS if the caller is not in the pool.
+size_t ts::TSProcessorPool::currentWorker() const
+{
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        if (_workers[i]->isCurrentThread()) {
+            return i;
+        }
+    }
+    return NPOS;
+}
+
+// Queue a job in the queue of a thread, NPOS when scheduled from outside the pool.
+// When required, wake up the owner of the queue or another idle thread which will steal the job.
+void ts::TSProcessorPool::enqueue(Job* job, size_t index, bool wake)
+{
+    if (index >= _workers.size()) {
+        // Distribute the jobs from outside the pool over all threads.
+        index = _next_queue++ % _workers.size();
+    }
+
+    _workers[index]->queue.push_back(job);
+    job->_queued = true;
+
+    for (size_t i = 0; wake && i < _workers.size(); ++i) {
+        Worker& worker(*_workers[(index + i) % _workers.size()]);
+        if (worker.idle) {
+            worker.idle = false;
+            worker.wakeup.signal();
+            wake = false;
+        }
+    }
+}
+
+// Get the next job for a thread, from its own queue or stolen from another thread.
+ts::TSProcessorPool::Job* ts::TSProcessorPool::dequeue(size_t index)
+{
+    Job* job = nullptr;
+    std::deque<Job*>& own(_workers[index]->queue);
+
+    if (!own.empty()) {
+        job = own.front();
+        own.pop_front();
+    }
+    else {
+        // Steal the most recent job from the longest queue.
+        size_t victim = index;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (_workers[i]->queue.size() > _workers[victim]->queue.size()) {
+                victim = i;
+            }
+        }
+        if (!_workers[victim]->queue.empty()) {
+            job = _workers[victim]->queue.back();
+            _workers[victim]->queue.pop_back();
+        }
+    }
+
+    if (job != nullptr) {
+        job->_queued = false;
+        job->_running = true;
+        job->_again = false;
+    }
+    return job;
+}
+
+// Update the state of a job after one step in a thread.
+void ts::TSProcessorPool::endStep(Job* job, Job::Step step, size_t index)
+{
+    job->_running = false;
+    if (step == Job::Step::COMPLETED) {
+        // The job may be deleted as soon as the waiting thread is notified.
+        job->_completed = true;
+        job->_done.signal();
+    }
+    else if (step == Job::Step::CONTINUE || job->_again) {
+        // If the queue of the thread is empty, the thread executes the job again, no need to wake up another one.
+        enqueue(job, index, !_workers[index]->queue.empty());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Threads of the pool.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPool::Worker::Worker(TSProcessorPool& pool, size_t index, const ThreadAttributes& attributes) :
+    Thread(attributes),
+    queue(),
+    wakeup(),
+    idle(false),
+    _pool(pool),
+    _index(index)
+{
+}
+
+ts::TSProcessorPool::Worker::~Worker()
+{
+    waitForTermination();
+}
+
+void ts::TSProcessorPool::Worker::main()
+{
+    Job* job = nullptr;
+    Job::Step step = Job::Step::IDLE;
+
+    for (;;) {
+        {
+            GuardCondition lock(_pool._mutex, wakeup);
+
+            // Complete the previous step, if any.
+            if (job != nullptr) {
+                _pool.endStep(job, step, _index);
+            }
+
+            // Wait for a job to execute.
+            while ((job = _pool.dequeue(_index)) == nullptr && !_pool._terminate) {
+                idle = true;
+                lock.waitCondition();
+            }
+            idle = false;
+        }
+
+        if (job == nullptr) {
+            break;
+        }
+
+        // Execute one step of the job outside the critical section.
+        step = job->runJob();
+    }
+}
@@ -0,0 +1,229 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A pool of threads which execute the packet processor plugins of TS processors.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsSafePtr.h"
+
+namespace ts {
+    //!
+    //! A pool of threads which execute the packet processor plugins of TS processors.
+    //! @ingroup plugin
+    //!
+    //! By default, a TSProcessor executes each plugin in its own thread. When many
+    //! TSProcessor instances run in the same process, the number of threads grows with
+    //! the total number of plugins. When a TSProcessor uses a pool, its packet processor
+    //! plugins are executed by the threads of the pool, which can be shared by many
+    //! TSProcessor instances. The input and output plugins always keep their own thread
+    //! since they typically block on I/O.
+    //!
+    //! In a pool, a packet processor plugin is a job which is executed by steps. Each step
+    //! processes the packets which are currently available to the plugin and returns. A job
+    //! is scheduled again when its previous or next plugin signals some work to do.
+    //!
+    //! Each thread of the pool has its own queue of jobs. A job which is scheduled from a
+    //! thread of the pool, typically when a plugin passes packets to the next plugin, is
+    //! queued in the queue of that thread. Each thread executes the jobs of its queue in
+    //! order and, when its queue is empty, steals the most recent job of the longest queue
+    //! of the other threads. When a job is queued, an idle thread is woken up, if there is
+    //! one. Thus, when all threads are busy, the packets are usually processed by the next
+    //! plugin in the same thread, while they are still in the cache of the CPU.
+    //!
+    //! All queues are protected by one single mutex of the pool. The critical sections
+    //! are short (queue and dequeue one job per step of a plugin) and a step processes
+    //! a group of packets.
+    //!
+    //! A plugin which blocks in its packet processing blocks one thread of the pool during
+    //! that time. Therefore, the real-time packet processor plugins, which may wait for
+    //! the wall clock time (for instance "regulate"), keep their own thread, as well as
+    //! the plugins which need a packet timeout.
+    //!
+    class TSDUCKDLL TSProcessorPool
+    {
+        TS_NOCOPY(TSProcessorPool);
+    public:
+        //!
+        //! Default maximum stack usage of the plugins which are executed in the pool.
+        //! Plugins which declare a larger stack usage are executed in their own thread.
+        //!
+        static const size_t DEFAULT_STACK_USAGE = 512 * 1024;
+
+        //!
+        //! Constructor.
+        //! @param [in] thread_count Number of threads in the pool. When zero, use the number of CPU cores in the system.
+        //! @param [in] stack_usage Maximum stack usage of the plugins which are executed in the pool.
+        //!
+        TSProcessorPool(size_t thread_count = 0, size_t stack_usage = DEFAULT_STACK_USAGE);
+
+        //!
+        //! Destructor.
+        //! The threads of the pool are terminated. All TS processors which use
+        //! the pool must be terminated before the destruction of the pool.
+        //!
+        ~TSProcessorPool();
+
+        //!
+        //! Start the threads of the pool.
+        //! @return True on success, false on error or if already started.
+        //!
+        bool start();
+
+        //!
+        //! Terminate the threads of the pool.
+        //! All TS processors which use the pool must be terminated first.
+        //!
+        void stop();
+
+        //!
+        //! Get the number of threads in the pool.
+        //! @return The number of threads in the pool.
+        //!
+        size_t threadCount() const { return _thread_count; }
+
+        //!
+        //! Get the maximum stack usage of the plugins which are executed in the pool.
+        //! @return The maximum stack usage in bytes.
+        //!
+        size_t stackUsage() const { return _stack_usage; }
+
+        //!
+        //! Abstract base class of a job which is executed by steps in the pool.
+        //! This class is used internally by TSProcessor for its packet processor plugins.
+        //!
+        class TSDUCKDLL Job
+        {
+            TS_NOCOPY(Job);
+        public:
+            //!
+            //! Constructor.
+            //!
+            Job();
+
+            //!
+            //! Virtual destructor.
+            //! The job shall not be in progress in a pool.
+            //!
+            virtual ~Job();
+
+            //!
+            //! Status of a job after one step.
+            //!
+            enum class Step {
+                CONTINUE,   //!< Some work was done, there may be more to do, execute another step.
+                IDLE,       //!< Nothing to do, execute another step when the job is scheduled again.
+                COMPLETED,  //!< The job is completed, it shall no longer be executed.
+            };
+
+        protected:
+            //!
+            //! Execute one step of the job.
+            //! Invoked in the context of a thread of the pool.
+            //! @return Status of the job after this step.
+            //!
+            virtual Step runJob() = 0;
+
+        private:
+            friend class TSProcessorPool;
+            // The following fields are protected by the mutex of the pool.
+            Condition _done;       // Signaled when the job is completed.
+            bool      _queued;     // The job is in the queue of a thread.
+            bool      _running;    // A step of the job is being executed.
+            bool      _again;      // The job was scheduled while a step was executed.
+            bool      _completed;  // The job is completed or was never started.
+        };
+
+        //!
+        //! Start the execution of a job in the pool.
+        //! A first step is executed as soon as possible.
+        //! @param [in,out] job The job to execute.
+        //! @return True on success, false if the pool is not started.
+        //!
+        bool startJob(Job* job);
+
+        //!
+        //! Schedule the execution of another step of a job.
+        //! Ignored if the job is already queued or completed.
+        //! If a step of the job is being executed, another step will follow.
+        //! @param [in,out] job The job to schedule.
+        //!
+        void schedule(Job* job);
+
+        //!
+        //! Wait for the completion of a job.
+        //! Return immediately if the job was never started.
+        //! @param [in,out] job The job to wait for.
+        //!
+        void waitJob(Job* job);
+
+    private:
+        // A thread of the pool.
+        class Worker: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Worker);
+        public:
+            Worker(TSProcessorPool& pool, size_t index, const ThreadAttributes& attributes);
+            virtual ~Worker() override;
+
+            // The following fields are protected by the mutex of the pool.
+            std::deque<Job*> queue;   // Jobs to execute, in order, stolen from the back by the other threads.
+            Condition        wakeup;  // Signaled when there is a job to execute or on termination.
+            bool             idle;    // The thread is waiting for a job.
+
+        private:
+            TSProcessorPool& _pool;
+            const size_t     _index;
+
+            // Inherited from Thread.
+            virtual void main() override;
+        };
+
+        typedef SafePtr<Worker, NullMutex> WorkerPtr;
+        typedef std::vector<WorkerPtr> WorkerVector;
+
+        const size_t _thread_count;  // Number of threads in the pool.
+        const size_t _stack_usage;   // Maximum stack usage of plugins.
+        Mutex        _mutex;         // Protect all queues and jobs states.
+        WorkerVector _workers;       // Threads of the pool.
+        size_t       _next_queue;    // Queue for the next job which is scheduled from outside the pool.
+        bool         _terminate;     // Terminate all threads.
+
+        // The following methods must be called with the mutex held.
+        size_t currentWorker() const;
+        void enqueue(Job* job, size_t index, bool wake);
+        Job* dequeue(size_t index);
+        void endStep(Job* job, Job::Step step, size_t index);
+    };
+}
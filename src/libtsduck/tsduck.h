@@ -336,6 +336,7 @@
 #include "tsjsonString.h"
 #include "tsjsonTrue.h"
 #include "tsjsonValue.h"
+#include "tsjsonWriter.h"
 #include "tsKeyTable.h"
 #include "tsLDT.h"
 #include "tsLinkageDescriptor.h"
@@ -348,6 +349,7 @@
 #include "tsMaximumBitrateDescriptor.h"
 #include "tsMD5.h"
 #include "tsMemory.h"
+#include "tsMemoryMappedFile.h"
 #include "tsMessageDescriptor.h"
 #include "tsMessagePriorityQueue.h"
 #include "tsMessageQueue.h"
@@ -620,6 +622,7 @@
 #include "tsTSDT.h"
 #include "tsTSFile.h"
 #include "tsTSFileInputBuffered.h"
+#include "tsTSFileOutputAsync.h"
 #include "tsTSFileOutputResync.h"
 #include "tsTSForkPipe.h"
 #include "tsTSInformationDescriptor.h"
@@ -632,6 +635,7 @@
 #include "tsTSPControlCommand.h"
 #include "tsTSProcessor.h"
 #include "tsTSProcessorArgs.h"
+#include "tsTSProcessorPool.h"
 #include "tsTSScanner.h"
 #include "tsTSScrambling.h"
 #include "tsTSSpeedMetrics.h"
@@ -675,6 +679,7 @@
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
 #include "tsxmlNode.h"
+#include "tsxmlPullParser.h"
 #include "tsxmlText.h"
 #include "tsxmlTweaks.h"
 #include "tsxmlUnknown.h"
@@ -0,0 +1,329 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSDuck benchmark suite: reproducible performance measurements of the
+//  library and of the tsp plugin chain, using synthetic streams only.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsbench.h"
+#include "tsMonotonic.h"
+#include "tsjson.h"
+#include "tsjsonObject.h"
+#include "tsjsonArray.h"
+#include "tsSysUtils.h"
+#include "tsTime.h"
+#include "tsVersionInfo.h"
+TSDUCK_SOURCE;
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Benchmark framework.
+//----------------------------------------------------------------------------
+
+tsbench::Benchmark::Benchmark(const ts::UString& name, const ts::UString& unit, uint64_t items) :
+    _name(name),
+    _unit(unit),
+    _items(items)
+{
+}
+
+tsbench::Benchmark::~Benchmark()
+{
+}
+
+bool tsbench::Benchmark::setup(ts::Report& report)
+{
+    return true;
+}
+
+void tsbench::Benchmark::cleanup()
+{
+}
+
+std::list<tsbench::BenchmarkFactory>& tsbench::Repository::Factories()
+{
+    // Function-local static to avoid static initialization order issues
+    // with the registration objects in other modules.
+    static std::list<BenchmarkFactory> factories;
+    return factories;
+}
+
+tsbench::Repository::Register::Register(BenchmarkFactory factory)
+{
+    Factories().push_back(factory);
+}
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        bool              list;       // List benchmarks, do not run them.
+        ts::UStringVector match;      // Run only benchmarks matching these strings.
+        ts::MilliSecond   duration;   // Minimum duration of one measurement.
+        size_t            repeat;     // Number of measurements per benchmark.
+        ts::UString       outfile;    // Output JSON file.
+        ts::UString       reference;  // Reference JSON file for comparison.
+        size_t            threshold;  // Regression threshold in percent.
+
+        // Check if a benchmark name is selected.
+        bool selected(const ts::UString& name) const;
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"TSDuck benchmark suite", u"[options]"),
+    list(false),
+    match(),
+    duration(0),
+    repeat(0),
+    outfile(),
+    reference(),
+    threshold(0)
+{
+    option(u"compare", 'c', STRING);
+    help(u"compare", u"filename",
+         u"Compare the results with a reference JSON file, as previously produced using --output. "
+         u"Each benchmark which is slower than in the reference file by more than the --threshold "
+         u"percentage is reported as a regression and the exit status of the command is an error.");
+
+    option(u"duration", 'd', POSITIVE);
+    help(u"duration", u"milliseconds",
+         u"Minimum duration of one measurement of a benchmark. "
+         u"The default is 500 milliseconds.");
+
+    option(u"list", 'l');
+    help(u"list", u"List all benchmarks, do not run them.");
+
+    option(u"match", 'm', STRING, 0, UNLIMITED_COUNT);
+    help(u"match", u"string",
+         u"Run only the benchmarks which name contains the specified string (not case-sensitive). "
+         u"Several --match options can be specified. By default, all benchmarks are run.");
+
+    option(u"output", 'o', STRING);
+    help(u"output", u"filename",
+         u"Save the results in the specified JSON file. This file can be later used as reference with --compare.");
+
+    option(u"repeat", 'r', POSITIVE);
+    help(u"repeat",
+         u"Number of measurements per benchmark. The median value is reported. "
+         u"The default is 5.");
+
+    option(u"threshold", 't', POSITIVE);
+    help(u"threshold", u"percent",
+         u"With --compare, minimum slowdown to report a regression, in percent. "
+         u"The default is 10%.");
+
+    analyze(argc, argv);
+
+    list = present(u"list");
+    getValues(match, u"match");
+    duration = intValue<ts::MilliSecond>(u"duration", 500);
+    repeat = intValue<size_t>(u"repeat", 5);
+    getValue(outfile, u"output");
+    getValue(reference, u"compare");
+    threshold = intValue<size_t>(u"threshold", 10);
+
+    exitOnError();
+}
+
+bool Options::selected(const ts::UString& name) const
+{
+    if (match.empty()) {
+        return true;
+    }
+    for (auto it = match.begin(); it != match.end(); ++it) {
+        if (name.contain(*it, ts::CASE_INSENSITIVE)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+//  Run one benchmark. Return the median duration of one iteration in
+//  nanoseconds or a negative value if the benchmark was skipped.
+//----------------------------------------------------------------------------
+
+namespace {
+    ts::NanoSecond RunBenchmark(tsbench::Benchmark& bench, Options& opt)
+    {
+        if (!bench.setup(opt)) {
+            opt.warning(u"%s: skipped", {bench.name()});
+            return -1;
+        }
+
+        // Warm-up iteration (caches, lazy initializations) and calibration
+        // of the number of iterations per measurement.
+        ts::Monotonic start(true);
+        bench.run();
+        ts::NanoSecond first = std::max<ts::NanoSecond>(1, ts::Monotonic(true) - start);
+        const ts::NanoSecond target = opt.duration * ts::NanoSecPerMilliSec;
+        const uint64_t iterations = std::max<uint64_t>(1, uint64_t(target / first));
+
+        // Each measurement runs the same number of iterations.
+        std::vector<ts::NanoSecond> results;
+        results.reserve(opt.repeat);
+        for (size_t i = 0; i < opt.repeat; ++i) {
+            start.getSystemTime();
+            for (uint64_t n = 0; n < iterations; ++n) {
+                bench.run();
+            }
+            results.push_back((ts::Monotonic(true) - start) / ts::NanoSecond(iterations));
+            opt.debug(u"%s: measure %d: %'d ns/iteration over %'d iterations", {bench.name(), i + 1, results.back(), iterations});
+        }
+        bench.cleanup();
+
+        // Median value, less sensitive to system noise than the average.
+        std::sort(results.begin(), results.end());
+        return std::max<ts::NanoSecond>(1, results[results.size() / 2]);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Compare with a reference file. Return false on regression.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool Compare(const ts::json::Value& results, Options& opt)
+    {
+        ts::UStringList lines;
+        ts::json::ValuePtr ref;
+        if (!ts::UString::Load(lines, opt.reference)) {
+            opt.error(u"cannot read %s", {opt.reference});
+            return false;
+        }
+        if (!ts::json::Parse(ref, lines, opt) || ref.isNull()) {
+            opt.error(u"invalid JSON reference file %s", {opt.reference});
+            return false;
+        }
+
+        // Index reference durations by benchmark name.
+        std::map<ts::UString, int64_t> previous;
+        const ts::json::Value& refbench(ref->value(u"benchmarks"));
+        for (size_t i = 0; i < refbench.size(); ++i) {
+            const ts::json::Value& jv(refbench.at(i));
+            previous[jv.value(u"name").toString()] = jv.value(u"ns-per-iteration").toInteger();
+        }
+
+        bool ok = true;
+        const ts::json::Value& current(results.value(u"benchmarks"));
+        for (size_t i = 0; i < current.size(); ++i) {
+            const ts::json::Value& jv(current.at(i));
+            const ts::UString name(jv.value(u"name").toString());
+            const int64_t now = jv.value(u"ns-per-iteration").toInteger();
+            const auto it = previous.find(name);
+            if (it == previous.end() || it->second <= 0) {
+                opt.verbose(u"%s: not in reference file", {name});
+            }
+            else if (now * 100 > it->second * int64_t(100 + opt.threshold)) {
+                opt.error(u"%s: regression, %'d ns/iteration, reference %'d ns/iteration (+%d%%)", {name, now, it->second, ((now - it->second) * 100) / it->second});
+                ok = false;
+            }
+            else {
+                opt.verbose(u"%s: %'d ns/iteration, reference %'d ns/iteration", {name, now, it->second});
+            }
+        }
+        return ok;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+
+    // Build all benchmarks, sorted by name for reproducible reports.
+    std::map<ts::UString, tsbench::BenchmarkPtr> benchmarks;
+    const std::list<tsbench::BenchmarkFactory>& factories(tsbench::Repository::Factories());
+    for (auto it = factories.begin(); it != factories.end(); ++it) {
+        tsbench::BenchmarkPtr bench((*it)());
+        if (opt.selected(bench->name())) {
+            benchmarks[bench->name()] = bench;
+        }
+    }
+
+    if (opt.list) {
+        for (auto it = benchmarks.begin(); it != benchmarks.end(); ++it) {
+            std::cout << it->first << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    ts::json::Object root;
+    root.add(u"version", ts::VersionInfo::GetVersion(ts::VersionInfo::Format::SHORT));
+    root.add(u"date", ts::Time::CurrentLocalTime().format(ts::Time::DATETIME));
+    root.add(u"duration-ms", opt.duration);
+    root.add(u"repeat", opt.repeat);
+
+    for (auto it = benchmarks.begin(); it != benchmarks.end(); ++it) {
+        tsbench::Benchmark& bench(*it->second);
+        const ts::NanoSecond ns = RunBenchmark(bench, opt);
+        if (ns > 0) {
+            const uint64_t rate = (bench.items() * uint64_t(ts::NanoSecPerSec)) / uint64_t(ns);
+            std::cout << ts::UString::Format(u"%-40s %15'd ns/iteration %15'd %s/s", {bench.name(), ns, rate, bench.unit()}) << std::endl;
+            ts::json::Value& jv(root.query(u"benchmarks[]", true));
+            jv.add(u"name", bench.name());
+            jv.add(u"unit", bench.unit());
+            jv.add(u"items-per-iteration", bench.items());
+            jv.add(u"ns-per-iteration", ns);
+            jv.add(u"items-per-second", rate);
+        }
+    }
+
+    bool ok = true;
+    if (!opt.outfile.empty()) {
+        ts::UStringList text;
+        text.push_back(root.printed(2, opt));
+        if (!ts::UString::Save(text, opt.outfile)) {
+            opt.error(u"error creating %s", {opt.outfile});
+            ok = false;
+        }
+    }
+    if (!opt.reference.empty()) {
+        ok = Compare(root, opt) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
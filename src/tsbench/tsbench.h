@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//! @file
+//! TSBench interface (a simple benchmark framework for TSDuck).
+//!
+//! Each benchmark is a subclass of tsbench::Benchmark which is registered
+//! using the macro TSBENCH_REGISTER. There is no need to modify the main
+//! program when a new benchmark is added in a source file of this directory.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsReport.h"
+#include "tsTSPacket.h"
+#include "tsSafePtr.h"
+
+namespace tsbench {
+
+    //!
+    //! Base class of all benchmarks.
+    //! A benchmark repeatedly executes one iteration of an operation. Each iteration
+    //! processes the same number of items (bytes, packets, sections, etc.)
+    //!
+    class Benchmark
+    {
+        TS_NOBUILD_NOCOPY(Benchmark);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] name Name of the benchmark, used in reports and filters.
+        //! @param [in] unit Name of the items which are processed, e.g. "bytes" or "packets".
+        //! @param [in] items Number of items which are processed in one iteration.
+        //!
+        Benchmark(const ts::UString& name, const ts::UString& unit, uint64_t items);
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~Benchmark();
+
+        //!
+        //! Get the name of the benchmark.
+        //! @return The name of the benchmark.
+        //!
+        const ts::UString& name() const { return _name; }
+
+        //!
+        //! Get the name of the processed items.
+        //! @return The name of the processed items.
+        //!
+        const ts::UString& unit() const { return _unit; }
+
+        //!
+        //! Get the number of items which are processed in one iteration.
+        //! @return The number of items which are processed in one iteration.
+        //!
+        uint64_t items() const { return _items; }
+
+        //!
+        //! Prepare the benchmark, called once before all iterations.
+        //! The preparation time is not measured.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false when the benchmark cannot run and shall be skipped.
+        //!
+        virtual bool setup(ts::Report& report);
+
+        //!
+        //! Execute one iteration of the benchmark.
+        //!
+        virtual void run() = 0;
+
+        //!
+        //! Cleanup the benchmark, called once after all iterations.
+        //!
+        virtual void cleanup();
+
+    private:
+        const ts::UString _name;
+        const ts::UString _unit;
+        const uint64_t    _items;
+    };
+
+    //!
+    //! Safe pointer to a benchmark (not thread-safe).
+    //!
+    typedef ts::SafePtr<Benchmark, ts::NullMutex> BenchmarkPtr;
+
+    //!
+    //! Profile of a benchmark factory function.
+    //! @return A new benchmark instance.
+    //!
+    typedef Benchmark* (*BenchmarkFactory)();
+
+    //!
+    //! Repository of all benchmarks.
+    //!
+    class Repository
+    {
+    public:
+        //!
+        //! Get all registered benchmark factories.
+        //! @return A reference to the list of all registered benchmark factories.
+        //!
+        static std::list<BenchmarkFactory>& Factories();
+
+        //!
+        //! A class to register benchmarks.
+        //! The registration is performed using constructors.
+        //! Thus, it is possible to perform a registration in the declaration of a static object.
+        //!
+        class Register
+        {
+            TS_NOBUILD_NOCOPY(Register);
+        public:
+            //!
+            //! The constructor registers a benchmark factory.
+            //! @param [in] factory Benchmark factory.
+            //!
+            Register(BenchmarkFactory factory);
+        };
+    };
+
+    //!
+    //! Build a synthetic transport stream, without any sample file.
+    //! The stream contains one service with PAT, PMT and SDT, a video PID with PCR's,
+    //! an audio PID and null packets. All continuity counters are consistent and the
+    //! content is deterministic, for reproducible benchmarks.
+    //! @param [out] packets Returned TS packets.
+    //! @param [in] count Number of packets to generate.
+    //!
+    void SyntheticStream(ts::TSPacketVector& packets, size_t count);
+
+    //!
+    //! Service id of the synthetic stream.
+    //!
+    constexpr uint16_t SYNTHETIC_SERVICE_ID = 0x0101;
+    //!
+    //! PMT PID of the synthetic stream.
+    //!
+    constexpr ts::PID SYNTHETIC_PMT_PID = 0x0100;
+    //!
+    //! Video PID of the synthetic stream (also PCR PID).
+    //!
+    constexpr ts::PID SYNTHETIC_VIDEO_PID = 0x0101;
+    //!
+    //! Audio PID of the synthetic stream.
+    //!
+    constexpr ts::PID SYNTHETIC_AUDIO_PID = 0x0102;
+}
+
+//!
+//! @hideinitializer
+//! Register a benchmark class. The class must have a default constructor.
+//! @param classname Name of a subclass of tsbench::Benchmark.
+//!
+#define TSBENCH_REGISTER(classname) \
+    namespace { tsbench::Benchmark* TS_UNIQUE_NAME(_F)() {return new classname;} } static tsbench::Repository::Register TS_UNIQUE_NAME(_R)(&TS_UNIQUE_NAME(_F))
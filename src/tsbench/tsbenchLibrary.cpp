@@ -0,0 +1,934 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Microbenchmarks of the TSDuck library.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsByteBlock.h"
+#include "tsCRC32.h"
+#include "tsContinuityAnalyzer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsDVBCSA2.h"
+#include "tsDuckContext.h"
+#include "tsEIT.h"
+#include "tsMemory.h"
+#include "tsNIT.h"
+#include "tsNullReport.h"
+#include "tsPSIBuffer.h"
+#include "tsSDT.h"
+#include "tsSectionDemux.h"
+#include "tsServiceDescriptor.h"
+#include "tsServiceListDescriptor.h"
+#include "tsShortEventDescriptor.h"
+#include "tsTSAnalyzer.h"
+#include "tsTSAnalyzerReport.h"
+#include "tsTablesDisplay.h"
+#include "tsTablesLogger.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Number of packets in the synthetic stream of each benchmark.
+    constexpr size_t STREAM_PACKETS = 10000;
+}
+
+
+//----------------------------------------------------------------------------
+// CRC32 computation.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CRC32Bench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(CRC32Bench);
+    public:
+        CRC32Bench() : Benchmark(u"CRC32", u"bytes", DATA_SIZE), _data(DATA_SIZE), _crc(0) {}
+
+        virtual bool setup(ts::Report& report) override
+        {
+            for (size_t i = 0; i < _data.size(); ++i) {
+                _data[i] = uint8_t(i * 7 + (i >> 8));
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            _crc += ts::CRC32(_data.data(), _data.size()).value();
+        }
+
+    private:
+        static constexpr size_t DATA_SIZE = 1024 * 1024;
+        ts::ByteBlock _data;
+        uint32_t      _crc;
+    };
+}
+
+TSBENCH_REGISTER(CRC32Bench);
+
+
+//----------------------------------------------------------------------------
+// Start code scanning in a video elementary stream, as in PESDemux.
+//----------------------------------------------------------------------------
+
+namespace {
+    class StartCodeBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(StartCodeBench);
+    public:
+        StartCodeBench(bool pattern) :
+            Benchmark(pattern ? u"StartCode::LocatePattern" : u"StartCode::LocateZeroZero", u"bytes", DATA_SIZE),
+            _pattern(pattern),
+            _data(DATA_SIZE),
+            _count(0)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            // Pseudo-random payload with a NAL unit every 2000 bytes on average.
+            uint32_t seed = 1;
+            for (size_t i = 0; i < _data.size(); ++i) {
+                seed = seed * 1103515245 + 12345;
+                _data[i] = uint8_t(seed >> 16);
+                if ((seed >> 20) % 2000 == 0 && i + 3 < _data.size()) {
+                    _data[i++] = 0x00;
+                    _data[i++] = 0x00;
+                    _data[i] = 0x01;
+                }
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            static const uint8_t prefix[] = {0x00, 0x00, 0x01};
+            const uint8_t* const end = _data.data() + _data.size();
+            const uint8_t* p = _data.data();
+            while (p != nullptr && p < end) {
+                if (_pattern) {
+                    p = reinterpret_cast<const uint8_t*>(ts::LocatePattern(p, end - p, prefix, sizeof(prefix)));
+                }
+                else {
+                    p = ts::LocateZeroZero(p, end - p);
+                }
+                if (p != nullptr) {
+                    _count++;
+                    p += 3;
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t DATA_SIZE = 1024 * 1024;
+        const bool    _pattern;
+        ts::ByteBlock _data;
+        uint64_t      _count;
+    };
+
+    class LocatePatternStartCodeBench: public StartCodeBench
+    {
+    public:
+        LocatePatternStartCodeBench() : StartCodeBench(true) {}
+    };
+
+    class LocateZeroZeroStartCodeBench: public StartCodeBench
+    {
+    public:
+        LocateZeroZeroStartCodeBench() : StartCodeBench(false) {}
+    };
+}
+
+TSBENCH_REGISTER(LocatePatternStartCodeBench);
+TSBENCH_REGISTER(LocateZeroZeroStartCodeBench);
+
+
+//----------------------------------------------------------------------------
+// DVB-CSA2 scrambling and descrambling of packet payloads.
+//----------------------------------------------------------------------------
+
+namespace {
+    class DVBCSA2Bench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(DVBCSA2Bench);
+    public:
+        DVBCSA2Bench(bool encrypt) :
+            Benchmark(encrypt ? u"DVBCSA2::encrypt" : u"DVBCSA2::decrypt", u"packets", STREAM_PACKETS),
+            _encrypt(encrypt),
+            _packets(),
+            _csa()
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            static const uint8_t cw[8] = {0x01, 0x23, 0x45, 0x89, 0x89, 0xAB, 0xCD, 0x75};
+            tsbench::SyntheticStream(_packets, STREAM_PACKETS);
+            return _csa.setKey(cw, sizeof(cw));
+        }
+
+        virtual void run() override
+        {
+            for (auto it = _packets.begin(); it != _packets.end(); ++it) {
+                if (_encrypt) {
+                    _csa.encryptInPlace(it->getPayload(), it->getPayloadSize());
+                }
+                else {
+                    _csa.decryptInPlace(it->getPayload(), it->getPayloadSize());
+                }
+            }
+        }
+
+    private:
+        bool               _encrypt;
+        ts::TSPacketVector _packets;
+        ts::DVBCSA2        _csa;
+    };
+
+    class DVBCSA2EncryptBench: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2EncryptBench() : DVBCSA2Bench(true) {}
+    };
+
+    class DVBCSA2DecryptBench: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2DecryptBench() : DVBCSA2Bench(false) {}
+    };
+}
+
+TSBENCH_REGISTER(DVBCSA2EncryptBench);
+TSBENCH_REGISTER(DVBCSA2DecryptBench);
+
+
+//----------------------------------------------------------------------------
+// PSIBuffer serialization and deserialization of binary fields.
+//----------------------------------------------------------------------------
+
+namespace {
+    class PSIBufferBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(PSIBufferBench);
+    public:
+        PSIBufferBench() : Benchmark(u"PSIBuffer", u"fields", 4 * FIELD_GROUPS), _duck(), _buffer(_duck, 9 * FIELD_GROUPS), _sum(0) {}
+
+        virtual void run() override
+        {
+            _buffer.readSeek(0);
+            _buffer.writeSeek(0);
+            for (size_t i = 0; i < FIELD_GROUPS; ++i) {
+                _buffer.putPID(ts::PID(i));
+                _buffer.putBits(i, 4);
+                _buffer.putBits(0xFF, 4);
+                _buffer.putUInt32(uint32_t(i));
+                _buffer.putUInt16(uint16_t(i));
+            }
+            for (size_t i = 0; i < FIELD_GROUPS; ++i) {
+                _sum += _buffer.getPID();
+                _sum += _buffer.getBits<uint8_t>(4);
+                _buffer.skipBits(4);
+                _sum += _buffer.getUInt32();
+                _sum += _buffer.getUInt16();
+            }
+        }
+
+    private:
+        static constexpr size_t FIELD_GROUPS = 1000;
+        ts::DuckContext _duck;
+        ts::PSIBuffer   _buffer;
+        uint64_t        _sum;
+    };
+}
+
+TSBENCH_REGISTER(PSIBufferBench);
+
+
+//----------------------------------------------------------------------------
+// Deserialization of large EIT, SDT and NIT, as in tables or tsanalyze.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TablesDeserializeBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TablesDeserializeBench);
+    public:
+        TablesDeserializeBench() : Benchmark(u"TablesDeserialize", u"tables", 3), _duck(), _eit(), _sdt(), _nit(), _sum(0) {}
+
+        virtual bool setup(ts::Report& report) override
+        {
+            // EIT schedule with many events, one short_event_descriptor per event.
+            ts::EIT eit(true, false, 0, 0, true, 0x0101, 0x0001, 0x0002);
+            const ts::Time start(2020, 1, 1, 0, 0);
+            for (uint16_t i = 0; i < 50; ++i) {
+                ts::EIT::Event& ev(eit.events.newEntry());
+                ev.event_id = i;
+                ev.start_time = start + i * ts::MilliSecPerHour;
+                ev.duration = 3600;
+                ev.running_status = 1;
+                ev.descs.add(_duck, ts::ShortEventDescriptor(u"eng", ts::UString::Format(u"Event %d", {i}), u"A short description of the event"));
+            }
+            eit.serialize(_duck, _eit);
+
+            // SDT with many services.
+            ts::SDT sdt(true, 0, true, 0x0001, 0x0002);
+            for (uint16_t i = 0; i < 200; ++i) {
+                sdt.services[i].setName(_duck, ts::UString::Format(u"Service %d", {i}));
+                sdt.services[i].setProvider(_duck, u"Provider");
+            }
+            sdt.serialize(_duck, _sdt);
+
+            // NIT with many transport streams, each with a service list.
+            ts::NIT nit(true, 0, true, 0x0003);
+            for (uint16_t tsid = 0; tsid < 50; ++tsid) {
+                ts::ServiceListDescriptor sld;
+                for (uint16_t i = 0; i < 10; ++i) {
+                    sld.entries.push_back(ts::ServiceListDescriptor::Entry(uint16_t(tsid * 10 + i), 1));
+                }
+                nit.transports[ts::TransportStreamId(tsid, 0x0002)].descs.add(_duck, sld);
+            }
+            nit.serialize(_duck, _nit);
+
+            return _eit.isValid() && _sdt.isValid() && _nit.isValid();
+        }
+
+        virtual void run() override
+        {
+            const ts::EIT eit(_duck, _eit);
+            const ts::SDT sdt(_duck, _sdt);
+            const ts::NIT nit(_duck, _nit);
+            _sum += eit.events.size() + sdt.services.size() + nit.transports.size();
+        }
+
+    private:
+        ts::DuckContext  _duck;
+        ts::BinaryTable  _eit;
+        ts::BinaryTable  _sdt;
+        ts::BinaryTable  _nit;
+        uint64_t         _sum;
+    };
+}
+
+TSBENCH_REGISTER(TablesDeserializeBench);
+
+
+//----------------------------------------------------------------------------
+// Serialization of a large multi-section SDT after a small modification,
+// as in plugins which regenerate tables (sdt, nit, bat, etc.)
+//----------------------------------------------------------------------------
+
+namespace {
+    class TablesSerializeBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TablesSerializeBench);
+    public:
+        TablesSerializeBench() : Benchmark(u"TablesSerialize", u"tables", 1), _duck(), _sdt(true, 0, true, 0x0001, 0x0002), _bin(), _count(0) {}
+
+        virtual bool setup(ts::Report& report) override
+        {
+            for (uint16_t id = 1; id <= 200; ++id) {
+                _sdt.services[id].running_status = 4;
+                _sdt.services[id].descs.add(_duck, ts::ServiceDescriptor(0x01, u"Provider", ts::UString::Format(u"Service number %d with a long name", {id})));
+            }
+            _sdt.serialize(_duck, _bin);
+            return _bin.isValid() && _bin.sectionCount() > 1;
+        }
+
+        virtual void run() override
+        {
+            // Modify one service each time, then serialize the complete table.
+            ts::DescriptorList& dlist(_sdt.services[uint16_t(1 + _count++ % 200)].descs);
+            dlist.clear();
+            dlist.add(_duck, ts::ServiceDescriptor(0x01, u"Provider", u"Modified service"));
+            _sdt.serialize(_duck, _bin);
+        }
+
+    private:
+        ts::DuckContext  _duck;
+        ts::SDT          _sdt;
+        ts::BinaryTable  _bin;
+        size_t           _count;
+    };
+}
+
+TSBENCH_REGISTER(TablesSerializeBench);
+
+
+//----------------------------------------------------------------------------
+// Decoding of the event names and descriptions in a full-week EPG.
+//----------------------------------------------------------------------------
+
+namespace {
+    class EPGDecodeBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(EPGDecodeBench);
+    public:
+        EPGDecodeBench() : Benchmark(u"EPGDecode", u"epg", 1), _duck(), _eits(), _sum(0) {}
+
+        virtual bool setup(ts::Report& report) override
+        {
+            // Program names and descriptions, with accented characters, are repeated along the week.
+            static const ts::UChar* const titles[] = {
+                u"Journal t\u00E9l\u00E9vis\u00E9", u"M\u00E9t\u00E9o", u"Le Magazine de la sant\u00E9", u"S\u00E9rie : Les Rivi\u00E8res pourpres",
+                u"Documentaire : Sur la piste des \u00E9l\u00E9phants", u"Cin\u00E9ma : Le Fabuleux Destin d'Am\u00E9lie Poulain",
+                u"Jeu : Questions pour un champion", u"Dessins anim\u00E9s", u"T\u00E9l\u00E9film : L'\u00C9t\u00E9 o\u00F9 tout a chang\u00E9",
+                u"Sport : R\u00E9sum\u00E9 de la journ\u00E9e", u"D\u00E9bat : O\u00F9 va l'Europe ?", u"Musique : Concert \u00E0 l'Op\u00E9ra",
+            };
+            static const ts::UChar* const texts[] = {
+                u"Toute l'actualit\u00E9 nationale et internationale, pr\u00E9sent\u00E9e en direct depuis nos studios, avec les reportages de nos envoy\u00E9s sp\u00E9ciaux.",
+                u"Les pr\u00E9visions m\u00E9t\u00E9orologiques d\u00E9taill\u00E9es pour les prochains jours, r\u00E9gion par r\u00E9gion, et les tendances \u00E0 plus long terme.",
+                u"Une \u00E9quipe de m\u00E9decins r\u00E9pond aux questions des t\u00E9l\u00E9spectateurs et d\u00E9crypte les derni\u00E8res avanc\u00E9es de la m\u00E9decine.",
+                u"Alors que l'enqu\u00EAte pi\u00E9tine, le commissaire d\u00E9couvre un indice troublant qui le ram\u00E8ne vingt ans en arri\u00E8re, \u00E0 l'\u00E9poque o\u00F9...",
+                u"Au c\u0153ur de la savane africaine, une famille d'\u00E9l\u00E9phants entreprend un long voyage \u00E0 la recherche de points d'eau.",
+                u"Une jeune serveuse d'un caf\u00E9 de Montmartre d\u00E9cide de consacrer sa vie \u00E0 r\u00E9parer le bonheur des gens qui l'entourent.",
+                u"Quatre candidats s'affrontent sur des questions de culture g\u00E9n\u00E9rale. Qui remportera la finale de la semaine ?",
+                u"Un \u00E9t\u00E9 d\u00E9cisif pour une famille r\u00E9unie dans la maison de vacances de l'enfance, o\u00F9 les secrets refont surface.",
+            };
+            static constexpr uint16_t SERVICE_COUNT = 20;
+            static constexpr int DAYS = 7;
+            static constexpr int EVENTS_PER_DAY = 24;
+
+            const ts::Time start(2020, 1, 1, 0, 0);
+            for (uint16_t srv = 0; srv < SERVICE_COUNT; ++srv) {
+                ts::EIT eit(true, false, 0, 0, true, uint16_t(0x0100 + srv), 0x0001, 0x0002);
+                for (int i = 0; i < DAYS * EVENTS_PER_DAY; ++i) {
+                    ts::EIT::Event& ev(eit.events.newEntry());
+                    ev.event_id = uint16_t(i);
+                    ev.start_time = start + i * ts::MilliSecPerHour;
+                    ev.duration = 3600;
+                    ev.running_status = 1;
+                    const size_t index = size_t(i + srv);
+                    ev.descs.add(_duck, ts::ShortEventDescriptor(u"fre", titles[index % (sizeof(titles) / sizeof(titles[0]))], texts[index % (sizeof(texts) / sizeof(texts[0]))]));
+                }
+                _eits.push_back(ts::BinaryTable());
+                eit.serialize(_duck, _eits.back());
+                if (!_eits.back().isValid()) {
+                    report.error(u"error serializing EIT for service %d", {srv});
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            for (auto it = _eits.begin(); it != _eits.end(); ++it) {
+                const ts::EIT eit(_duck, *it);
+                for (auto ev = eit.events.begin(); ev != eit.events.end(); ++ev) {
+                    for (size_t i = 0; i < ev->second.descs.count(); ++i) {
+                        const ts::ShortEventDescriptor sed(_duck, *ev->second.descs[i]);
+                        _sum += sed.event_name.size() + sed.text.size();
+                    }
+                }
+            }
+        }
+
+    private:
+        ts::DuckContext              _duck;
+        std::vector<ts::BinaryTable> _eits;
+        uint64_t                     _sum;
+    };
+}
+
+TSBENCH_REGISTER(EPGDecodeBench);
+
+
+//----------------------------------------------------------------------------
+// UString conversions between UTF-8 and UTF-16.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Kinds of text for the conversion benchmarks.
+    enum TextCorpus {
+        MIXED_TEXT,         // Mostly ASCII with some Latin and Greek characters.
+        ASCII_TEXT,         // Pure ASCII, as in file names, XML and JSON.
+        MULTILINGUAL_TEXT,  // Mostly non-ASCII characters, 2 and 3 bytes in UTF-8.
+    };
+
+    class UStringBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(UStringBench);
+    public:
+        UStringBench(bool from_utf8, TextCorpus corpus, const ts::UString& name) :
+            Benchmark(name, u"characters", TEXT_SIZE),
+            _from_utf8(from_utf8),
+            _corpus(corpus),
+            _utf8(),
+            _utf16(),
+            _size(0)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            ts::UString line;
+            switch (_corpus) {
+                case ASCII_TEXT:
+                    line = u"<service service_id=\"0x0001\" name=\"The quick brown fox jumps over the lazy dog\"/>\n";
+                    break;
+                case MULTILINGUAL_TEXT:
+                    line = u"\u041D\u043E\u0432\u043E\u0441\u0442\u0438 \u0434\u043D\u044F - \u65B0\u95FB\u8054\u64AD - \u0395\u03B9\u03B4\u03AE\u03C3\u03B5\u03B9\u03C2 \u03C4\u03B7\u03C2 \u03B7\u03BC\u03AD\u03C1\u03B1\u03C2 - \u4ECA\u65E5\u306E\u30CB\u30E5\u30FC\u30B9 - Nachrichten f\u00FCr \u00D6sterreich\n";
+                    break;
+                case MIXED_TEXT:
+                default:
+                    // As found in most service names and EPG.
+                    line = u"Programme TV \u00E9t\u00E9 2020 - \u0395\u03BB\u03BB\u03B7\u03BD\u03B9\u03BA\u03AC - The quick brown fox jumps over the lazy dog\n";
+                    break;
+            }
+            _utf16.clear();
+            while (_utf16.size() < TEXT_SIZE) {
+                _utf16.append(line);
+            }
+            _utf16.resize(TEXT_SIZE);
+            _utf8 = _utf16.toUTF8();
+            return true;
+        }
+
+        virtual void run() override
+        {
+            if (_from_utf8) {
+                _size += ts::UString::FromUTF8(_utf8).size();
+            }
+            else {
+                _size += _utf16.toUTF8().size();
+            }
+        }
+
+    private:
+        static constexpr size_t TEXT_SIZE = 64 * 1024;
+        bool        _from_utf8;
+        TextCorpus  _corpus;
+        std::string _utf8;
+        ts::UString _utf16;
+        size_t      _size;
+    };
+
+    class FromUTF8Bench: public UStringBench
+    {
+    public:
+        FromUTF8Bench() : UStringBench(true, MIXED_TEXT, u"UString::FromUTF8") {}
+    };
+
+    class ToUTF8Bench: public UStringBench
+    {
+    public:
+        ToUTF8Bench() : UStringBench(false, MIXED_TEXT, u"UString::toUTF8") {}
+    };
+
+    class FromUTF8AsciiBench: public UStringBench
+    {
+    public:
+        FromUTF8AsciiBench() : UStringBench(true, ASCII_TEXT, u"UString::FromUTF8::ascii") {}
+    };
+
+    class ToUTF8AsciiBench: public UStringBench
+    {
+    public:
+        ToUTF8AsciiBench() : UStringBench(false, ASCII_TEXT, u"UString::toUTF8::ascii") {}
+    };
+
+    class FromUTF8MultilingualBench: public UStringBench
+    {
+    public:
+        FromUTF8MultilingualBench() : UStringBench(true, MULTILINGUAL_TEXT, u"UString::FromUTF8::multilingual") {}
+    };
+
+    class ToUTF8MultilingualBench: public UStringBench
+    {
+    public:
+        ToUTF8MultilingualBench() : UStringBench(false, MULTILINGUAL_TEXT, u"UString::toUTF8::multilingual") {}
+    };
+}
+
+TSBENCH_REGISTER(FromUTF8Bench);
+TSBENCH_REGISTER(ToUTF8Bench);
+TSBENCH_REGISTER(FromUTF8AsciiBench);
+TSBENCH_REGISTER(ToUTF8AsciiBench);
+TSBENCH_REGISTER(FromUTF8MultilingualBench);
+TSBENCH_REGISTER(ToUTF8MultilingualBench);
+
+
+//----------------------------------------------------------------------------
+// Hexadecimal dump with offset and ASCII, as in tsdump --raw.
+//----------------------------------------------------------------------------
+
+namespace {
+    class HexaDumpBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(HexaDumpBench);
+    public:
+        HexaDumpBench(bool to_stream, const ts::UString& name) :
+            Benchmark(name, u"bytes", DUMP_SIZE),
+            _to_stream(to_stream),
+            _data(),
+            _output()
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            _data.resize(DUMP_SIZE);
+            for (size_t i = 0; i < _data.size(); ++i) {
+                _data[i] = uint8_t(i * 7 + (i >> 8));
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            _output.str(std::string());
+            if (_to_stream) {
+                ts::UString::Dump(_output, _data.data(), _data.size(), FLAGS, 0, 16);
+            }
+            else {
+                _output << ts::UString::Dump(_data.data(), _data.size(), FLAGS, 0, 16);
+            }
+        }
+
+    private:
+        static constexpr size_t DUMP_SIZE = 256 * 1024;
+        static constexpr uint32_t FLAGS = ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET | ts::UString::WIDE_OFFSET | ts::UString::BPL;
+        bool               _to_stream;
+        ts::ByteBlock      _data;
+        std::ostringstream _output;
+    };
+
+    class HexaDumpStringBench: public HexaDumpBench
+    {
+    public:
+        HexaDumpStringBench() : HexaDumpBench(false, u"UString::Dump") {}
+    };
+
+    class HexaDumpStreamBench: public HexaDumpBench
+    {
+    public:
+        HexaDumpStreamBench() : HexaDumpBench(true, u"UString::Dump::stream") {}
+    };
+}
+
+TSBENCH_REGISTER(HexaDumpStringBench);
+TSBENCH_REGISTER(HexaDumpStreamBench);
+
+
+//----------------------------------------------------------------------------
+// SectionDemux on all PSI/SI PID's of a stream.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SectionDemuxBench: public tsbench::Benchmark, private ts::TableHandlerInterface
+    {
+        TS_NOCOPY(SectionDemuxBench);
+    public:
+        SectionDemuxBench() :
+            Benchmark(u"SectionDemux", u"packets", STREAM_PACKETS),
+            _packets(),
+            _duck(),
+            _demux(_duck, this, nullptr, ts::AllPIDs),
+            _tables(0)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            tsbench::SyntheticStream(_packets, STREAM_PACKETS);
+            return true;
+        }
+
+        virtual void run() override
+        {
+            // Reset the demux to get all tables again.
+            _demux.reset();
+            for (auto it = _packets.begin(); it != _packets.end(); ++it) {
+                _demux.feedPacket(*it);
+            }
+        }
+
+    private:
+        ts::TSPacketVector _packets;
+        ts::DuckContext    _duck;
+        ts::SectionDemux   _demux;
+        uint64_t           _tables;
+
+        virtual void handleTable(ts::SectionDemux& demux, const ts::BinaryTable& table) override
+        {
+            _tables++;
+        }
+    };
+}
+
+TSBENCH_REGISTER(SectionDemuxBench);
+
+
+//----------------------------------------------------------------------------
+// TSAnalyzer, as used in tsanalyze or the analyze plugin.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TSAnalyzerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TSAnalyzerBench);
+    public:
+        TSAnalyzerBench() :
+            Benchmark(u"TSAnalyzer", u"packets", STREAM_PACKETS),
+            _packets(),
+            _duck(),
+            _analyzer(_duck)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            tsbench::SyntheticStream(_packets, STREAM_PACKETS);
+            return true;
+        }
+
+        virtual void run() override
+        {
+            _analyzer.reset();
+            for (auto it = _packets.begin(); it != _packets.end(); ++it) {
+                _analyzer.feedPacket(*it);
+            }
+        }
+
+    private:
+        ts::TSPacketVector _packets;
+        ts::DuckContext    _duck;
+        ts::TSAnalyzer     _analyzer;
+    };
+}
+
+TSBENCH_REGISTER(TSAnalyzerBench);
+
+
+//----------------------------------------------------------------------------
+// TSAnalyzer report, as produced at each --interval in the analyze plugin.
+// This is the time which is no longer spent in the packet path of tsp since
+// the reports are produced in a separate thread.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TSAnalyzerReportBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TSAnalyzerReportBench);
+    public:
+        TSAnalyzerReportBench() :
+            Benchmark(u"TSAnalyzerReport", u"reports", 1),
+            _duck(),
+            _analyzer(_duck),
+            _options(),
+            _output()
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            ts::TSPacketVector packets;
+            tsbench::SyntheticStream(packets, STREAM_PACKETS);
+            _analyzer.reset();
+            _analyzer.setBitrateHint(10000000);
+            for (auto it = packets.begin(); it != packets.end(); ++it) {
+                _analyzer.feedPacket(*it);
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            _output.str(std::string());
+            _analyzer.report(_output, _options);
+        }
+
+    private:
+        ts::DuckContext       _duck;
+        ts::TSAnalyzerReport  _analyzer;
+        ts::TSAnalyzerOptions _options;
+        std::ostringstream    _output;
+    };
+}
+
+TSBENCH_REGISTER(TSAnalyzerReportBench);
+
+
+//----------------------------------------------------------------------------
+// TablesLogger with --all-sections on a long capture, as in tstables.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TablesLoggerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TablesLoggerBench);
+    public:
+        TablesLoggerBench(const ts::UChar* name, bool onlyChanges) :
+            Benchmark(name, u"packets", LOGGER_PACKETS),
+            _onlyChanges(onlyChanges),
+            _packets(),
+            _output(nullptr),
+            _duck(&NULLREP, &_output),
+            _display(_duck),
+            _logger(_display)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            tsbench::SyntheticStream(_packets, LOGGER_PACKETS);
+            ts::Args args(u"", u"", ts::Args::NO_EXIT_ON_ERROR);
+            args.redirectReport(&report);
+            _logger.defineArgs(args);
+            ts::UStringVector params;
+            params.push_back(u"--all-sections");
+            if (_onlyChanges) {
+                params.push_back(u"--only-changes");
+            }
+            return args.analyze(u"tables", params, false) && _logger.loadArgs(_duck, args);
+        }
+
+        virtual void run() override
+        {
+            _logger.open();
+            for (auto it = _packets.begin(); it != _packets.end(); ++it) {
+                _logger.feedPacket(*it);
+            }
+            _logger.close();
+        }
+
+    private:
+        // The PSI/SI tables are repeated 1000 times.
+        static constexpr size_t LOGGER_PACKETS = 100000;
+
+        bool               _onlyChanges;
+        ts::TSPacketVector _packets;
+        std::ostream       _output;   // Discard all text output.
+        ts::DuckContext    _duck;
+        ts::TablesDisplay  _display;
+        ts::TablesLogger   _logger;
+    };
+
+    class TablesLoggerAllBench: public TablesLoggerBench
+    {
+    public:
+        TablesLoggerAllBench() : TablesLoggerBench(u"TablesLogger::all-sections", false) {}
+    };
+
+    class TablesLoggerChangesBench: public TablesLoggerBench
+    {
+    public:
+        TablesLoggerChangesBench() : TablesLoggerBench(u"TablesLogger::only-changes", true) {}
+    };
+}
+
+TSBENCH_REGISTER(TablesLoggerAllBench);
+TSBENCH_REGISTER(TablesLoggerChangesBench);
+
+
+//----------------------------------------------------------------------------
+// ContinuityAnalyzer, as used in the continuity plugin.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ContinuityAnalyzerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(ContinuityAnalyzerBench);
+    public:
+        ContinuityAnalyzerBench() :
+            Benchmark(u"ContinuityAnalyzer", u"packets", STREAM_PACKETS),
+            _packets(),
+            _analyzer(ts::AllPIDs)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            tsbench::SyntheticStream(_packets, STREAM_PACKETS);
+            return true;
+        }
+
+        virtual void run() override
+        {
+            _analyzer.reset();
+            _analyzer.feedPackets(_packets.data(), _packets.size());
+        }
+
+    private:
+        ts::TSPacketVector     _packets;
+        ts::ContinuityAnalyzer _analyzer;
+    };
+}
+
+TSBENCH_REGISTER(ContinuityAnalyzerBench);
+
+
+//----------------------------------------------------------------------------
+// CyclingPacketizer, a large carousel of sections, as in the inject plugin.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CyclingPacketizerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(CyclingPacketizerBench);
+    public:
+        CyclingPacketizerBench() :
+            Benchmark(u"CyclingPacketizer", u"packets", STREAM_PACKETS),
+            _duck(),
+            _pzer(_duck, 0x0200, ts::CyclingPacketizer::ALWAYS, 10000000),
+            _sum(0)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            // Half of the sections have a repetition rate, the other half are unscheduled.
+            ts::ByteBlock payload(SECTION_PAYLOAD);
+            for (size_t i = 0; i < SECTION_COUNT; ++i) {
+                payload[0] = uint8_t(i);
+                _pzer.addSection(new ts::Section(0x80, true, uint16_t(i), 0, true, 0, 0, payload.data(), payload.size()), i % 2 == 0 ? 0 : 2000);
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            ts::TSPacket pkt;
+            for (size_t i = 0; i < STREAM_PACKETS; ++i) {
+                _pzer.getNextPacket(pkt);
+                _sum += pkt.b[4];
+            }
+        }
+
+    private:
+        static constexpr size_t SECTION_COUNT = 1000;
+        static constexpr size_t SECTION_PAYLOAD = 4000;
+        ts::DuckContext         _duck;
+        ts::CyclingPacketizer   _pzer;
+        uint64_t                _sum;
+    };
+}
+
+TSBENCH_REGISTER(CyclingPacketizerBench);
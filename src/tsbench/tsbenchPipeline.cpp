@@ -0,0 +1,265 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  End-to-end benchmarks of the tsp plugin chain.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsTSProcessor.h"
+#include "tsInputPlugin.h"
+#include "tsPluginRepository.h"
+#include "tsSysUtils.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Number of packets in the looped synthetic stream. All PID's in the synthetic
+    // stream have a multiple of 16 packets so that continuity counters are preserved
+    // when the stream is looped.
+    constexpr size_t LOOP_PACKETS = 1600;
+
+    // Number of packets through the plugin chain in one iteration.
+    constexpr size_t PIPELINE_PACKETS = 200000;
+
+    // Number of packets in one iteration of the analyze benchmarks. The reports are
+    // produced every second, an iteration lasts several seconds on a typical system.
+    constexpr size_t ANALYZE_PACKETS = 5000000;
+}
+
+
+//----------------------------------------------------------------------------
+// An in-process input plugin which loops on the synthetic stream.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SyntheticInputPlugin: public ts::InputPlugin
+    {
+        TS_NOBUILD_NOCOPY(SyntheticInputPlugin);
+    public:
+        SyntheticInputPlugin(ts::TSP* tsp_) :
+            InputPlugin(tsp_, u"Generate a synthetic stream for benchmarks", u"[options] count"),
+            _packets(),
+            _max_count(0),
+            _count(0)
+        {
+            option(u"", 0, UNSIGNED, 1, 1);
+            help(u"", u"Specify the number of packets to generate.");
+        }
+
+        virtual bool getOptions() override
+        {
+            _max_count = intValue<ts::PacketCounter>(u"");
+            return true;
+        }
+
+        virtual bool start() override
+        {
+            if (_packets.empty()) {
+                tsbench::SyntheticStream(_packets, LOOP_PACKETS);
+            }
+            _count = 0;
+            return true;
+        }
+
+        virtual bool setReceiveTimeout(ts::MilliSecond timeout) override
+        {
+            return true;
+        }
+
+        virtual bool abortInput() override
+        {
+            return true;
+        }
+
+        virtual size_t receive(ts::TSPacket* buffer, ts::TSPacketMetadata* pkt_data, size_t max_packets) override
+        {
+            size_t n = 0;
+            while (n < max_packets && _count < _max_count) {
+                // Copy contiguous packets from the looped stream.
+                const size_t index = size_t(_count % _packets.size());
+                const size_t size = size_t(std::min<ts::PacketCounter>(std::min(max_packets - n, _packets.size() - index), _max_count - _count));
+                ts::TSPacket::Copy(buffer + n, &_packets[index], size);
+                n += size;
+                _count += size;
+            }
+            return n;
+        }
+
+    private:
+        ts::TSPacketVector _packets;
+        ts::PacketCounter  _max_count;
+        ts::PacketCounter  _count;
+    };
+}
+
+TS_REGISTER_INPUT_PLUGIN(u"tsbench", SyntheticInputPlugin);
+
+
+//----------------------------------------------------------------------------
+// A pipeline benchmark: run a complete tsp session on each iteration.
+//----------------------------------------------------------------------------
+
+namespace {
+    class PipelineBench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(PipelineBench);
+    public:
+        // Each plugin description is a list of space-separated words.
+        // The output plugin is described by its name and arguments.
+        PipelineBench(const ts::UString& name,
+                      const ts::UStringList& plugins,
+                      const ts::UStringVector& output = ts::UStringVector({u"drop"}),
+                      size_t packets = PIPELINE_PACKETS) :
+            Benchmark(name, u"packets", packets),
+            _packets(packets),
+            _plugins(plugins),
+            _output(output),
+            _args(),
+            _report(nullptr)
+        {
+        }
+
+        virtual bool setup(ts::Report& report) override
+        {
+            _report = &report;
+            _args.app_name = u"tsbench";
+            _args.fixed_bitrate = 10000000;
+            _args.input.set(u"tsbench", ts::UStringVector({ts::UString::Decimal(_packets, 0, true, ts::UString())}));
+            _args.output.set(_output.front(), ts::UStringVector(_output.begin() + 1, _output.end()));
+            _args.plugins.clear();
+
+            // Processor plugins are shared libraries, skip the benchmark if one is not found.
+            for (auto it = _plugins.begin(); it != _plugins.end(); ++it) {
+                ts::UStringVector words;
+                it->split(words, u' ', true, true);
+                if (ts::PluginRepository::Instance()->getProcessor(words.front(), report) == nullptr) {
+                    return false;
+                }
+                _args.plugins.push_back(ts::PluginOptions(words.front(), ts::UStringVector(words.begin() + 1, words.end())));
+            }
+            return true;
+        }
+
+        virtual void run() override
+        {
+            ts::TSProcessor tsproc(*_report);
+            if (tsproc.start(_args)) {
+                tsproc.waitForTermination();
+            }
+        }
+
+    private:
+        const size_t            _packets;
+        const ts::UStringList   _plugins;
+        const ts::UStringVector _output;
+        ts::TSProcessorArgs     _args;
+        ts::Report*             _report;
+    };
+
+    class NullPipelineBench: public PipelineBench
+    {
+    public:
+        NullPipelineBench() : PipelineBench(u"tsp::input-output", ts::UStringList()) {}
+    };
+
+    class FilterPipelineBench: public PipelineBench
+    {
+    public:
+        FilterPipelineBench() : PipelineBench(u"tsp::filter", ts::UStringList({u"filter --pid 0x0101 --pid 0x0102"})) {}
+    };
+
+    class ContinuityPipelineBench: public PipelineBench
+    {
+    public:
+        ContinuityPipelineBench() : PipelineBench(u"tsp::continuity", ts::UStringList({u"continuity"})) {}
+    };
+
+    class ChainPipelineBench: public PipelineBench
+    {
+    public:
+        ChainPipelineBench() : PipelineBench(u"tsp::chain", ts::UStringList({u"continuity", u"filter --negate --pid 0x0102", u"remap 0x0101=0x0201"})) {}
+    };
+
+    // Output file of the analyze benchmarks, deleted after each benchmark.
+    const ts::UString& AnalyzeOutputFile()
+    {
+        static const ts::UString file(ts::TempFile(u".txt"));
+        return file;
+    }
+
+    // Interval reports of plugin "analyze", formatted and written in its report thread.
+    class AnalyzeIntervalBench: public PipelineBench
+    {
+    public:
+        AnalyzeIntervalBench(const ts::UString& name = u"tsp::analyze-interval", const ts::UString& options = ts::UString()) :
+            PipelineBench(name, ts::UStringList({u"analyze --interval 1 --output-file " + AnalyzeOutputFile() + options}), ts::UStringVector({u"drop"}), ANALYZE_PACKETS)
+        {
+        }
+
+        virtual void cleanup() override
+        {
+            ts::DeleteFile(AnalyzeOutputFile());
+        }
+    };
+
+    // Same with the reports in the packet processing thread, for comparison.
+    class AnalyzeIntervalInlineBench: public AnalyzeIntervalBench
+    {
+    public:
+        AnalyzeIntervalInlineBench() : AnalyzeIntervalBench(u"tsp::analyze-interval-inline", u" --inline-report") {}
+    };
+}
+
+#if !defined(TS_WINDOWS)
+namespace {
+    // Output to another process through a pipe, using the default pipe buffer size of TSDuck.
+    class ForkPipelineBench: public PipelineBench
+    {
+    public:
+        ForkPipelineBench() : PipelineBench(u"tsp::fork", ts::UStringList(), ts::UStringVector({u"fork", u"cat >/dev/null"})) {}
+    };
+
+    // Same with the usual system default pipe buffer size (64 kB), for comparison.
+    class ForkSmallPipelineBench: public PipelineBench
+    {
+    public:
+        ForkSmallPipelineBench() : PipelineBench(u"tsp::fork-64k", ts::UStringList(), ts::UStringVector({u"fork", u"--buffered-packets", u"348", u"cat >/dev/null"})) {}
+    };
+}
+
+TSBENCH_REGISTER(ForkPipelineBench);
+TSBENCH_REGISTER(ForkSmallPipelineBench);
+#endif
+
+TSBENCH_REGISTER(NullPipelineBench);
+TSBENCH_REGISTER(FilterPipelineBench);
+TSBENCH_REGISTER(ContinuityPipelineBench);
+TSBENCH_REGISTER(ChainPipelineBench);
+TSBENCH_REGISTER(AnalyzeIntervalBench);
+TSBENCH_REGISTER(AnalyzeIntervalInlineBench);
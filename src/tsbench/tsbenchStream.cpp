@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Synthetic transport stream for benchmarks.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsDuckContext.h"
+#include "tsOneShotPacketizer.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsMemory.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Characteristics of the synthetic stream.
+    constexpr uint16_t      TS_ID = 0x0001;
+    constexpr uint16_t      NETWORK_ID = 0x0001;
+    constexpr size_t        CYCLE_PACKETS = 100;     // Number of packets between PSI/SI tables.
+    constexpr size_t        VIDEO_PER_CYCLE = 80;    // Number of video packets per cycle.
+    constexpr size_t        AUDIO_PER_CYCLE = 8;     // Number of audio packets per cycle.
+    constexpr size_t        VIDEO_PES_PACKETS = 20;  // Number of TS packets per video PES packet.
+    constexpr ts::BitRate   BITRATE = 10000000;      // Nominal bitrate, for PCR values.
+
+    // Packetize a table.
+    void Packetize(ts::DuckContext& duck, const ts::AbstractTable& table, ts::PID pid, ts::TSPacketVector& packets)
+    {
+        ts::OneShotPacketizer pzer(duck, pid, true);
+        pzer.addTable(duck, table);
+        pzer.getPackets(packets);
+    }
+
+    // Append a packet to the stream, with the next continuity counter in the PID.
+    void Append(ts::TSPacketVector& packets, const ts::TSPacket& pkt, uint8_t* cc)
+    {
+        packets.push_back(pkt);
+        if (pkt.getPID() != ts::PID_NULL) {
+            packets.back().setCC(cc[pkt.getPID()]);
+            cc[pkt.getPID()] = (cc[pkt.getPID()] + 1) & ts::CC_MASK;
+        }
+    }
+
+    // Append a PES packet payload in a TS packet.
+    void AppendPES(ts::TSPacketVector& packets, ts::PID pid, bool start, uint8_t stream_id, uint32_t& seed, uint8_t* cc)
+    {
+        ts::TSPacket pkt;
+        pkt.init(pid);
+        // Deterministic pseudo-random payload (linear congruential generator).
+        for (size_t i = 4; i < ts::PKT_SIZE; ++i) {
+            seed = seed * 1103515245 + 12345;
+            pkt.b[i] = uint8_t(seed >> 16);
+        }
+        if (start) {
+            // Minimal PES header, unbounded length, no PTS.
+            pkt.setPUSI();
+            pkt.b[4] = 0x00;
+            pkt.b[5] = 0x00;
+            pkt.b[6] = 0x01;
+            pkt.b[7] = stream_id;
+            pkt.b[8] = 0x00;
+            pkt.b[9] = 0x00;
+            pkt.b[10] = 0x80;
+            pkt.b[11] = 0x00;
+            pkt.b[12] = 0x00;
+        }
+        Append(packets, pkt, cc);
+    }
+}
+
+void tsbench::SyntheticStream(ts::TSPacketVector& packets, size_t count)
+{
+    ts::DuckContext duck;
+
+    // Build PSI/SI tables.
+    ts::PAT pat(0, true, TS_ID);
+    pat.pmts[SYNTHETIC_SERVICE_ID] = SYNTHETIC_PMT_PID;
+
+    ts::PMT pmt(0, true, SYNTHETIC_SERVICE_ID, SYNTHETIC_VIDEO_PID);
+    pmt.streams[SYNTHETIC_VIDEO_PID].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt.streams[SYNTHETIC_AUDIO_PID].stream_type = ts::ST_MPEG2_AUDIO;
+
+    ts::SDT sdt(true, 0, true, TS_ID, NETWORK_ID);
+    sdt.services[SYNTHETIC_SERVICE_ID].setName(duck, u"Benchmark");
+    sdt.services[SYNTHETIC_SERVICE_ID].setProvider(duck, u"TSDuck");
+
+    ts::TSPacketVector tables;
+    ts::TSPacketVector pkts;
+    Packetize(duck, pat, ts::PID_PAT, pkts);
+    tables.insert(tables.end(), pkts.begin(), pkts.end());
+    Packetize(duck, pmt, SYNTHETIC_PMT_PID, pkts);
+    tables.insert(tables.end(), pkts.begin(), pkts.end());
+    Packetize(duck, sdt, ts::PID_SDT, pkts);
+    tables.insert(tables.end(), pkts.begin(), pkts.end());
+
+    // Build the stream, cycle after cycle.
+    uint8_t cc[ts::PID_MAX];
+    TS_ZERO(cc);
+    uint32_t seed = 0;
+    size_t video_count = 0;
+    size_t audio_count = 0;
+
+    packets.clear();
+    packets.reserve(count);
+
+    while (packets.size() < count) {
+        const size_t index = packets.size() % CYCLE_PACKETS;
+        if (index < tables.size()) {
+            Append(packets, tables[index], cc);
+        }
+        else if (index < tables.size() + VIDEO_PER_CYCLE) {
+            const bool start = video_count++ % VIDEO_PES_PACKETS == 0;
+            AppendPES(packets, SYNTHETIC_VIDEO_PID, start, 0xE0, seed, cc);
+            if (start) {
+                // PCR in the first packet of each video PES packet.
+                packets.back().setPCR((uint64_t(packets.size() - 1) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / BITRATE, true);
+            }
+        }
+        else if (index < tables.size() + VIDEO_PER_CYCLE + AUDIO_PER_CYCLE) {
+            AppendPES(packets, SYNTHETIC_AUDIO_PID, audio_count++ % 2 == 0, 0xC0, seed, cc);
+        }
+        else {
+            Append(packets, ts::NullPacket, cc);
+        }
+    }
+}
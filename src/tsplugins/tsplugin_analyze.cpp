@@ -36,6 +36,10 @@
 #include "tsTSAnalyzerReport.h"
 #include "tsTSSpeedMetrics.h"
 #include "tsSysUtils.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
 TSDUCK_SOURCE;
 
 
@@ -44,12 +48,13 @@ TSDUCK_SOURCE;
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class AnalyzePlugin: public ProcessorPlugin
+    class AnalyzePlugin: public ProcessorPlugin, private Thread
     {
         TS_NOBUILD_NOCOPY(AnalyzePlugin);
     public:
         // Implementation of plugin API
         AnalyzePlugin(TSP*);
+        virtual ~AnalyzePlugin();
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
@@ -60,6 +65,7 @@ namespace ts {
         UString           _output_name;
         NanoSecond        _output_interval;
         bool              _multiple_output;
+        bool              _inline_report;
         TSAnalyzerOptions _analyzer_options;
 
         // Working data:
@@ -67,11 +73,27 @@ namespace ts {
         std::ostream*     _output;
         TSSpeedMetrics    _metrics;
         NanoSecond        _next_report;
-        TSAnalyzerReport  _analyzer;
+        DuckContext       _duck2;        // TSDuck context of second analyzer.
+        TSAnalyzerReport  _analyzer1;    // Two analyzers, one is fed with packets while the
+        TSAnalyzerReport  _analyzer2;    // other one is reported and reset by the report thread.
+        TSAnalyzerReport* _analyzer;     // Analyzer which is currently fed with packets.
+
+        // With --interval, the reports are produced by an internal thread.
+        // The same condition is used to signal a new report and its completion:
+        // each thread waits only when the other one has something to do.
+        Mutex             _mutex;
+        Condition         _cond;
+        TSAnalyzerReport* _pending;      // Analyzer to report in the thread, null if none.
+        bool              _terminate;    // Request to terminate the report thread.
+        bool              _report_error; // Error while producing a report in the thread.
 
         bool openOutput();
         void closeOutput();
-        bool produceReport();
+        bool produceReport(TSAnalyzerReport&);
+        void terminateThread();
+
+        // Invoked in the context of the report thread.
+        virtual void main() override;
     };
 }
 
@@ -87,12 +109,21 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     _output_name(),
     _output_interval(0),
     _multiple_output(false),
+    _inline_report(false),
     _analyzer_options(),
     _output_stream(),
     _output(),
     _metrics(),
     _next_report(0),
-    _analyzer(duck)
+    _duck2(tsp_),
+    _analyzer1(duck),
+    _analyzer2(_duck2),
+    _analyzer(&_analyzer1),
+    _mutex(),
+    _cond(),
+    _pending(nullptr),
+    _terminate(false),
+    _report_error(false)
 {
     // Define all standard analysis options.
     duck.defineArgsForStandards(*this);
@@ -104,7 +135,16 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
          u"Produce a new output file at regular intervals. "
          u"The interval value is in seconds. "
          u"After outputing a file, the analysis context is reset, "
-         u"ie. each output file contains a fully independent analysis.");
+         u"ie. each output file contains a fully independent analysis. "
+         u"The reports are formatted and written in the background, "
+         u"without interrupting the packet processing, unless --inline-report is specified.");
+
+    option(u"inline-report");
+    help(u"inline-report",
+         u"With --interval, format and write the reports in the packet processing thread, "
+         u"as in previous versions of this plugin. The packet processing is interrupted "
+         u"during the production of each report. "
+         u"This option is mostly useful to evaluate the effect of the report thread.");
 
     option(u"multiple-files", 'm');
     help(u"multiple-files",
@@ -127,10 +167,12 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
 bool ts::AnalyzePlugin::getOptions()
 {
     duck.loadArgs(*this);
+    _duck2.loadArgs(*this);
     _analyzer_options.loadArgs(duck, *this);
     _output_name = value(u"output-file");
     _output_interval = NanoSecPerSec * intValue<Second>(u"interval", 0);
     _multiple_output = present(u"multiple-files");
+    _inline_report = present(u"inline-report");
     return true;
 }
 
@@ -142,12 +184,24 @@ bool ts::AnalyzePlugin::getOptions()
 bool ts::AnalyzePlugin::start()
 {
     _output = _output_name.empty() ? &std::cout : &_output_stream;
-    _analyzer.setAnalysisOptions(_analyzer_options);
+    _analyzer1.reset();
+    _analyzer2.reset();
+    _analyzer1.setAnalysisOptions(_analyzer_options);
+    _analyzer2.setAnalysisOptions(_analyzer_options);
+    _analyzer = &_analyzer1;
 
     // For production of multiple reports at regular intervals.
     _metrics.start();
     _next_report = _output_interval;
 
+    // With --interval, start the report thread.
+    if (_output_interval > 0 && !_inline_report) {
+        _pending = nullptr;
+        _terminate = false;
+        _report_error = false;
+        Thread::start();
+    }
+
     // Create the output file. Note that this file is used only in the stop
     // method and could be created there. However, if the file cannot be
     // created, we do not want to wait all along the analysis and finally fail.
@@ -208,30 +262,62 @@ void ts::AnalyzePlugin::closeOutput()
 // Produce a report. Return true on success, false on error.
 //----------------------------------------------------------------------------
 
-bool ts::AnalyzePlugin::produceReport()
+bool ts::AnalyzePlugin::produceReport(TSAnalyzerReport& analyzer)
 {
     if (!openOutput()) {
         return false;
     }
     else {
-        // Set last known input bitrate as hint
-        _analyzer.setBitrateHint(tsp->bitrate());
-
         // Produce the report
-        _analyzer.report(*_output, _analyzer_options);
+        analyzer.report(*_output, _analyzer_options);
         closeOutput();
         return true;
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Terminate the report thread after completion of the pending report.
+// Void if the thread was not started or is already terminated.
+//----------------------------------------------------------------------------
+
+void ts::AnalyzePlugin::terminateThread()
+{
+    {
+        GuardCondition lock(_mutex, _cond);
+        _terminate = true;
+        lock.signal();
+    }
+    Thread::waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Destructor
+//----------------------------------------------------------------------------
+
+ts::AnalyzePlugin::~AnalyzePlugin()
+{
+    // The plugin may be deleted without being stopped, for instance when another
+    // plugin failed to start. The report thread must be terminated before the
+    // destruction of the mutex and condition.
+    terminateThread();
+}
+
+
 //----------------------------------------------------------------------------
 // Stop method
 //----------------------------------------------------------------------------
 
 bool ts::AnalyzePlugin::stop()
 {
-    produceReport();
+    if (_output_interval > 0 && !_inline_report) {
+        terminateThread();
+    }
+
+    // Report the last analysis.
+    _analyzer->setBitrateHint(tsp->bitrate());
+    produceReport(*_analyzer);
     return true;
 }
 
@@ -243,19 +329,76 @@ bool ts::AnalyzePlugin::stop()
 ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     // Feed the analyzer with one packet
-    _analyzer.feedPacket (pkt);
+    _analyzer->feedPacket(pkt);
 
     // With --interval, check if it is time to produce a report
     if (_output_interval > 0 && _metrics.processedPacket() && _metrics.sessionNanoSeconds() >= _next_report) {
-        // Time to produce a report.
-        if (!produceReport()) {
-            return TSP_END;
+        if (_inline_report) {
+            // Time to produce a report in the packet processing thread, then reset the analysis context.
+            _analyzer->setBitrateHint(tsp->bitrate());
+            if (!produceReport(*_analyzer)) {
+                return TSP_END;
+            }
+            _analyzer->reset();
+        }
+        else {
+            // Time to produce a report. Pass the current analyzer to the report thread
+            // and continue with the other one, which was reset after its last report.
+            GuardCondition lock(_mutex, _cond);
+            // Wait for the completion of the previous report if still in progress.
+            while (_pending != nullptr) {
+                lock.waitCondition();
+            }
+            if (_report_error) {
+                return TSP_END;
+            }
+            _analyzer->setBitrateHint(tsp->bitrate());
+            _pending = _analyzer;
+            _analyzer = _analyzer == &_analyzer1 ? &_analyzer2 : &_analyzer1;
+            lock.signal();
         }
-        // Reset analysis context.
-        _analyzer.reset();
         // Compute next report time.
         _next_report += _output_interval;
     }
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the report thread.
+//----------------------------------------------------------------------------
+
+void ts::AnalyzePlugin::main()
+{
+    tsp->debug(u"report thread started");
+
+    for (;;) {
+        // Wait for an analysis to report.
+        TSAnalyzerReport* analyzer = nullptr;
+        {
+            GuardCondition lock(_mutex, _cond);
+            while (_pending == nullptr && !_terminate) {
+                lock.waitCondition();
+            }
+            if (_pending == nullptr) {
+                break;
+            }
+            analyzer = _pending;
+        }
+
+        // Produce the report and reset the analysis context, outside the critical section.
+        const bool ok = produceReport(*analyzer);
+        analyzer->reset();
+
+        // Make the analyzer available again.
+        {
+            GuardCondition lock(_mutex, _cond);
+            _pending = nullptr;
+            _report_error = _report_error || !ok;
+            lock.signal();
+        }
+    }
+
+    tsp->debug(u"report thread completed");
+}
@@ -56,7 +56,36 @@ namespace ts {
     private:
         // Packet intervals and list of them.
         typedef std::pair<PacketCounter, PacketCounter> PacketRange;
-        typedef std::list<PacketRange> PacketRangeList;
+        typedef std::vector<PacketRange> PacketRangeVector;
+
+        // Individual selection criteria. The options are compiled at start into
+        // the list of active criteria only, in order of evaluation cost.
+        enum Criterion {
+            C_PID,             // Explicit PID values (--pid)
+            C_STREAM_ID,       // PID values selected from stream ids (--stream-id)
+            C_PAYLOAD,         // --payload
+            C_AF,              // --adaptation-field
+            C_UNIT_START,      // --unit-start
+            C_NULLIFIED,       // --nullified
+            C_INPUT_STUFFING,  // --input-stuffing
+            C_VALID,           // --valid
+            C_SCRAMBLING,      // --scrambling-control, --clear
+            C_LABEL,           // --label
+            C_EVERY,           // --every
+            C_RANGE,           // --interval
+            C_PES,             // --pes
+            C_PCR,             // --pcr
+            C_MIN_PAYLOAD,     // --min-payload-size
+            C_MAX_PAYLOAD,     // --max-payload-size
+            C_MIN_AF,          // --min-adaptation-field-size
+            C_MAX_AF,          // --max-adaptation-field-size
+            C_SPLICE,          // --has-splice-countdown
+            C_SPLICE_VALUE,    // --splice-countdown
+            C_MIN_SPLICE,      // --min-splice-countdown
+            C_MAX_SPLICE,      // --max-splice-countdown
+            C_PATTERN,         // --pattern
+        };
+        typedef std::vector<Criterion> CriterionVector;
 
         // Command line options:
         Status          _drop_status;        // Return status for unselected packets
@@ -85,7 +114,7 @@ namespace ts {
         bool            _search_payload;     // Search pattern in payload only.
         bool            _use_search_offset;  // Search at specified offset only.
         size_t          _search_offset;      // Offset where to search.
-        PacketRangeList _ranges;             // Ranges of packets to filter.
+        PacketRangeVector _ranges;           // Ranges of packets to filter, sorted and merged.
         std::set<uint8_t>          _stream_ids;        // PES stream ids to filter
         TSPacketMetadata::LabelSet _labels;            // Select packets with any of these labels
         TSPacketMetadata::LabelSet _set_labels;        // Labels to set on filtered packets
@@ -96,6 +125,11 @@ namespace ts {
         // Working data:
         PacketCounter   _filtered_packets;   // Number of filtered packets
         PIDSet          _stream_id_pid;      // PID values selected from stream ids.
+        CriterionVector _criteria;           // Active selection criteria, in order of evaluation.
+        size_t          _next_range;         // Index of first range in _ranges which is not yet passed.
+
+        // Check if a packet matches one selection criterion.
+        bool match(Criterion crit, const TSPacket& pkt, const TSPacketMetadata& pkt_data, PacketCounter index);
     };
 }
 
@@ -142,7 +176,9 @@ ts::FilterPlugin::FilterPlugin(TSP* tsp_) :
     _set_perm_labels(),
     _reset_perm_labels(),
     _filtered_packets(0),
-    _stream_id_pid()
+    _stream_id_pid(),
+    _criteria(),
+    _next_range(0)
 {
     option(u"adaptation-field");
     help(u"adaptation-field", u"Select packets with an adaptation field.");
@@ -382,6 +418,20 @@ bool ts::FilterPlugin::getOptions()
         }
     }
 
+    // Sort and merge overlapping or adjacent ranges. Since packet indexes are
+    // increasing, the ranges are then checked in sequence during processing.
+    std::sort(_ranges.begin(), _ranges.end());
+    size_t count = 0;
+    for (size_t i = 0; i < _ranges.size(); ++i) {
+        if (count > 0 && (_ranges[count-1].second == std::numeric_limits<PacketCounter>::max() || _ranges[i].first <= _ranges[count-1].second + 1)) {
+            _ranges[count-1].second = std::max(_ranges[count-1].second, _ranges[i].second);
+        }
+        else if (_ranges[i].first <= _ranges[i].second) {
+            _ranges[count++] = _ranges[i];
+        }
+    }
+    _ranges.resize(count);
+
     // Check that the pattern to search is not larger than the packet.
     if (_pattern.size() > PKT_SIZE || (_use_search_offset && _search_offset + _pattern.size() > PKT_SIZE)) {
         tsp->error(u"search pattern too large for TS packets");
@@ -414,6 +464,81 @@ bool ts::FilterPlugin::start()
 {
     _filtered_packets = 0;
     _stream_id_pid.reset();
+    _next_range = 0;
+
+    // Compile the list of active criteria, cheapest and most common first.
+    _criteria.clear();
+    if (_explicit_pid.any()) {
+        _criteria.push_back(C_PID);
+    }
+    if (!_stream_ids.empty()) {
+        _criteria.push_back(C_STREAM_ID);
+    }
+    if (_with_payload) {
+        _criteria.push_back(C_PAYLOAD);
+    }
+    if (_with_af) {
+        _criteria.push_back(C_AF);
+    }
+    if (_unit_start) {
+        _criteria.push_back(C_UNIT_START);
+    }
+    if (_nullified) {
+        _criteria.push_back(C_NULLIFIED);
+    }
+    if (_input_stuffing) {
+        _criteria.push_back(C_INPUT_STUFFING);
+    }
+    if (_valid) {
+        _criteria.push_back(C_VALID);
+    }
+    if (_scrambling_ctrl >= 0) {
+        _criteria.push_back(C_SCRAMBLING);
+    }
+    if (_labels.any()) {
+        _criteria.push_back(C_LABEL);
+    }
+    if (_every_packets > 0) {
+        _criteria.push_back(C_EVERY);
+    }
+    if (!_ranges.empty()) {
+        _criteria.push_back(C_RANGE);
+    }
+    if (_with_pes) {
+        _criteria.push_back(C_PES);
+    }
+    if (_with_pcr) {
+        _criteria.push_back(C_PCR);
+    }
+    if (_min_payload >= 0) {
+        _criteria.push_back(C_MIN_PAYLOAD);
+    }
+    if (_max_payload >= 0) {
+        _criteria.push_back(C_MAX_PAYLOAD);
+    }
+    if (_min_af >= 0) {
+        _criteria.push_back(C_MIN_AF);
+    }
+    if (_max_af >= 0) {
+        _criteria.push_back(C_MAX_AF);
+    }
+    if (_with_splice) {
+        _criteria.push_back(C_SPLICE);
+    }
+    if (_splice >= -128) {
+        _criteria.push_back(C_SPLICE_VALUE);
+    }
+    if (_min_splice >= -128) {
+        _criteria.push_back(C_MIN_SPLICE);
+    }
+    if (_max_splice >= -128) {
+        _criteria.push_back(C_MAX_SPLICE);
+    }
+    if (!_pattern.empty()) {
+        _criteria.push_back(C_PATTERN);
+    }
+    tsp->debug(u"%d active selection criteria", {_criteria.size()});
+
     return true;
 }
 
@@ -429,6 +554,79 @@ bool ts::FilterPlugin::stop()
 }
 
 
+//----------------------------------------------------------------------------
+// Check if a packet matches one selection criterion.
+//----------------------------------------------------------------------------
+
+bool ts::FilterPlugin::match(Criterion crit, const TSPacket& pkt, const TSPacketMetadata& pkt_data, PacketCounter index)
+{
+    switch (crit) {
+        case C_PID:
+            return _explicit_pid[pkt.getPID()];
+        case C_STREAM_ID:
+            return _stream_id_pid[pkt.getPID()];
+        case C_PAYLOAD:
+            return pkt.hasPayload();
+        case C_AF:
+            return pkt.hasAF();
+        case C_UNIT_START:
+            return pkt.getPUSI();
+        case C_NULLIFIED:
+            return pkt_data.getNullified();
+        case C_INPUT_STUFFING:
+            return pkt_data.getInputStuffing();
+        case C_VALID:
+            return pkt.hasValidSync() && !pkt.getTEI();
+        case C_SCRAMBLING:
+            return _scrambling_ctrl == pkt.getScrambling();
+        case C_LABEL:
+            return pkt_data.hasAnyLabel(_labels);
+        case C_EVERY:
+            return (index - _after_packets) % _every_packets == 0;
+        case C_RANGE:
+            // Skip ranges which are already passed, packet indexes are increasing.
+            while (_next_range < _ranges.size() && index > _ranges[_next_range].second) {
+                _next_range++;
+            }
+            return _next_range < _ranges.size() && index >= _ranges[_next_range].first;
+        case C_PES:
+            return pkt.startPES();
+        case C_PCR:
+            return pkt.hasPCR() || pkt.hasOPCR();
+        case C_MIN_PAYLOAD:
+            return int(pkt.getPayloadSize()) >= _min_payload;
+        case C_MAX_PAYLOAD:
+            return int(pkt.getPayloadSize()) <= _max_payload;
+        case C_MIN_AF:
+            return int(pkt.getAFSize()) >= _min_af;
+        case C_MAX_AF:
+            return int(pkt.getAFSize()) <= _max_af;
+        case C_SPLICE:
+            return pkt.hasSpliceCountdown();
+        case C_SPLICE_VALUE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() == _splice;
+        case C_MIN_SPLICE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() >= _min_splice;
+        case C_MAX_SPLICE:
+            return pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() <= _max_splice;
+        case C_PATTERN: {
+            const size_t start = _search_payload ? pkt.getHeaderSize() : 0;
+            if (start + _search_offset + _pattern.size() > PKT_SIZE) {
+                return false;
+            }
+            else if (_use_search_offset) {
+                return ::memcmp(pkt.b + start + _search_offset, _pattern.data(), _pattern.size()) == 0;
+            }
+            else {
+                return LocatePattern(pkt.b + start, PKT_SIZE - start, _pattern.data(), _pattern.size()) != nullptr;
+            }
+        }
+        default:
+            return false;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -451,45 +649,10 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
         _stream_id_pid.set(pid, selected);
     }
 
-    // Check if the packet matches one of the selected criteria.
-    bool ok = _explicit_pid[pid] ||
-        _stream_id_pid[pid] ||
-        (_with_payload && pkt.hasPayload()) ||
-        (_with_af && pkt.hasAF()) ||
-        (_unit_start && pkt.getPUSI()) ||
-        (_nullified && pkt_data.getNullified()) ||
-        (_input_stuffing && pkt_data.getInputStuffing()) ||
-        (_valid && pkt.hasValidSync() && !pkt.getTEI()) ||
-        (_scrambling_ctrl == pkt.getScrambling()) ||
-        (_with_pcr && (pkt.hasPCR() || pkt.hasOPCR())) ||
-        (_with_splice && pkt.hasSpliceCountdown()) ||
-        (_splice >= -128 && pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() == _splice) ||
-        (_min_splice >= -128 && pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() >= _min_splice) ||
-        (_max_splice >= -128 && pkt.hasSpliceCountdown() && pkt.getSpliceCountdown() <= _max_splice) ||
-        (_min_payload >= 0 && int(pkt.getPayloadSize()) >= _min_payload) ||
-        (int(pkt.getPayloadSize()) <= _max_payload) ||
-        (_min_af >= 0 && int(pkt.getAFSize()) >= _min_af) ||
-        (int(pkt.getAFSize()) <= _max_af) ||
-        pkt_data.hasAnyLabel(_labels) ||
-        (_every_packets > 0 && (tsp->pluginPackets() - _after_packets) % _every_packets == 0) ||
-        (_with_pes && pkt.startPES());
-
-    // Search binary patterns in packets.
-    if (!ok && !_pattern.empty()) {
-        const size_t start = _search_payload ? pkt.getHeaderSize() : 0;
-        if (start + _search_offset + _pattern.size() <= PKT_SIZE) {
-            if (_use_search_offset) {
-                ok = ::memcmp(pkt.b + start + _search_offset, _pattern.data(), _pattern.size()) == 0;
-            }
-            else {
-                ok = LocatePattern(pkt.b + start, PKT_SIZE - start, _pattern.data(), _pattern.size()) != nullptr;
-            }
-        }
-    }
-
-    // Search if packet is in one selected range.
-    for (auto it = _ranges.begin(); !ok && it != _ranges.end(); ++it) {
-        ok = packetIndex >= it->first && packetIndex <= it->second;
+    // Check if the packet matches one of the active criteria.
+    bool ok = false;
+    for (auto it = _criteria.begin(); !ok && it != _criteria.end(); ++it) {
+        ok = match(*it, pkt, pkt_data, packetIndex);
     }
 
     // Reverse selection criteria with --negate.
@@ -453,7 +453,8 @@ void ts::PESPlugin::handlePESPacket(PESDemux&, const PESPacket& pkt)
             size = _max_dump_size;
             out << " (truncated)";
         }
-        out << ":" << std::endl << UString::Dump(pkt.header(), size, _hexa_flags, 4, _hexa_bpl);
+        out << ":" << std::endl;
+        UString::Dump(out, pkt.header(), size, _hexa_flags, 4, _hexa_bpl);
         if (lastDump (out)) {
             return;
         }
@@ -475,7 +476,8 @@ void ts::PESPlugin::handlePESPacket(PESDemux&, const PESPacket& pkt)
             size = _max_dump_size;
             out << " (truncated)";
         }
-        out << ":" << std::endl << UString::Dump(pkt.payload(), size, _hexa_flags | UString::ASCII, 4, _hexa_bpl);
+        out << ":" << std::endl;
+        UString::Dump(out, pkt.payload(), size, _hexa_flags | UString::ASCII, 4, _hexa_bpl);
         if (lastDump(out)) {
             return;
         }
@@ -513,7 +515,8 @@ void ts::PESPlugin::handleVideoStartCode(PESDemux&, const PESPacket& pkt, uint8_
         dsize = _max_dump_size;
         out << " (truncated)";
     }
-    out << ":" << std::endl << UString::Dump(pkt.payload() + offset, dsize, _hexa_flags, 4, _hexa_bpl);
+    out << ":" << std::endl;
+    UString::Dump(out, pkt.payload() + offset, dsize, _hexa_flags, 4, _hexa_bpl);
 
     lastDump(out);
 }
@@ -544,7 +547,8 @@ void ts::PESPlugin::handleAVCAccessUnit(PESDemux&, const PESPacket& pkt, uint8_t
         dsize = _max_dump_size;
         out << " (truncated)";
     }
-    out << ":" << std::endl << UString::Dump(pkt.payload() + offset, dsize, _hexa_flags, 4, _hexa_bpl);
+    out << ":" << std::endl;
+    UString::Dump(out, pkt.payload() + offset, dsize, _hexa_flags, 4, _hexa_bpl);
 
     // Structured formatting if possible
     switch (nal_unit_type) {
@@ -604,7 +608,8 @@ void ts::PESPlugin::handleSEI(PESDemux& demux, const PESPacket& pkt, uint32_t se
         dsize = _max_dump_size;
         out << " (truncated)";
     }
-    out << ":" << std::endl << UString::Dump(pkt.payload() + offset, dsize, _hexa_flags | UString::ASCII, 4, _hexa_bpl);
+    out << ":" << std::endl;
+    UString::Dump(out, pkt.payload() + offset, dsize, _hexa_flags | UString::ASCII, 4, _hexa_bpl);
 }
 
 
@@ -33,15 +33,16 @@
 
 #include "tsMain.h"
 #include "tsMemory.h"
-#include "tsTSFileInputBuffered.h"
+#include "tsTSFile.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
 #include "tsBinaryTable.h"
 #include "tsSection.h"
 #include "tsPMT.h"
 #include "tsStreamIdentifierDescriptor.h"
-#include "tsTextFormatter.h"
-#include "tsjsonObject.h"
-#include "tsjsonString.h"
-#include "tsjsonNumber.h"
+#include "tsjsonWriter.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
@@ -76,6 +77,8 @@ namespace {
         bool               pid_ignore;
         bool               cc_ignore;
         bool               continue_all;
+        bool               masked_compare;  // Fast path can use header_mask.
+        uint32_t           header_mask;     // Mask of TS header bits which are compared.
     };
 }
 
@@ -97,14 +100,18 @@ Options::Options(int argc, char *argv[]) :
     pcr_ignore(false),
     pid_ignore(false),
     cc_ignore(false),
-    continue_all(false)
+    continue_all(false),
+    masked_compare(false),
+    header_mask(0xFFFFFFFF)
 {
     option(u"", 0, STRING, 2, 2);
     help(u"", u"MPEG capture files to be compared.");
 
     option(u"buffered-packets", 0, UNSIGNED);
     help(u"buffered-packets",
-         u"Specifies the files input buffer size in TS packets.\n"
+         u"Specifies the files input buffer size in TS packets. "
+         u"Each file is read ahead in the background using two buffers of this size. "
+         u"The identical packets in a buffer are compared at once.\n"
          u"The default is " + ts::UString::Decimal(DEFAULT_BUFFERED_PACKETS) + u" TS packets.");
 
     option(u"byte-offset", 'b', UNSIGNED);
@@ -187,6 +194,17 @@ Options::Options(int argc, char *argv[]) :
     json = !quiet && present(u"json");
     dump = !quiet && present(u"dump");
 
+    // Ignored PID and CC are at fixed positions in the TS header. They can be
+    // masked in the bulk comparison. PCR's and payload-only comparisons depend
+    // on the packet structure and always need a field-by-field comparison.
+    if (pid_ignore) {
+        header_mask &= ~uint32_t(0x001FFF00);
+    }
+    if (cc_ignore) {
+        header_mask &= ~uint32_t(0x0000000F);
+    }
+    masked_compare = header_mask != 0xFFFFFFFF && !pcr_ignore && !payload_only;
+
     if (json && normalized) {
         error(u"options --json and --normalized are mutually exclusive");
     }
@@ -319,6 +337,290 @@ bool Comparator::compare(const ts::TSPacket& pkt1, const ts::TSPacket& pkt2, Opt
 }
 
 
+//----------------------------------------------------------------------------
+//  Bulk comparison of identical packets.
+//  Return the number of leading packets which are equal in the two buffers.
+//  All returned packets would be declared equal by Comparator. The first
+//  non-matching packet may be equal or not, it must be checked by Comparator.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Number of packets which are compared at once with memcmp().
+    const size_t BULK_PACKETS = 64;
+
+    size_t IdenticalPackets(const ts::TSPacket* pkt1, const ts::TSPacket* pkt2, size_t count, const Options& opt)
+    {
+        size_t index = 0;
+
+        // Compare large blocks of raw packets. Strictly identical packets are always
+        // equal, regardless of the comparison options. This is the common case.
+        while (index < count) {
+            const size_t size = std::min(BULK_PACKETS, count - index);
+            if (::memcmp(pkt1[index].b, pkt2[index].b, size * ts::PKT_SIZE) != 0) {
+                break;
+            }
+            index += size;
+        }
+
+        // Locate the first differing packet in the block.
+        for (; index < count; ++index) {
+            const uint8_t* const b1 = pkt1[index].b;
+            const uint8_t* const b2 = pkt2[index].b;
+            if (::memcmp(b1, b2, ts::PKT_SIZE) == 0) {
+                continue;
+            }
+            // When only PID and/or CC are ignored, apply the precomputed header mask.
+            // A null packet and a non-null packet are always different.
+            if (opt.masked_compare &&
+                ((ts::GetUInt32(b1) ^ ts::GetUInt32(b2)) & opt.header_mask) == 0 &&
+                (pkt1[index].getPID() == ts::PID_NULL) == (pkt2[index].getPID() == ts::PID_NULL) &&
+                ::memcmp(b1 + 4, b2 + 4, ts::PKT_SIZE - 4) == 0)
+            {
+                continue;
+            }
+            break;
+        }
+        return index;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Double-buffered file reader. A background thread fills one buffer while
+//  the packets from the other buffer are compared.
+//----------------------------------------------------------------------------
+
+namespace {
+    class FileReader: private ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(FileReader);
+    public:
+        // Constructor and destructor.
+        FileReader(size_t buffer_packets, ts::Report& report);
+        virtual ~FileReader() override;
+
+        // Open the file.
+        bool open(const ts::UString& filename, uint64_t start_offset, ts::TSPacketFormat format);
+
+        // Start the reader thread.
+        using Thread::start;
+
+        // Stop the reader thread and close the file.
+        void close();
+
+        // Get the file name.
+        ts::UString getFileName() const { return _file.getFileName(); }
+
+        // Number of packets which were returned to the application.
+        ts::PacketCounter readPacketsCount() const { return _read_count; }
+
+        // Get the address of the next contiguous packets, wait for them if necessary.
+        // Return the number of available packets, zero on end of file.
+        size_t peek(const ts::TSPacket*& packets);
+
+        // Skip packets which were returned by peek().
+        void skip(size_t count);
+
+        // Read one packet, return the number of read packets (0 or 1).
+        size_t read(ts::TSPacket& packet);
+
+    private:
+        // Messages from the reader thread, logged later by the application thread.
+        // The application report is not thread-safe, the reader thread never uses it.
+        class MessageList: public ts::Report
+        {
+            TS_NOCOPY(MessageList);
+        public:
+            MessageList() : Report(), _messages() {}
+            void flush(ts::Report& report);
+        protected:
+            virtual void writeLog(int severity, const ts::UString& msg) override;
+        private:
+            std::list<std::pair<int, ts::UString>> _messages;
+        };
+
+        ts::Report&        _report;
+        ts::TSFile         _file;
+        ts::Mutex          _mutex;          // Protect the fields below.
+        ts::Condition      _filled;         // Signaled when a buffer is filled.
+        ts::Condition      _freed;          // Signaled when a buffer is released by the application.
+        volatile bool      _terminate;      // Request the reader thread to terminate.
+        ts::TSPacketVector _buffers[2];     // Double buffer.
+        size_t             _counts[2];      // Number of packets in each buffer, zero at end of file.
+        MessageList        _messages[2];    // Messages from the reader thread while filling each buffer.
+        bool               _ready[2];       // Buffer is filled and owned by the application.
+        size_t             _current;        // Index of buffer which is read by the application.
+        bool               _held;           // The application holds the current buffer.
+        size_t             _index;          // Index of next packet in current buffer.
+        ts::PacketCounter  _read_count;     // Number of packets which were returned to the application.
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+}
+
+FileReader::FileReader(size_t buffer_packets, ts::Report& report) :
+    Thread(),
+    _report(report),
+    _file(),
+    _mutex(),
+    _filled(),
+    _freed(),
+    _terminate(false),
+    _buffers(),
+    _counts{0, 0},
+    _messages(),
+    _ready{false, false},
+    _current(0),
+    _held(false),
+    _index(0),
+    _read_count(0)
+{
+    _buffers[0].resize(std::max<size_t>(buffer_packets, 1));
+    _buffers[1].resize(_buffers[0].size());
+    _messages[0].setMaxSeverity(_report.maxSeverity());
+    _messages[1].setMaxSeverity(_report.maxSeverity());
+}
+
+void FileReader::MessageList::writeLog(int severity, const ts::UString& msg)
+{
+    _messages.push_back(std::make_pair(severity, msg));
+}
+
+void FileReader::MessageList::flush(ts::Report& report)
+{
+    for (auto it = _messages.begin(); it != _messages.end(); ++it) {
+        report.log(it->first, it->second);
+    }
+    _messages.clear();
+}
+
+FileReader::~FileReader()
+{
+    close();
+}
+
+bool FileReader::open(const ts::UString& filename, uint64_t start_offset, ts::TSPacketFormat format)
+{
+    return _file.openRead(filename, 1, start_offset, _report, format);
+}
+
+void FileReader::close()
+{
+    {
+        ts::GuardCondition lock(_mutex, _freed);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+    if (_file.isOpen()) {
+        _file.close(_report);
+    }
+}
+
+// Reader thread: fill the two buffers alternatively.
+void FileReader::main()
+{
+    for (size_t i = 0; ; i ^= 1) {
+
+        // Wait for the buffer to be released by the application.
+        {
+            ts::GuardCondition lock(_mutex, _freed);
+            while (_ready[i] && !_terminate) {
+                lock.waitCondition();
+            }
+            if (_terminate) {
+                break;
+            }
+        }
+
+        // Fill the buffer outside the mutex, the application uses the other buffer.
+        const size_t count = _file.readPackets(_buffers[i].data(), nullptr, _buffers[i].size(), _messages[i]);
+
+        // Give the buffer to the application.
+        {
+            ts::GuardCondition lock(_mutex, _filled);
+            _counts[i] = count;
+            _ready[i] = true;
+            lock.signal();
+        }
+
+        // Stop at end of file.
+        if (count == 0) {
+            break;
+        }
+    }
+}
+
+size_t FileReader::peek(const ts::TSPacket*& packets)
+{
+    // When the current buffer is exhausted, give it back to the reader thread.
+    if (_held && _index >= _counts[_current]) {
+        if (_counts[_current] == 0) {
+            // End of file is permanent.
+            packets = nullptr;
+            return 0;
+        }
+        ts::GuardCondition lock(_mutex, _freed);
+        _ready[_current] = false;
+        _held = false;
+        _current ^= 1;
+        _index = 0;
+        lock.signal();
+    }
+
+    // Wait for the next buffer to be filled.
+    if (!_held) {
+        ts::GuardCondition lock(_mutex, _filled);
+        while (!_ready[_current]) {
+            lock.waitCondition();
+        }
+        _held = true;
+        // Now in the application thread, report the errors from the reader thread.
+        _messages[_current].flush(_report);
+    }
+
+    packets = _buffers[_current].data() + _index;
+    return _counts[_current] - _index;
+}
+
+void FileReader::skip(size_t count)
+{
+    assert(_held);
+    assert(_index + count <= _counts[_current]);
+    _index += count;
+    _read_count += count;
+}
+
+size_t FileReader::read(ts::TSPacket& packet)
+{
+    const ts::TSPacket* pkt = nullptr;
+    if (peek(pkt) == 0) {
+        return 0;
+    }
+    packet = *pkt;
+    skip(1);
+    return 1;
+}
+
+
+//----------------------------------------------------------------------------
+//  Start a JSON event object. Open the array of events on first one.
+//----------------------------------------------------------------------------
+
+namespace {
+    void BeginEvent(ts::json::Writer& json, bool& events_open, const ts::UString& type)
+    {
+        if (!events_open) {
+            json.beginArray(u"events");
+            events_open = true;
+        }
+        json.beginObject();
+        json.add(u"type", type);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -326,22 +628,29 @@ bool Comparator::compare(const ts::TSPacket& pkt1, const ts::TSPacket& pkt2, Opt
 int MainCode(int argc, char *argv[])
 {
     Options opt(argc, argv);
-    ts::TSFileInputBuffered file1(opt.buffered_packets);
-    ts::TSFileInputBuffered file2(opt.buffered_packets);
+    FileReader file1(opt.buffered_packets, opt);
+    FileReader file2(opt.buffered_packets, opt);
 
     // Open files
-    file1.openRead(opt.filename1, 1, opt.byte_offset, opt, opt.format);
-    file2.openRead(opt.filename2, 1, opt.byte_offset, opt, opt.format);
+    file1.open(opt.filename1, opt.byte_offset, opt.format);
+    file2.open(opt.filename2, opt.byte_offset, opt.format);
     opt.exitOnError();
 
-    // JSON root.
-    ts::json::Object root;
+    // Start reading both files in the background.
+    file1.start();
+    file2.start();
+
+    // JSON output is streamed, the list of events can be very long.
+    ts::json::Writer json(std::cout);
+    bool json_events = false;
 
     // Display headers
     if (opt.json) {
-        ts::json::Value& jfiles(root.query(u"files", true, ts::json::TypeArray));
-        jfiles.set(ts::AbsoluteFilePath(file1.getFileName()));
-        jfiles.set(ts::AbsoluteFilePath(file2.getFileName()));
+        json.beginObject();
+        json.beginArray(u"files");
+        json.set(ts::AbsoluteFilePath(file1.getFileName()));
+        json.set(ts::AbsoluteFilePath(file2.getFileName()));
+        json.endArray();
     }
     else if (opt.normalized) {
         std::cout << "file:file=1:filename=" << file1.getFileName() << ":" << std::endl;
@@ -373,14 +682,29 @@ int MainCode(int argc, char *argv[])
 
     for (;;) {
 
+        // Fast path: skip all identical packets at once when not resynchronizing.
+        if (subset_skipped == 0) {
+            const ts::TSPacket* buf1 = nullptr;
+            const ts::TSPacket* buf2 = nullptr;
+            const size_t count1_avail = file1.peek(buf1);
+            const size_t count2_avail = file2.peek(buf2);
+            const size_t same = IdenticalPackets(buf1, buf2, std::min(count1_avail, count2_avail), opt);
+            for (size_t i = 0; i < same; ++i) {
+                count1[buf1[i].getPID()]++;
+                count2[buf2[i].getPID()]++;
+            }
+            file1.skip(same);
+            file2.skip(same);
+        }
+
         // Read one packet in file1
-        size_t read1 = file1.read (&pkt1, 1, opt);
+        size_t read1 = file1.read(pkt1);
         ts::PID pid1 = pkt1.getPID();
         count1[pid1]++;
 
         // If currently not skipping packets, read one packet in file2
         if (subset_skipped == 0) {
-            read2 = file2.read (&pkt2, 1, opt);
+            read2 = file2.read(pkt2);
             pid2 = pkt2.getPID();
             count2[pid2]++;
         }
@@ -393,10 +717,10 @@ int MainCode(int argc, char *argv[])
             if (read1 != 0) {
                 // File 2 is truncated
                 if (opt.json) {
-                    ts::json::Value& jv(root.query(u"events[]", true));
-                    jv.add(u"type", u"truncated");
-                    jv.add(u"packet", file2.readPacketsCount());
-                    jv.add(u"file-index", 1);
+                    BeginEvent(json, json_events, u"truncated");
+                    json.add(u"packet", file2.readPacketsCount());
+                    json.add(u"file-index", 1);
+                    json.endObject();
                 }
                 else if (opt.normalized) {
                     std::cout << "truncated:file=2:packet=" << file2.readPacketsCount()
@@ -410,10 +734,10 @@ int MainCode(int argc, char *argv[])
             if (read2 != 0) {
                 // File 1 is truncated
                 if (opt.json) {
-                    ts::json::Value& jv(root.query(u"events[]", true));
-                    jv.add(u"type", u"truncated");
-                    jv.add(u"packet", file1.readPacketsCount());
-                    jv.add(u"file-index", 0);
+                    BeginEvent(json, json_events, u"truncated");
+                    json.add(u"packet", file1.readPacketsCount());
+                    json.add(u"file-index", 0);
+                    json.endObject();
                 }
                 else if (opt.normalized) {
                     std::cout << "truncated:file=1:packet=" << file1.readPacketsCount()
@@ -439,10 +763,10 @@ int MainCode(int argc, char *argv[])
         // Report resynchronization after missing packets
         if (subset_skipped > 0) {
             if (opt.json) {
-                ts::json::Value& jv(root.query(u"events[]", true));
-                jv.add(u"type", u"skipped");
-                jv.add(u"packet", file1.readPacketsCount() - 1 - subset_skipped);
-                jv.add(u"skipped", subset_skipped);
+                BeginEvent(json, json_events, u"skipped");
+                json.add(u"packet", file1.readPacketsCount() - 1 - subset_skipped);
+                json.add(u"skipped", subset_skipped);
+                json.endObject();
             }
             else if (opt.normalized) {
                 std::cout << "skip:packet=" << (file1.readPacketsCount() - 1 - subset_skipped)
@@ -463,20 +787,20 @@ int MainCode(int argc, char *argv[])
         if (!comp.equal) {
             diff_count++;
             if (opt.json) {
-                ts::json::Value& jv(root.query(u"events[]", true));
-                jv.add(u"type", u"difference");
-                jv.add(u"packet", file1.readPacketsCount() - 1);
-                jv.add(u"payload-only", ts::json::Bool(opt.payload_only));
-                jv.add(u"offset", comp.first_diff);
-                jv.add(u"end-offset", comp.end_diff);
-                jv.add(u"diff-bytes", comp.diff_count);
-                jv.add(u"comp-size", comp.compared_size);
-                jv.add(u"pid0", pid1);
-                jv.add(u"pid1", pid2);
-                jv.add(u"pid0-index", count1[pid1] - 1);
-                jv.add(u"pid1-index", count2[pid2] - 1);
-                jv.add(u"same-pid", ts::json::Bool(pid1 == pid2));
-                jv.add(u"same-index", ts::json::Bool(count2[pid2] == count1[pid1]));
+                BeginEvent(json, json_events, u"difference");
+                json.add(u"packet", file1.readPacketsCount() - 1);
+                json.addBool(u"payload-only", opt.payload_only);
+                json.add(u"offset", comp.first_diff);
+                json.add(u"end-offset", comp.end_diff);
+                json.add(u"diff-bytes", comp.diff_count);
+                json.add(u"comp-size", comp.compared_size);
+                json.add(u"pid0", pid1);
+                json.add(u"pid1", pid2);
+                json.add(u"pid0-index", count1[pid1] - 1);
+                json.add(u"pid1-index", count2[pid2] - 1);
+                json.addBool(u"same-pid", pid1 == pid2);
+                json.addBool(u"same-index", count2[pid2] == count1[pid1]);
+                json.endObject();
             }
             else if (opt.normalized) {
                 std::cout << "diff:packet=" << (file1.readPacketsCount() - 1)
@@ -516,12 +840,12 @@ int MainCode(int argc, char *argv[])
                     pkt1.display (std::cout, opt.dump_flags, 6);
                     std::cout << "  Packet from " << file2.getFileName() << ":" << std::endl;
                     pkt2.display (std::cout, opt.dump_flags, 6);
-                    std::cout << "  Differing area from " << file1.getFileName() << ":" << std::endl
-                              << ts::UString::Dump(pkt1.b + (opt.payload_only ? pkt1.getHeaderSize() : 0) + comp.first_diff,
-                                                   comp.end_diff - comp.first_diff, opt.dump_flags, 6)
-                              << "  Differing area from " << file2.getFileName() << ":" << std::endl
-                              << ts::UString::Dump(pkt2.b + (opt.payload_only ? pkt2.getHeaderSize() : 0) + comp.first_diff,
-                                                   comp.end_diff - comp.first_diff, opt.dump_flags, 6);
+                    std::cout << "  Differing area from " << file1.getFileName() << ":" << std::endl;
+                    ts::UString::Dump(std::cout, pkt1.b + (opt.payload_only ? pkt1.getHeaderSize() : 0) + comp.first_diff,
+                                      comp.end_diff - comp.first_diff, opt.dump_flags, 6);
+                    std::cout << "  Differing area from " << file2.getFileName() << ":" << std::endl;
+                    ts::UString::Dump(std::cout, pkt2.b + (opt.payload_only ? pkt2.getHeaderSize() : 0) + comp.first_diff,
+                                      comp.end_diff - comp.first_diff, opt.dump_flags, 6);
                 }
             }
             if (opt.quiet || !opt.continue_all) {
@@ -532,11 +856,16 @@ int MainCode(int argc, char *argv[])
 
     // Final report
     if (opt.json) {
-        ts::json::Value& jv(root.query(u"summary", true));
-        jv.add(u"packets", file1.readPacketsCount());
-        jv.add(u"differences", diff_count);
-        jv.add(u"missing", total_subset_skipped);
-        jv.add(u"holes", subset_skipped_chunks);
+        if (json_events) {
+            json.endArray();
+        }
+        json.beginObject(u"summary");
+        json.add(u"packets", file1.readPacketsCount());
+        json.add(u"differences", diff_count);
+        json.add(u"missing", total_subset_skipped);
+        json.add(u"holes", subset_skipped_chunks);
+        json.endObject();
+        json.endObject();
     }
     else if (opt.normalized) {
         std::cout << "total:packets=" << file1.readPacketsCount()
@@ -555,16 +884,8 @@ int MainCode(int argc, char *argv[])
         std::cout << std::endl;
     }
 
-    // JSON output if required.
-    if (opt.json) {
-        ts::TextFormatter text(opt);
-        text.setStream(std::cout);
-        root.print(text);
-        text << std::endl;
-    }
-
     // End of processing, close file
-    file1.close(opt);
-    file2.close(opt);
+    file1.close();
+    file2.close();
     return diff_count == 0 && opt.valid() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -258,17 +258,14 @@ namespace {
 
         // Raw dump of file
         const uint32_t flags = (opt.dump_flags & 0x0000FFFF) | ts::UString::BPL | ts::UString::WIDE_OFFSET;
-        const size_t MAX_RAW_BPL = 16;
         const size_t raw_bpl = (flags & ts::UString::BINARY) ? 8 : 16;  // Bytes per line in raw mode
+        const size_t RAW_CHUNK_SIZE = 64 * 1024;  // Multiple of raw_bpl, all lines are complete except the last one
+        ts::ByteBlock buffer(RAW_CHUNK_SIZE);
         size_t offset = 0;
         while (*in) {
-            int c;
-            size_t size;
-            uint8_t buffer[MAX_RAW_BPL];
-            for (size = 0; size < raw_bpl && (c = in->get()) != EOF; size++) {
-                buffer[size] = uint8_t(c);
-            }
-            out << ts::UString::Dump(buffer, size, flags, 0, raw_bpl, offset);
+            in->read(reinterpret_cast<char*>(buffer.data()), std::streamsize(buffer.size()));
+            const size_t size = size_t(in->gcount());
+            ts::UString::Dump(out, buffer.data(), size, flags, 0, raw_bpl, offset);
             offset += size;
         }
     }
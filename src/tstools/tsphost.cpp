@@ -0,0 +1,506 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor host: run many tsp chains in one process.
+//
+//  Implementation notes:
+//
+//  Each line of the configuration file describes one tsp chain, using the
+//  same options as the tsp command. Each chain is run by a TSProcessor
+//  instance, as in tsp. An instance of the class Chain is a small supervisor
+//  thread which starts the TSProcessor, waits for its termination and
+//  optionally restarts it. The supervisor replaces the main thread of a tsp
+//  process: it is idle most of the time, blocked on the termination of its
+//  TSProcessor.
+//
+//  The packet processor plugins of all chains are executed by one shared
+//  pool of threads (class TSProcessorPool), by default one thread per CPU
+//  core. Only the input and output plugins of each chain have their own
+//  thread since they typically block on I/O. Thus, a chain uses three
+//  threads (input, output, supervisor), regardless of its number of packet
+//  processor plugins. Real-time plugins (such as regulate), plugins with a
+//  packet timeout and plugins with a large stack keep their own thread.
+//  With --no-pool, each plugin has its own thread, as in tsp.
+//
+//  All chains share the same asynchronous logger and the same repository of
+//  plugins. The default size of the packet buffer of each chain is much
+//  smaller than in tsp since a host typically runs many light chains.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsTSProcessor.h"
+#include "tsTSProcessorPool.h"
+#include "tsArgsWithPlugins.h"
+#include "tsDuckContext.h"
+#include "tsPluginRepository.h"
+#include "tsAsyncReport.h"
+#include "tsReportWithPrefix.h"
+#include "tsUserInterrupt.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
+#include "tsSafePtr.h"
+TSDUCK_SOURCE;
+TS_MAIN(MainCode);
+
+// With static link, enforce a reference to MPEG/DVB structures.
+#if defined(TSDUCK_STATIC_LIBRARY)
+#include "tsStaticReferencesDVB.h"
+const ts::StaticReferencesDVB dependenciesForStaticLib;
+#endif
+
+namespace {
+    // Default size of the packet buffer of each chain.
+    constexpr size_t DEFAULT_CHAIN_BUFFER_SIZE = 1000000;
+
+    // Default delay before restarting a terminated chain.
+    constexpr ts::MilliSecond DEFAULT_RESTART_DELAY = 1000;
+}
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class HostOptions: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(HostOptions);
+    public:
+        HostOptions(int argc, char *argv[]);
+
+        // Option values
+        ts::DuckContext     duck;           // TSDuck context
+        ts::UString         config_file;    // Configuration file, one chain per line.
+        size_t              buffer_size;    // Default buffer size of each chain.
+        bool                restart;        // Restart chains when they terminate.
+        ts::MilliSecond     restart_delay;  // Delay before restarting a chain.
+        bool                use_pool;       // Use a shared thread pool for packet processor plugins.
+        size_t              pool_threads;   // Number of threads in the pool, zero means number of cores.
+        ts::AsyncReportArgs log_args;       // Asynchronous logger arguments.
+    };
+}
+
+HostOptions::HostOptions(int argc, char *argv[]) :
+    ts::Args(u"Run many transport stream processing chains in one process", u"[options] config-file"),
+    duck(this),
+    config_file(),
+    buffer_size(0),
+    restart(false),
+    restart_delay(0),
+    use_pool(true),
+    pool_threads(0),
+    log_args()
+{
+    log_args.defineArgs(*this);
+
+    option(u"", 0, STRING, 1, 1);
+    help(u"",
+         u"A text file describing the processing chains, one per line. "
+         u"Each line contains the options of a tsp command, without the command name. "
+         u"The line may start with a chain name, followed by a colon, as in \"name: -I ... -P ... -O ...\". "
+         u"By default, the chains are named chain-1, chain-2, etc. "
+         u"Empty lines and lines starting with '#' are ignored. "
+         u"A line ending with a backslash continues on the next line.");
+
+    option(u"buffer-size-mb", 0, POSITIVE, 0, 1, 0, 0, false, 6);
+    help(u"buffer-size-mb",
+         u"Default buffer size in mega-bytes of each chain which does not specify its own --buffer-size-mb. "
+         u"The default is " + ts::UString::Decimal(DEFAULT_CHAIN_BUFFER_SIZE / 1000000) + u" MB.");
+
+    option(u"no-pool");
+    help(u"no-pool",
+         u"Execute each packet processor plugin in its own thread, as in tsp. "
+         u"By default, the packet processor plugins of all chains are executed by one shared pool of threads.");
+
+    option(u"pool-threads", 0, POSITIVE);
+    help(u"pool-threads",
+         u"Number of threads in the shared pool which executes the packet processor plugins of all chains. "
+         u"The default is the number of CPU cores. "
+         u"Real-time plugins (for instance \"regulate\") and plugins which need a packet timeout "
+         u"(for instance \"bitrate_monitor\") keep their own thread.");
+
+    option(u"restart", 'r');
+    help(u"restart", u"Restart each chain when it terminates, either normally or on error.");
+
+    option(u"restart-delay", 0, POSITIVE);
+    help(u"restart-delay",
+         u"With --restart, specify the delay in milliseconds before restarting a terminated chain. "
+         u"The default is " + ts::UString::Decimal(DEFAULT_RESTART_DELAY) + u" ms.");
+
+    // Analyze the command.
+    analyze(argc, argv);
+
+    // Load option values.
+    getValue(config_file, u"");
+    buffer_size = intValue<size_t>(u"buffer-size-mb", DEFAULT_CHAIN_BUFFER_SIZE);
+    restart = present(u"restart");
+    restart_delay = intValue<ts::MilliSecond>(u"restart-delay", DEFAULT_RESTART_DELAY);
+    use_pool = !present(u"no-pool");
+    pool_threads = intValue<size_t>(u"pool-threads", 0);
+    log_args.loadArgs(duck, *this);
+
+    // Final checking
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Options of one chain, same as tsp.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ChainOptions: public ts::ArgsWithPlugins
+    {
+        TS_NOBUILD_NOCOPY(ChainOptions);
+    public:
+        ChainOptions(ts::Report& report);
+
+        // Analyze the options of a chain. Errors are reported on the redirected report.
+        bool load(const ts::UString& name, const ts::UStringVector& args, size_t default_buffer_size);
+
+        // Option values
+        ts::DuckContext     duck;      // TSDuck context
+        ts::TSProcessorArgs tsp_args;  // TS processing arguments.
+    };
+}
+
+ChainOptions::ChainOptions(ts::Report& report) :
+    ts::ArgsWithPlugins(0, 1, 0, UNLIMITED_COUNT, 0, 1, u"Transport stream processing chain", u"",
+                        NO_EXIT_ON_ERROR | NO_EXIT_ON_HELP | NO_EXIT_ON_VERSION | NO_CONFIG_FILE),
+    duck(this),
+    tsp_args()
+{
+    redirectReport(&report);
+
+    duck.defineArgsForCAS(*this);
+    duck.defineArgsForCharset(*this);
+    duck.defineArgsForHFBand(*this);
+    duck.defineArgsForPDS(*this);
+    duck.defineArgsForStandards(*this);
+    tsp_args.defineArgs(*this);
+}
+
+bool ChainOptions::load(const ts::UString& name, const ts::UStringVector& args, size_t default_buffer_size)
+{
+    if (!analyze(name, args)) {
+        return false;
+    }
+    duck.loadArgs(*this);
+    tsp_args.loadArgs(duck, *this);
+    if (!present(u"buffer-size-mb")) {
+        tsp_args.ts_buffer_size = default_buffer_size;
+    }
+    return valid();
+}
+
+
+//----------------------------------------------------------------------------
+//  Supervisor thread of one chain.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Chain: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(Chain);
+    public:
+        Chain(const HostOptions& opt, const ts::UString& name, const ts::TSProcessorArgs& args, ts::TSProcessorPool* pool, ts::Report& report);
+        virtual ~Chain() override;
+
+        // Request the termination of the chain. Can be called from any thread.
+        void stop();
+
+        // Check if the chain failed to start at least once.
+        bool failed() const { return _failed; }
+
+    private:
+        const HostOptions&   _opt;
+        const ts::UString    _name;
+        ts::TSProcessorArgs  _args;
+        ts::TSProcessorPool* _pool;        // Shared thread pool, if any.
+        ts::ReportWithPrefix _report;
+        ts::Mutex            _mutex;       // Protect _proc and _terminate.
+        ts::Condition        _condition;   // Signaled when _terminate is set.
+        ts::TSProcessor*     _proc;        // Currently running processor, if any.
+        bool                 _terminate;   // Termination requested.
+        volatile bool        _failed;      // Failed to start at least once.
+
+        // Inherited from Thread.
+        virtual void main() override;
+    };
+
+    typedef ts::SafePtr<Chain> ChainPtr;
+    typedef std::vector<ChainPtr> ChainVector;
+}
+
+Chain::Chain(const HostOptions& opt, const ts::UString& name, const ts::TSProcessorArgs& args, ts::TSProcessorPool* pool, ts::Report& report) :
+    ts::Thread(),
+    _opt(opt),
+    _name(name),
+    _args(args),
+    _pool(pool),
+    _report(report, name + u": "),
+    _mutex(),
+    _condition(),
+    _proc(nullptr),
+    _terminate(false),
+    _failed(false)
+{
+}
+
+Chain::~Chain()
+{
+    stop();
+    waitForTermination();
+}
+
+void Chain::stop()
+{
+    ts::GuardCondition lock(_mutex, _condition);
+    _terminate = true;
+    if (_proc != nullptr) {
+        _proc->abort();
+    }
+    lock.signal();
+}
+
+void Chain::main()
+{
+    for (;;) {
+        // A TSProcessor cannot be restarted, use a new one for each run.
+        ts::TSProcessor proc(_report);
+        proc.setProcessorPool(_pool);
+        bool started = false;
+        {
+            ts::Guard lock(_mutex);
+            if (_terminate) {
+                break;
+            }
+            started = proc.start(_args);
+            if (started) {
+                _proc = &proc;
+            }
+        }
+        if (started) {
+            proc.waitForTermination();
+            ts::Guard lock(_mutex);
+            _proc = nullptr;
+        }
+        else {
+            _failed = true;
+        }
+
+        // Wait before restarting or exit.
+        ts::GuardCondition lock(_mutex, _condition);
+        if (!_opt.restart || _terminate) {
+            break;
+        }
+        _report.verbose(u"chain terminated, restarting in %'d ms", {_opt.restart_delay});
+        lock.waitCondition(_opt.restart_delay);
+        if (_terminate) {
+            break;
+        }
+    }
+    _report.debug(u"chain supervisor terminated");
+}
+
+
+//----------------------------------------------------------------------------
+//  Load the configuration file. Return false on error.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool LoadChains(ChainVector& chains, const HostOptions& opt, ts::TSProcessorPool* pool, ts::Report& report)
+    {
+        ts::UStringVector lines;
+        if (!ts::UString::Load(lines, opt.config_file)) {
+            report.error(u"error reading %s", {opt.config_file});
+            return false;
+        }
+
+        bool ok = true;
+        std::set<ts::UString> names;
+        ts::UString line;
+        size_t line_number = 0;
+
+        for (size_t i = 0; i < lines.size(); ++i) {
+
+            // Accumulate continuation lines.
+            if (line.empty()) {
+                line_number = i + 1;
+            }
+            line.append(lines[i]);
+            line.trim();
+            if (line.endWith(u"\\")) {
+                line.pop_back();
+                line.push_back(u' ');
+                if (i + 1 < lines.size()) {
+                    continue;
+                }
+            }
+            if (line.empty() || line.startWith(u"#")) {
+                line.clear();
+                continue;
+            }
+
+            // Split the line in tsp options.
+            ts::UStringVector args;
+            line.splitShellStyle(args);
+            line.clear();
+
+            // Get the optional chain name.
+            ts::UString name;
+            if (!args.empty() && args.front().size() > 1 && args.front().endWith(u":")) {
+                name = args.front();
+                name.pop_back();
+                args.erase(args.begin());
+            }
+            else {
+                name.format(u"chain-%d", {chains.size() + 1});
+            }
+            if (names.find(name) != names.end()) {
+                report.error(u"%s, line %d: duplicate chain name %s", {opt.config_file, line_number, name});
+                ok = false;
+                continue;
+            }
+            names.insert(name);
+
+            // Analyze the chain options.
+            ts::ReportWithPrefix chain_report(report, ts::UString::Format(u"%s, line %d: ", {opt.config_file, line_number}));
+            ChainOptions chain_opt(chain_report);
+            if (chain_opt.load(name, args, opt.buffer_size)) {
+                chains.push_back(ChainPtr(new Chain(opt, name, chain_opt.tsp_args, pool, report)));
+            }
+            else {
+                ok = false;
+            }
+        }
+
+        if (ok && chains.empty()) {
+            report.error(u"no processing chain in %s", {opt.config_file});
+            ok = false;
+        }
+        return ok;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Interrupt handler
+//----------------------------------------------------------------------------
+
+namespace {
+    class HostInterruptHandler: public ts::InterruptHandler
+    {
+        TS_NOBUILD_NOCOPY(HostInterruptHandler);
+    public:
+        HostInterruptHandler(ts::Report& report, ChainVector& chains);
+        virtual void handleInterrupt() override;
+    private:
+        ts::Report&  _report;
+        ChainVector& _chains;
+    };
+}
+
+HostInterruptHandler::HostInterruptHandler(ts::Report& report, ChainVector& chains) :
+    _report(report),
+    _chains(chains)
+{
+}
+
+void HostInterruptHandler::handleInterrupt()
+{
+    _report.info(u"tsphost: user interrupt, terminating...");
+    for (size_t i = 0; i < _chains.size(); ++i) {
+        _chains[i]->stop();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    // Internal sanity check about TS packets.
+    ts::TSPacket::SanityCheck();
+
+    // Get command line options.
+    HostOptions opt(argc, argv);
+    CERR.setMaxSeverity(opt.maxSeverity());
+
+    // If plugins were statically linked, disallow the dynamic loading of plugins.
+#if defined(TSDUCK_STATIC_PLUGINS)
+    ts::PluginRepository::Instance()->setSharedLibraryAllowed(false);
+#endif
+
+    // Prevent from being killed when writing on broken pipes.
+    ts::IgnorePipeSignal();
+
+    // Create an asynchronous error logger, shared by all chains.
+    ts::AsyncReport report(opt.maxSeverity(), opt.log_args);
+
+    // The shared thread pool for the packet processor plugins of all chains.
+    // It must be declared before the chains to be terminated after them.
+    ts::TSProcessorPool pool(opt.pool_threads);
+    if (opt.use_pool && !pool.start()) {
+        report.error(u"cannot start the thread pool");
+        return EXIT_FAILURE;
+    }
+
+    // Load the description of all chains. Don't start anything on error.
+    ChainVector chains;
+    if (!LoadChains(chains, opt, opt.use_pool ? &pool : nullptr, report)) {
+        return EXIT_FAILURE;
+    }
+    if (opt.use_pool) {
+        report.verbose(u"starting %d processing chains, %d threads in pool", {chains.size(), pool.threadCount()});
+    }
+    else {
+        report.verbose(u"starting %d processing chains", {chains.size()});
+    }
+
+    // Use a Ctrl+C interrupt handler
+    HostInterruptHandler interrupt_handler(report, chains);
+    ts::UserInterrupt interrupt_manager(&interrupt_handler, true, true);
+
+    // Start all chains and wait for their termination.
+    for (size_t i = 0; i < chains.size(); ++i) {
+        chains[i]->start();
+    }
+    bool success = true;
+    for (size_t i = 0; i < chains.size(); ++i) {
+        chains[i]->waitForTermination();
+        success = success && !chains[i]->failed();
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
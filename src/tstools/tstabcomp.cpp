@@ -39,6 +39,9 @@
 #include "tsDVBCharTable.h"
 #include "tsxmlTweaks.h"
 #include "tsReportWithPrefix.h"
+#include "tsReportFile.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 #include "tsInputRedirector.h"
 #include "tsOutputRedirector.h"
 TSDUCK_SOURCE;
@@ -70,6 +73,8 @@ namespace {
         bool                decompile;       // Explicit decompilation.
         bool                xmlModel;        // Display XML model instead of compilation.
         bool                withExtensions;  // XML model with extensions.
+        bool                stdinFiles;      // Read additional input file names from standard input.
+        size_t              threads;         // Number of files to process in parallel.
         ts::SectionFileArgs sectionOptions;  // Section file processing options.
         ts::xml::Tweaks     xmlTweaks;       // XML formatting options.
     };
@@ -85,6 +90,8 @@ Options::Options(int argc, char *argv[]) :
     decompile(false),
     xmlModel(false),
     withExtensions(false),
+    stdinFiles(false),
+    threads(1),
     sectionOptions(),
     xmlTweaks()
 {
@@ -121,6 +128,21 @@ Options::Options(int argc, char *argv[]) :
          u"directory and default file name. If more than one input file is specified, "
          u"the output path, if present, must be a directory name.");
 
+    option(u"stdin-files");
+    help(u"stdin-files",
+         u"Read the names of additional files to process from the standard input, one "
+         u"file name per line, after the files from the command line. Each file is "
+         u"processed as soon as its name is read. The command terminates at the end "
+         u"of the standard input. This is useful to keep one tstabcomp process running "
+         u"and feed it with files to compile or decompile from another application, "
+         u"avoiding the startup time and the loading of the XML model for each file. "
+         u"When --stdin-files is specified, --output must be a directory, if present.");
+
+    option(u"threads", 't', POSITIVE);
+    help(u"threads",
+         u"Number of files to process in parallel, using distinct threads. "
+         u"The default is 1, files are processed one after the other.");
+
     option(u"xml-model", 'x');
     help(u"xml-model",
          u"Display the XML model of the table files. This model is not a full "
@@ -140,12 +162,14 @@ Options::Options(int argc, char *argv[]) :
     decompile = present(u"decompile");
     xmlModel = present(u"xml-model");
     withExtensions = present(u"extensions");
+    stdinFiles = present(u"stdin-files");
+    threads = intValue<size_t>(u"threads", 1);
     outdir = !outfile.empty() && ts::IsDirectory(outfile);
 
-    if (!infiles.empty() && xmlModel) {
+    if ((!infiles.empty() || stdinFiles) && xmlModel) {
         error(u"do not specify input files with --xml-model");
     }
-    if (infiles.size() > 1 && !outfile.empty() && !outdir) {
+    if ((infiles.size() > 1 || stdinFiles) && !outfile.empty() && !outdir) {
         error(u"with more than one input file, --output must be a directory");
     }
     if (compile && decompile) {
@@ -214,7 +238,7 @@ namespace {
 //----------------------------------------------------------------------------
 
 namespace {
-    bool ProcessFile(Options& opt, const ts::UString& infile)
+    bool ProcessFile(const Options& opt, ts::DuckContext& duck, const ts::xml::Document& model, ts::Report& log, const ts::UString& infile)
     {
         const ts::SectionFile::FileType inType = ts::SectionFile::GetFileType(infile);
         const bool compile = opt.compile || inType == ts::SectionFile::XML;
@@ -230,35 +254,36 @@ namespace {
             outname += ts::PathSeparator + ts::SectionFile::BuildFileName(ts::BaseName(infile), outType);
         }
 
-        ts::SectionFile file(opt.duck);
+        ts::SectionFile file(duck);
         file.setTweaks(opt.xmlTweaks);
         file.setCRCValidation(ts::CRC32::CHECK);
+        file.setModel(&model);
 
-        ts::ReportWithPrefix report(opt, ts::BaseName(infile) + u": ");
+        ts::ReportWithPrefix report(log, ts::BaseName(infile) + u": ");
 
         // Process the input file, starting with error cases.
         if (!compile && !decompile) {
-            opt.error(u"don't know what to do with file %s, unknown file type, specify --compile or --decompile", {infile});
+            log.error(u"don't know what to do with file %s, unknown file type, specify --compile or --decompile", {infile});
             return false;
         }
         else if (compile && inType == ts::SectionFile::BINARY) {
-            opt.error(u"cannot compile binary file %s", {infile});
+            log.error(u"cannot compile binary file %s", {infile});
             return false;
         }
         else if (decompile && inType == ts::SectionFile::XML) {
-            opt.error(u"cannot decompile XML file %s", {infile});
+            log.error(u"cannot decompile XML file %s", {infile});
             return false;
         }
         else if (compile) {
             // Load XML file and save binary sections.
-            opt.verbose(u"Compiling %s to %s", {infile, outname});
+            log.verbose(u"Compiling %s to %s", {infile, outname});
             return file.loadXML(infile, report) &&
                    opt.sectionOptions.processSectionFile(file, report) &&
                    file.saveBinary(outname, report);
         }
         else {
             // Load binary sections and save XML file.
-            opt.verbose(u"Decompiling %s to %s", {infile, outname});
+            log.verbose(u"Decompiling %s to %s", {infile, outname});
             return file.loadBinary(infile, report) &&
                    opt.sectionOptions.processSectionFile(file, report) &&
                    file.saveXML(outname, report);
@@ -267,6 +292,94 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+//  Get the next input file name, from the command line, then from the
+//  standard input with --stdin-files. Return false at end of list.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool NextInputFile(const Options& opt, size_t& index, ts::UString& infile)
+    {
+        while (index < opt.infiles.size()) {
+            infile = opt.infiles[index++];
+            if (!infile.empty()) {
+                return true;
+            }
+        }
+        while (opt.stdinFiles && infile.getLine(std::cin)) {
+            infile.trim();
+            if (!infile.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Worker thread, processing files in parallel with other workers.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Queue of input file names, shared by all workers. A null pointer means end of processing.
+    typedef ts::MessageQueue<ts::UString, ts::Mutex> FileQueue;
+
+    class Worker: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(Worker);
+    public:
+        Worker(const Options& opt, const ts::xml::Document& model, FileQueue& queue, ts::Report& report);
+        virtual ~Worker() override;
+
+        // Check if all files were successfully processed.
+        bool success() const { return _success; }
+
+    private:
+        const Options&             _opt;
+        const ts::xml::Document&   _model;
+        FileQueue&                 _queue;
+        ts::Report&                _report;
+        ts::DuckContext            _duck;     // Each thread needs its own context.
+        volatile bool              _success;
+
+        // Inherited from Thread.
+        virtual void main() override;
+    };
+
+    typedef ts::SafePtr<Worker> WorkerPtr;
+    typedef std::vector<WorkerPtr> WorkerVector;
+}
+
+Worker::Worker(const Options& opt, const ts::xml::Document& model, FileQueue& queue, ts::Report& report) :
+    ts::Thread(),
+    _opt(opt),
+    _model(model),
+    _queue(queue),
+    _report(report),
+    _duck(&report),
+    _success(true)
+{
+    // Use the same command line options as the main context.
+    ts::DuckContext::SavedArgs args;
+    opt.duck.saveArgs(args);
+    _duck.restoreArgs(args);
+}
+
+Worker::~Worker()
+{
+    waitForTermination();
+}
+
+void Worker::main()
+{
+    FileQueue::MessagePtr infile;
+    while (_queue.dequeue(infile) && !infile.isNull()) {
+        _success = ProcessFile(_opt, _duck, _model, _report, *infile) && _success;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -279,9 +392,50 @@ int MainCode(int argc, char *argv[])
         ok = DisplayModel(opt);
     }
     else {
-        for (size_t i = 0; i < opt.infiles.size(); ++i) {
-            if (!opt.infiles[i].empty()) {
-                ok = ProcessFile(opt, opt.infiles[i]) && ok;
+        // Load the XML model only once for all files.
+        ts::xml::Document model(opt);
+        if (!ts::SectionFile::LoadModel(model)) {
+            return EXIT_FAILURE;
+        }
+
+        size_t index = 0;
+        ts::UString infile;
+
+        if (opt.threads <= 1) {
+            // Process all files one after the other.
+            while (NextInputFile(opt, index, infile)) {
+                ok = ProcessFile(opt, opt.duck, model, opt, infile) && ok;
+            }
+        }
+        else {
+            // Messages from all threads are serialized. Do not read too many file names in advance.
+            ts::ReportFile<ts::Mutex> report(std::cerr, false, opt.maxSeverity());
+            FileQueue queue(2 * opt.threads);
+
+            // Start all worker threads.
+            WorkerVector workers;
+            for (size_t i = 0; i < opt.threads; ++i) {
+                workers.push_back(new Worker(opt, model, queue, report));
+                if (!workers.back()->start()) {
+                    opt.error(u"cannot start processing thread");
+                    workers.pop_back();
+                    ok = false;
+                    break;
+                }
+            }
+
+            // Feed the workers with file names, then one termination message per worker.
+            while (!workers.empty() && NextInputFile(opt, index, infile)) {
+                queue.enqueue(new ts::UString(infile));
+            }
+            for (size_t i = 0; i < workers.size(); ++i) {
+                queue.enqueue(nullptr);
+            }
+
+            // Wait for all workers to complete.
+            for (auto it = workers.begin(); it != workers.end(); ++it) {
+                (*it)->waitForTermination();
+                ok = (*it)->success() && ok;
             }
         }
     }
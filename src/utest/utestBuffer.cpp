@@ -56,6 +56,7 @@ public:
     void testReadBitLittleEndian();
     void testReadBitsBigEndian();
     void testReadBitsLittleEndian();
+    void testReadBitsAllOffsets();
     void testGetUInt8();
     void testGetUInt16BE();
     void testGetUInt16LE();
@@ -111,6 +112,7 @@ public:
     TSUNIT_TEST(testReadBitLittleEndian);
     TSUNIT_TEST(testReadBitsBigEndian);
     TSUNIT_TEST(testReadBitLittleEndian);
+    TSUNIT_TEST(testReadBitsAllOffsets);
     TSUNIT_TEST(testGetUInt8);
     TSUNIT_TEST(testGetUInt16BE);
     TSUNIT_TEST(testGetUInt16LE);
@@ -921,6 +923,28 @@ void BufferTest::testReadBitsLittleEndian()
     TSUNIT_EQUAL(27, b.currentReadBitOffset());
 }
 
+void BufferTest::testReadBitsAllOffsets()
+{
+    // Compare getBits() with a bit-by-bit read, for all bit offsets and sizes.
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t bits = 0; bits <= 64; ++bits) {
+            ts::Buffer b1(_bytes2, 12);
+            ts::Buffer b2(_bytes2, 12);
+            b1.skipBits(offset);
+            b2.skipBits(offset);
+            uint64_t expected = 0;
+            for (size_t i = 0; i < bits; ++i) {
+                expected = (expected << 1) | b1.getBit();
+            }
+            TSUNIT_EQUAL(expected, b2.getBits<uint64_t>(bits));
+            TSUNIT_EQUAL(offset + bits, b2.currentReadBitOffset());
+            TSUNIT_ASSERT(!b2.readError());
+            // Next bit must be the same.
+            TSUNIT_EQUAL(b1.getBit(), b2.getBit());
+        }
+    }
+}
+
 void BufferTest::testGetUInt8()
 {
     ts::Buffer b(_bytes1, sizeof(_bytes1));
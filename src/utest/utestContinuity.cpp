@@ -49,10 +49,12 @@ public:
 
     void testAnalyze();
     void testFix();
+    void testBatch();
 
     TSUNIT_TEST_BEGIN(ContinuityTest);
     TSUNIT_TEST(testAnalyze);
     TSUNIT_TEST(testFix);
+    TSUNIT_TEST(testBatch);
     TSUNIT_TEST_END();
 };
 
@@ -236,3 +238,58 @@ void ContinuityTest::testFix()
     TSUNIT_EQUAL(2, fixer.errorCount());
     TSUNIT_EQUAL(5, fixer.fixCount());
 }
+
+void ContinuityTest::testBatch()
+{
+    ts::ReportBuffer<> log;
+    ts::ContinuityAnalyzer analyzer(ts::AllPIDs, &log);
+
+    // Scenario: PID CC
+    //        0: 100  5
+    //        1: 100  6
+    //        2: 100  6 <- same CC but different content
+    //        3: 100  7
+
+    ts::TSPacket pkts[4];
+    for (size_t i = 0; i < 4; ++i) {
+        pkts[i] = ts::NullPacket;
+        pkts[i].setPID(100);
+        pkts[i].b[4] = uint8_t(i);
+    }
+    pkts[0].setCC(5);
+    pkts[1].setCC(6);
+    pkts[2].setCC(6);
+    pkts[3].setCC(7);
+
+    // With duplicate detection, packet 2 is not a duplicate.
+    TSUNIT_ASSERT(!analyzer.feedPackets(pkts, 4));
+    TSUNIT_EQUAL(4, analyzer.totalPackets());
+    TSUNIT_EQUAL(1, analyzer.errorCount());
+    TSUNIT_EQUAL(0, analyzer.fixCount());
+    TSUNIT_EQUAL(5, analyzer.firstCC(100));
+    TSUNIT_EQUAL(7, analyzer.lastCC(100));
+    TSUNIT_EQUAL(3, analyzer.lastPacket(100).b[4]);
+    TSUNIT_EQUAL(ts::INVALID_CC, analyzer.firstCC(101));
+
+    // Without duplicate detection, packet 2 is considered as a duplicate.
+    analyzer.reset();
+    analyzer.setDuplicateDetection(false);
+    TSUNIT_ASSERT(analyzer.feedPackets(pkts, 4));
+    TSUNIT_EQUAL(4, analyzer.totalPackets());
+    TSUNIT_EQUAL(0, analyzer.errorCount());
+    TSUNIT_EQUAL(7, analyzer.lastCC(100));
+    TSUNIT_EQUAL(0, analyzer.dupCount(100));
+    TSUNIT_EQUAL(ts::PID_NULL, analyzer.lastPacket(100).getPID());
+
+    // Generator mode.
+    analyzer.reset();
+    analyzer.setGenerator(true);
+    TSUNIT_ASSERT(!analyzer.feedPackets(pkts, 4));
+    TSUNIT_EQUAL(5, pkts[0].getCC());
+    TSUNIT_EQUAL(6, pkts[1].getCC());
+    TSUNIT_EQUAL(7, pkts[2].getCC());
+    TSUNIT_EQUAL(8, pkts[3].getCC());
+    TSUNIT_EQUAL(3, analyzer.fixCount());
+    TSUNIT_EQUAL(0, analyzer.errorCount());
+    TSUNIT_ASSERT(log.emptyMessages());
+}
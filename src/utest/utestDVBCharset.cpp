@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCharset.h"
+#include "tsDVBCharTableSingleByte.h"
 #include "tsByteBlock.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
@@ -48,10 +49,12 @@ public:
 
     void testRepository();
     void testDVB();
+    void testSingleByte();
 
     TSUNIT_TEST_BEGIN(DVBCharsetTest);
     TSUNIT_TEST(testRepository);
     TSUNIT_TEST(testDVB);
+    TSUNIT_TEST(testSingleByte);
     TSUNIT_TEST_END();
 };
 
@@ -103,3 +106,20 @@ void DVBCharsetTest::testDVB()
     TSUNIT_EQUAL(str1, ts::DVBCharset::DVB.decoded(dvb1, sizeof(dvb1)));
     TSUNIT_ASSERT(ts::ByteBlock(dvb1, sizeof(dvb1)) == ts::DVBCharset::DVB.encoded(str1.toDecomposedDiacritical()));
 }
+
+void DVBCharsetTest::testSingleByte()
+{
+    // Reversed diacritical marks, ASCII runs, line feed and untranslatable bytes.
+    static const uint8_t dvb1[] = {0xC1, 0x61, 0x62, 0x8A, 0xC8, 0x6F, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68};
+    const ts::UString str1{ts::LATIN_SMALL_LETTER_A_WITH_GRAVE, u'b', ts::LINE_FEED, ts::LATIN_SMALL_LETTER_O_WITH_DIAERESIS, u'c', u'd', u'e', u'f', u'g', u'h'};
+    ts::UString str;
+    TSUNIT_ASSERT(ts::DVBCharTableSingleByte::RAW_ISO_6937.decode(str, dvb1, sizeof(dvb1)));
+    TSUNIT_EQUAL(str1, str);
+
+    static const uint8_t dvb2[] = {0x61, 0x0A, 0x62, 0xC1};
+    TSUNIT_ASSERT(!ts::DVBCharTableSingleByte::RAW_ISO_6937.decode(str, dvb2, sizeof(dvb2)));
+    TSUNIT_EQUAL((ts::UString{u'a', u'b', ts::COMBINING_GRAVE_ACCENT}), str);
+
+    TSUNIT_ASSERT(ts::DVBCharTableSingleByte::RAW_ISO_6937.decode(str, nullptr, 0));
+    TSUNIT_ASSERT(str.empty());
+}
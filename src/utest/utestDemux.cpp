@@ -34,6 +34,9 @@
 #include "tsSectionDemux.h"
 #include "tsStandaloneTableDemux.h"
 #include "tsOneShotPacketizer.h"
+#include "tsTablesLogger.h"
+#include "tsTablesDisplay.h"
+#include "tsArgs.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
 #include "tsPAT.h"
@@ -93,6 +96,8 @@ public:
     void testTDT();
     void testTOT();
     void testHEVC();
+    void testRepetitions();
+    void testLoggerRepetitions();
 
     TSUNIT_TEST_BEGIN(DemuxTest);
     TSUNIT_TEST(testPAT);
@@ -106,6 +111,8 @@ public:
     TSUNIT_TEST(testTDT);
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testHEVC);
+    TSUNIT_TEST(testRepetitions);
+    TSUNIT_TEST(testLoggerRepetitions);
     TSUNIT_TEST_END();
 
 private:
@@ -117,6 +124,12 @@ private:
 
     // Unitary test for one table.
     void testTable(const char* name, const uint8_t* ref_packets, size_t ref_packets_size, const uint8_t* ref_sections, size_t ref_sections_size);
+
+    // Build a PID 0 with 3 identical PAT version 0, then 2 identical PAT version 1.
+    static void RepeatedPATs(ts::DuckContext& duck, ts::TSPacketVector& packets);
+
+    // Run a TablesLogger with the specified options on packets, return the text output.
+    static ts::UString LogTables(ts::DuckContext& duck, const ts::TSPacketVector& packets, const ts::UStringVector& options);
 };
 
 TSUNIT_REGISTER(DemuxTest);
@@ -490,3 +503,88 @@ void DemuxTest::testHEVC()
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+void DemuxTest::RepeatedPATs(ts::DuckContext& duck, ts::TSPacketVector& packets)
+{
+    packets.clear();
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    ts::PAT pat(0, true, 0x0001);
+    pat.pmts[0x0101] = 0x0100;
+    for (int i = 0; i < 5; ++i) {
+        if (i == 3) {
+            pat.version = 1;
+            pat.pmts[0x0102] = 0x0200;
+        }
+        ts::BinaryTable table;
+        pat.serialize(duck, table);
+        pzer.removeAll();
+        pzer.addTable(table);
+        ts::TSPacketVector pkts;
+        pzer.getPackets(pkts);
+        packets.insert(packets.end(), pkts.begin(), pkts.end());
+    }
+}
+
+ts::UString DemuxTest::LogTables(ts::DuckContext& duck, const ts::TSPacketVector& packets, const ts::UStringVector& options)
+{
+    std::ostringstream out;
+    duck.setOutput(&out);
+    ts::TablesDisplay display(duck);
+    ts::TablesLogger logger(display);
+    ts::Args args;
+    logger.defineArgs(args);
+    TSUNIT_ASSERT(args.analyze(u"", options));
+    TSUNIT_ASSERT(logger.loadArgs(duck, args));
+    TSUNIT_ASSERT(logger.open());
+    for (auto it = packets.begin(); it != packets.end(); ++it) {
+        logger.feedPacket(*it);
+    }
+    logger.close();
+    duck.setOutput(nullptr);
+    return ts::UString::FromUTF8(out.str());
+}
+
+void DemuxTest::testRepetitions()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    RepeatedPATs(duck, packets);
+
+    ts::SectionDemux demux(duck);
+    demux.setPIDFilter(ts::AllPIDs);
+    demux.trackRepetitions(true, false);
+    for (auto it = packets.begin(); it != packets.end(); ++it) {
+        demux.feedPacket(*it);
+    }
+
+    const ts::SectionDemux::RepetitionsMap& reps(demux.repetitions());
+    TSUNIT_EQUAL(1, reps.size());
+    const uint64_t index = (uint64_t(ts::PID_PAT) << 40) | (uint64_t(ts::TID_PAT) << 32) | (uint64_t(0x0001) << 16);
+    TSUNIT_ASSERT(reps.find(index) != reps.end());
+    TSUNIT_EQUAL(5, reps.find(index)->second.occurrences);
+    TSUNIT_EQUAL(2, reps.find(index)->second.changes);
+}
+
+void DemuxTest::testLoggerRepetitions()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    RepeatedPATs(duck, packets);
+
+    // All sections are logged without --only-changes.
+    ts::UString out(LogTables(duck, packets, {u"--all-sections", u"--log"}));
+    debug() << "DemuxTest::testLoggerRepetitions: all sections:" << std::endl << out;
+    ts::UStringVector lines;
+    out.toRemoved(u'\r').split(lines, u'\n', true, true);
+    TSUNIT_EQUAL(5, lines.size());
+
+    // Only the two versions are logged with --only-changes, followed by the summary.
+    out = LogTables(duck, packets, {u"--all-sections", u"--log", u"--only-changes", u"--count-repetitions"});
+    debug() << "DemuxTest::testLoggerRepetitions: only changes:" << std::endl << out;
+    out.toRemoved(u'\r').split(lines, u'\n', true, true);
+    TSUNIT_EQUAL(4, lines.size());
+    TSUNIT_ASSERT(lines[0].contain(u"V0"));
+    TSUNIT_ASSERT(lines[1].contain(u"V1"));
+    TSUNIT_EQUAL(u"Repetitions of sections:", lines[2]);
+    TSUNIT_EQUAL(u"PID 0x0000, TID 0x00, TIDext 0x0001, section   0: 5 occurrences, 2 changes", lines[3]);
+}
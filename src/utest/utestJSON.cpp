@@ -40,6 +40,7 @@
 #include "tsjsonString.h"
 #include "tsjsonObject.h"
 #include "tsjsonArray.h"
+#include "tsjsonWriter.h"
 #include "tsCerrReport.h"
 #include "tsNullReport.h"
 #include "tsunit.h"
@@ -60,12 +61,14 @@ public:
     void testGitHub();
     void testFactory();
     void testQuery();
+    void testWriter();
 
     TSUNIT_TEST_BEGIN(JsonTest);
     TSUNIT_TEST(testSimple);
     TSUNIT_TEST(testGitHub);
     TSUNIT_TEST(testFactory);
     TSUNIT_TEST(testQuery);
+    TSUNIT_TEST(testWriter);
     TSUNIT_TEST_END();
 };
 
@@ -696,3 +699,58 @@ void JsonTest::testQuery()
 
     debug() << "JsonTest::testQuery:" << std::endl << root.printed() << std::endl;
 }
+
+void JsonTest::testWriter()
+{
+    // Reference tree, fields are in alphabetical order to get the same output.
+    ts::json::Object obj;
+    obj.add(u"ab", 67);
+    obj.add(u"cd", u"x\"y\\z\n\u00E9");
+    obj.query(u"ef", true, ts::json::TypeArray).set(-12);
+    obj.query(u"ef", true, ts::json::TypeArray).set(ts::json::Bool(false));
+    obj.query(u"gh", true, ts::json::TypeObject);
+    obj.add(u"ij", ts::json::ValuePtr(new ts::json::Null));
+
+    std::ostringstream out;
+    {
+        ts::json::Writer json(out);
+        json.beginArray();
+        json.setBool(true);
+        json.beginObject();
+        json.add(u"ab", 67);
+        json.add(u"cd", u"x\"y\\z\n\u00E9");
+        json.beginArray(u"ef");
+        json.set(-12);
+        json.setBool(false);
+        json.endArray();
+        json.beginObject(u"gh");
+        json.endObject();
+        json.add(u"ij", ts::json::Null());
+        json.endObject();
+        json.set(obj);
+        TSUNIT_EQUAL(1, json.depth());
+        // Last level closed by destructor.
+    }
+
+    const ts::UString objText(obj.printed());
+    TSUNIT_EQUAL(
+        u"{\n"
+        u"  \"ab\": 67,\n"
+        u"  \"cd\": \"x\\\"y\\\\z\\n\\u00E9\",\n"
+        u"  \"ef\": [\n"
+        u"    -12,\n"
+        u"    false\n"
+        u"  ],\n"
+        u"  \"gh\": {\n"
+        u"  },\n"
+        u"  \"ij\": null\n"
+        u"}",
+        objText);
+
+    ts::UString ref(u"[\n  true,\n  ");
+    ref.append(objText.toSubstituted(u"\n", u"\n  "));
+    ref.append(u",\n  ");
+    ref.append(objText.toSubstituted(u"\n", u"\n  "));
+    ref.append(u"\n]\n");
+    TSUNIT_EQUAL(ref, ts::UString::FromUTF8(out.str()));
+}
@@ -35,6 +35,7 @@
 #include "tsMPEG.h"
 #include "tsSysUtils.h"
 #include "tsDuckContext.h"
+#include "tsCerrReport.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -46,6 +47,8 @@ TSDUCK_SOURCE;
 class NamesTest: public tsunit::Test
 {
 public:
+    NamesTest();
+
     virtual void beforeTest() override;
     virtual void afterTest() override;
 
@@ -85,6 +88,7 @@ public:
     void testAudioType();
     void testT2MIPacketType();
     void testPlatformId();
+    void testBinaryFile();
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
@@ -123,7 +127,12 @@ public:
     TSUNIT_TEST(testAudioType);
     TSUNIT_TEST(testT2MIPacketType);
     TSUNIT_TEST(testPlatformId);
+    TSUNIT_TEST(testBinaryFile);
     TSUNIT_TEST_END();
+
+private:
+    ts::UString _textFile;
+    ts::UString _binFile;
 };
 
 TSUNIT_REGISTER(NamesTest);
@@ -133,14 +142,29 @@ TSUNIT_REGISTER(NamesTest);
 // Initialization.
 //----------------------------------------------------------------------------
 
+// Constructor.
+NamesTest::NamesTest() :
+    _textFile(),
+    _binFile()
+{
+}
+
 // Test suite initialization method.
 void NamesTest::beforeTest()
 {
+    if (_textFile.empty()) {
+        _textFile = ts::TempFile(u".names");
+        _binFile = ts::Names::BinaryFileName(_textFile);
+    }
+    ts::DeleteFile(_textFile);
+    ts::DeleteFile(_binFile);
 }
 
 // Test suite cleanup method.
 void NamesTest::afterTest()
 {
+    ts::DeleteFile(_textFile);
+    ts::DeleteFile(_binFile);
 }
 
 
@@ -404,3 +428,48 @@ void NamesTest::testPlatformId()
     TSUNIT_EQUAL(u"0x000004 (TV digitale mobile, Telecom Italia)", ts::names::PlatformId(4, ts::names::FIRST));
     TSUNIT_EQUAL(u"VTC Mobile TV (0x704001)", ts::names::PlatformId(0x704001, ts::names::VALUE));
 }
+
+void NamesTest::testBinaryFile()
+{
+    std::ofstream strm(_textFile.toUTF8().c_str());
+    strm << "[Alpha]" << std::endl
+         << "Bits = 16" << std::endl
+         << "0x0001 = One" << std::endl
+         << "0x0010-0x001F = Sixteen to thirty-one" << std::endl
+         << "0x0100 = Two hundred fifty-six" << std::endl
+         << "[Beta]" << std::endl
+         << "0x00 = Zero" << std::endl;
+    strm.close();
+
+    const ts::Names text(_textFile, false, false);
+    TSUNIT_ASSERT(!text.isBinary());
+    TSUNIT_EQUAL(0, text.errorCount());
+    TSUNIT_ASSERT(text.saveBinary(_binFile, CERR));
+    TSUNIT_ASSERT(ts::FileExists(_binFile));
+
+    const ts::Names bin(_textFile);
+    TSUNIT_ASSERT(bin.isBinary());
+    TSUNIT_EQUAL(0, bin.errorCount());
+
+    for (const ts::Names* names = &text; names != nullptr; names = names == &text ? &bin : nullptr) {
+        TSUNIT_ASSERT(names->nameExists(u"alpha", 0x0001));
+        TSUNIT_ASSERT(names->nameExists(u"ALPHA", 0x0015));
+        TSUNIT_ASSERT(!names->nameExists(u"Alpha", 0x0002));
+        TSUNIT_ASSERT(!names->nameExists(u"Gamma", 0x0001));
+        TSUNIT_EQUAL(u"Sixteen to thirty-one (0x0012)", names->nameFromSection(u"Alpha", 0x0012, ts::names::VALUE));
+        TSUNIT_EQUAL(u"unknown (0x0020)", names->nameFromSection(u"Alpha", 0x0020, ts::names::VALUE));
+        TSUNIT_EQUAL(u"Two hundred fifty-six", names->nameFromSection(u"Alpha", 0x0100));
+        TSUNIT_EQUAL(u"One", names->nameFromSectionWithFallback(u"Alpha", 0x0002, 0x0001));
+        TSUNIT_EQUAL(u"Zero", names->nameFromSection(u"Beta", 0x00));
+        TSUNIT_EQUAL(u"0x01", names->nameFromSection(u"Beta", 0x01, ts::names::NAME_OR_VALUE, 8));
+    }
+
+    // An obsolete binary file is ignored.
+    std::ofstream more(_textFile.toUTF8().c_str(), std::ios::app);
+    more << "0x02 = Two" << std::endl;
+    more.close();
+
+    const ts::Names updated(_textFile);
+    TSUNIT_ASSERT(!updated.isBinary());
+    TSUNIT_EQUAL(u"Two", updated.nameFromSection(u"Beta", 0x02));
+}
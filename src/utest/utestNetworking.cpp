@@ -39,10 +39,14 @@
 #include "tsTCPConnection.h"
 #include "tsTCPServer.h"
 #include "tsUDPSocket.h"
+#include "tsUDPReceiver.h"
+#include "tsDuckContext.h"
+#include "tsArgs.h"
 #include "tsThread.h"
 #include "tsSysUtils.h"
 #include "tsIPUtils.h"
 #include "tsCerrReport.h"
+#include "tsNullReport.h"
 #include "utestTSUnitThread.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
@@ -69,6 +73,7 @@ public:
     void testSocketAddress();
     void testTCPSocket();
     void testUDPSocket();
+    void testUDPReceiverFilter();
     void testIPHeader();
 
     TSUNIT_TEST_BEGIN(NetworkingTest);
@@ -81,6 +86,7 @@ public:
     TSUNIT_TEST(testSocketAddress);
     TSUNIT_TEST(testTCPSocket);
     TSUNIT_TEST(testUDPSocket);
+    TSUNIT_TEST(testUDPReceiverFilter);
     TSUNIT_TEST(testIPHeader);
     TSUNIT_TEST_END();
 
@@ -680,6 +686,66 @@ void NetworkingTest::testUDPSocket()
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+// Two receivers, polled together as in the "ip" input plugin with several
+// destinations. The first one receives traffic which is rejected by its source
+// filter. This must not block the reception on the second one.
+void NetworkingTest::testUDPReceiverFilter()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber1 = 12346;
+    const uint16_t portNumber2 = 12347;
+    ts::DuckContext duck;
+
+    // First receiver accepts only datagrams from a source which is not localhost.
+    ts::Args args1;
+    ts::UDPReceiver sock1(CERR);
+    sock1.defineArgs(args1);
+    TSUNIT_ASSERT(args1.analyze(u"", {ts::UString::Decimal(portNumber1, 0, true, ts::UString()), u"--source", u"10.1.2.3"}));
+    TSUNIT_ASSERT(sock1.loadArgs(duck, args1));
+    sock1.setReceiveTimeoutArg(1000);
+    TSUNIT_ASSERT(sock1.open(CERR));
+
+    // Second receiver accepts everything.
+    ts::Args args2;
+    ts::UDPReceiver sock2(CERR);
+    sock2.defineArgs(args2);
+    TSUNIT_ASSERT(args2.analyze(u"", {ts::UString::Decimal(portNumber2, 0, true, ts::UString())}));
+    TSUNIT_ASSERT(sock2.loadArgs(duck, args2));
+    sock2.setReceiveTimeoutArg(1000);
+    TSUNIT_ASSERT(sock2.open(CERR));
+
+    // Send one datagram to each receiver.
+    ts::UDPSocket sender_sock(true);
+    TSUNIT_ASSERT(sender_sock.isOpen());
+    TSUNIT_ASSERT(sender_sock.bind(ts::SocketAddress(ts::IPAddress::LocalHost, ts::SocketAddress::AnyPort), CERR));
+    const char message1[] = "Rejected";
+    const char message2[] = "Accepted";
+    TSUNIT_ASSERT(sender_sock.send(message1, sizeof(message1), ts::SocketAddress(ts::IPAddress::LocalHost, portNumber1), CERR));
+    TSUNIT_ASSERT(sender_sock.send(message2, sizeof(message2), ts::SocketAddress(ts::IPAddress::LocalHost, portNumber2), CERR));
+
+    ts::SocketAddress sender;
+    ts::SocketAddress destination;
+    char buffer[1024];
+    size_t size = 0;
+    bool accepted = true;
+
+    // The datagram is received on the first socket and immediately reported as rejected.
+    TSUNIT_ASSERT(sock1.receiveOne(buffer, sizeof(buffer), size, sender, destination, accepted, nullptr, CERR));
+    TSUNIT_ASSERT(!accepted);
+    TSUNIT_EQUAL(sizeof(message1), size);
+    TSUNIT_ASSERT(ts::IPAddress(sender) == ts::IPAddress::LocalHost);
+
+    // The datagram on the second socket is still available.
+    TSUNIT_ASSERT(sock2.receiveOne(buffer, sizeof(buffer), size, sender, destination, accepted, nullptr, CERR));
+    TSUNIT_ASSERT(accepted);
+    TSUNIT_EQUAL(sizeof(message2), size);
+    TSUNIT_ASSERT(::memcmp(message2, buffer, size) == 0);
+
+    // Nothing else on the first socket, receive() skips nothing and times out.
+    TSUNIT_ASSERT(!sock1.receive(buffer, sizeof(buffer), size, sender, destination, nullptr, NULLREP));
+}
+
 // Test IP header
 void NetworkingTest::testIPHeader()
 {
@@ -52,9 +52,11 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testBoundedSizes();
 
     TSUNIT_TEST_BEGIN(PESPacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testBoundedSizes);
     TSUNIT_TEST_END();
 
 private:
@@ -149,6 +151,51 @@ void PESPacketizerTest::testPacketizer()
     TSUNIT_EQUAL(2, _pes_count);
 }
 
+namespace {
+    // A PES handler which collects the sizes of all PES packets.
+    class PESSizeCollector: public ts::PESHandlerInterface
+    {
+    public:
+        PESSizeCollector() : sizes() {}
+        std::vector<size_t> sizes;
+        virtual void handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& pes) override
+        {
+            sizes.push_back(pes.isValid() ? pes.size() : 0);
+        }
+    };
+}
+
+void PESPacketizerTest::testBoundedSizes()
+{
+    // Bounded PES packets which end in the first bytes of the payload of a TS packet.
+    static const size_t sizes[] = {369, 370, 371, 184, 185, 200};
+
+    ts::DuckContext duck;
+    ts::PESOneShotPacketizer zer(duck, 100, &CERR);
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); ++n) {
+        ts::ByteBlock data(sizes[n], uint8_t(n));
+        data[0] = 0x00;  // start code prefix
+        data[1] = 0x00;
+        data[2] = 0x01;
+        data[3] = 0xBE;  // padding stream
+        ts::PutUInt16(data.data() + 4, uint16_t(data.size() - 6));
+        zer.addPES(ts::PESPacket(data), ts::ShareMode::COPY);
+    }
+
+    ts::TSPacketVector packets;
+    zer.getPackets(packets);
+
+    PESSizeCollector collector;
+    ts::PESDemux demux(duck, &collector);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        demux.feedPacket(packets[i]);
+    }
+    TSUNIT_EQUAL(sizeof(sizes) / sizeof(sizes[0]), collector.sizes.size());
+    for (size_t n = 0; n < collector.sizes.size(); ++n) {
+        TSUNIT_EQUAL(sizes[n], collector.sizes[n]);
+    }
+}
+
 void PESPacketizerTest::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& pes)
 {
     _pes_count++;
@@ -59,14 +59,32 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testCachedPackets();
 
     TSUNIT_TEST_BEGIN(PacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testCachedPackets);
     TSUNIT_TEST_END();
 
 private:
     // Demux one table from a list of packets
     static void DemuxTable(ts::BinaryTablePtr& binTable, const char* name, const uint8_t* packets, size_t packets_size);
+
+    // A section provider which cycles over a list of sections, with stuffing.
+    class CycleProvider: public ts::SectionProviderInterface
+    {
+    public:
+        const ts::SectionPtrVector sections;
+        CycleProvider(const ts::SectionPtrVector& secs) : sections(secs) {}
+        virtual void provideSection(ts::SectionCounter counter, ts::SectionPtr& section) override
+        {
+            section = sections[counter % sections.size()];
+        }
+        virtual bool doStuffing() override
+        {
+            return true;
+        }
+    };
 };
 
 TSUNIT_REGISTER(PacketizerTest);
@@ -178,3 +196,43 @@ void PacketizerTest::testPacketizer()
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 15 && sdt_count <= 18);
 }
+
+void PacketizerTest::testCachedPackets()
+{
+    // Build long sections of various sizes.
+    ts::SectionPtrVector sections;
+    const size_t sizes[] = {1000, 300, 10, 183 * 3};
+    for (size_t i = 0; i < 4; ++i) {
+        ts::ByteBlock payload(sizes[i]);
+        for (size_t n = 0; n < payload.size(); ++n) {
+            payload[n] = uint8_t(n + i);
+        }
+        sections.push_back(new ts::Section(0x80, true, uint16_t(i), 0, true, 0, 0, payload.data(), payload.size()));
+        TSUNIT_ASSERT(sections.back()->isValid());
+    }
+
+    // Reference packetization, without cache.
+    ts::DuckContext duck;
+    CycleProvider provider(sections);
+    ts::Packetizer ref(duck, 100, &provider);
+
+    // Packetization with cached packets.
+    ts::CyclingPacketizer pzer(duck, 100, ts::CyclingPacketizer::ALWAYS);
+    pzer.addSections(sections);
+
+    // Three cycles: the first one builds the cache, the other ones use it.
+    ts::PacketCounter cycle_packets = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        cycle_packets += sections[i]->packetCount();
+    }
+    for (ts::PacketCounter pi = 0; pi < 3 * cycle_packets; ++pi) {
+        ts::TSPacket pkt1, pkt2;
+        TSUNIT_ASSERT(ref.getNextPacket(pkt1));
+        TSUNIT_ASSERT(pzer.getNextPacket(pkt2));
+        TSUNIT_EQUAL(100, pkt2.getPID());
+        TSUNIT_EQUAL(pi % 16, pkt2.getCC());
+        TSUNIT_EQUAL(0, ::memcmp(pkt1.b, pkt2.b, ts::PKT_SIZE));
+        TSUNIT_EQUAL((pi + 1) % cycle_packets == 0, pzer.atCycleBoundary());
+    }
+    TSUNIT_EQUAL(3 * sections.size(), pzer.sectionCount());
+}
@@ -121,6 +121,7 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testLocateZeroZero();
 
     TSUNIT_TEST_BEGIN(PlatformTest);
     TSUNIT_TEST(testIntegerTypes);
@@ -195,6 +196,7 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testLocateZeroZero);
     TSUNIT_TEST_END();
 };
 
@@ -877,3 +879,38 @@ void PlatformTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, TS_UCONST64(0x908F8E8D8C8B8A89));
     TSUNIT_EQUAL(0, ::memcmp(out, _bytes + 0x89, 8));
 }
+
+void PlatformTest::testLocateZeroZero()
+{
+    // Mostly non-zero data with a few 00 00 00 and 00 00 01 sequences, and false positives.
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = uint8_t(0x11 + i % 200);
+    }
+    data[5] = data[6] = 0x00; data[7] = 0x02;                   // 00 00 02: not a hit
+    data[40] = data[41] = 0x00; data[42] = 0x01;                // 00 00 01
+    data[70] = data[72] = 0x00; data[71] = 0x01;                // 00 01 00: not a hit
+    data[130] = data[131] = data[132] = data[133] = 0x00;       // 00 00 00 00: two hits
+    data[297] = data[298] = 0x00; data[299] = 0x01;             // 00 00 01 at the very end
+
+    TSUNIT_ASSERT(ts::LocateZeroZero(nullptr, 10) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 40, 2) == nullptr);
+
+    // Compare with a naive search at all start offsets and sizes.
+    for (size_t start = 0; start < sizeof(data); ++start) {
+        for (size_t size = 0; start + size <= sizeof(data); size += 7) {
+            const uint8_t* expected = nullptr;
+            for (size_t i = start; expected == nullptr && i + 3 <= start + size; ++i) {
+                if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] <= 1) {
+                    expected = data + i;
+                }
+            }
+            TSUNIT_ASSERT(ts::LocateZeroZero(data + start, size) == expected);
+        }
+    }
+
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data)) == data + 40);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 41, sizeof(data) - 41) == data + 130);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 131, sizeof(data) - 131) == data + 131);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 132, sizeof(data) - 132) == data + 297);
+}
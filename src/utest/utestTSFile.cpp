@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSFile.h"
+#include "tsTSFileOutputAsync.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsCerrReport.h"
@@ -55,11 +56,15 @@ public:
     void testTS();
     void testM2TS();
     void testDuck();
+    void testAsync();
+    void testAsyncRotation();
 
     TSUNIT_TEST_BEGIN(TSFileTest);
     TSUNIT_TEST(testTS);
     TSUNIT_TEST(testM2TS);
     TSUNIT_TEST(testDuck);
+    TSUNIT_TEST(testAsync);
+    TSUNIT_TEST(testAsyncRotation);
     TSUNIT_TEST_END();
 
 private:
@@ -272,3 +277,84 @@ void TSFileTest::testDuck()
     TSUNIT_EQUAL(0, file.readPackets(&packet, &mdata, 1, CERR));
     TSUNIT_ASSERT(file.close(CERR));
 }
+
+void TSFileTest::testAsync()
+{
+    ts::TSFileOutputAsync file;
+    ts::TSPacketVector packets(1000);
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i));
+    }
+
+    // Small buffers to force many direct I/O writes and a final partial buffer.
+    file.setBufferSize(ts::TSFile::DIRECT_IO_ALIGNMENT);
+    file.setQueueDepth(2);
+    file.setPreallocation(64 * 1024);
+
+    TSUNIT_ASSERT(!ts::FileExists(_tempFileName));
+    TSUNIT_ASSERT(!file.isOpen());
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE | ts::TSFile::DIRECT, CERR));
+    TSUNIT_ASSERT(file.isOpen());
+    for (size_t i = 0; i < packets.size(); i += 10) {
+        TSUNIT_ASSERT(file.writePackets(&packets[i], nullptr, 10, CERR));
+    }
+    TSUNIT_EQUAL(1000, file.writePacketsCount());
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_ASSERT(!file.isOpen());
+    TSUNIT_EQUAL(188000, ts::GetFileSize(_tempFileName));
+
+    ts::TSFile infile;
+    ts::TSPacketVector inpackets(packets.size() + 1);
+    TSUNIT_ASSERT(infile.openRead(_tempFileName, 0, CERR));
+    TSUNIT_EQUAL(packets.size(), infile.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR));
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_EQUAL(i, inpackets[i].getPID());
+    }
+    TSUNIT_ASSERT(infile.close(CERR));
+}
+
+void TSFileTest::testAsyncRotation()
+{
+    ts::TSFileOutputAsync file;
+    ts::TSPacketVector packets(25);
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i));
+    }
+
+    // Files of 10 packets, the last one is partial.
+    const ts::UString pattern(ts::PathPrefix(_tempFileName) + u"-*" + ts::PathSuffix(_tempFileName));
+    file.setMaxFileSize(10 * ts::PKT_SIZE + 100);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, 7, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data() + 7, nullptr, packets.size() - 7, CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    ts::UStringVector files;
+    TSUNIT_ASSERT(ts::ExpandWildcard(files, pattern));
+    TSUNIT_EQUAL(3, files.size());
+
+    // Files created in the same second have a numbered suffix, check the order of the content.
+    std::map<ts::PID, size_t> counts;  // index: first PID in file, value: number of packets
+    for (size_t i = 0; i < files.size(); ++i) {
+        debug() << "TSFileTest::testAsyncRotation: " << files[i] << std::endl;
+        ts::TSFile infile;
+        ts::TSPacketVector inpackets(20);
+        TSUNIT_ASSERT(infile.openRead(files[i], 0, CERR));
+        const size_t count = infile.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR);
+        TSUNIT_ASSERT(count > 0);
+        for (size_t j = 1; j < count; ++j) {
+            TSUNIT_EQUAL(inpackets[0].getPID() + j, inpackets[j].getPID());
+        }
+        counts[inpackets[0].getPID()] = count;
+        TSUNIT_ASSERT(infile.close(CERR));
+        ts::DeleteFile(files[i]);
+    }
+    TSUNIT_EQUAL(3, counts.size());
+    TSUNIT_EQUAL(10, counts[0]);
+    TSUNIT_EQUAL(10, counts[10]);
+    TSUNIT_EQUAL(5, counts[20]);
+}
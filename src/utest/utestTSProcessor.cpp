@@ -34,6 +34,8 @@
 #include "tsTSProcessor.h"
 #include "tsPluginRepository.h"
 #include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsSysUtils.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -49,10 +51,21 @@ public:
     virtual void afterTest() override;
 
     void testProcessing();
+    void testProcessorPool();
+    void testAnalyzeInterval();
+    void testAnalyzeIntervalInline();
+    void testAnalyzeNoStop();
 
     TSUNIT_TEST_BEGIN(TSProcessorTest);
     TSUNIT_TEST(testProcessing);
+    TSUNIT_TEST(testProcessorPool);
+    TSUNIT_TEST(testAnalyzeInterval);
+    TSUNIT_TEST(testAnalyzeIntervalInline);
+    TSUNIT_TEST(testAnalyzeNoStop);
     TSUNIT_TEST_END();
+
+private:
+    void analyzeInterval(bool inline_report);
 };
 
 TSUNIT_REGISTER(TSProcessorTest);
@@ -325,3 +338,266 @@ void TSProcessorTest::testProcessing()
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+
+//----------------------------------------------------------------------------
+// Several TS processors with packet processor plugins in a shared thread pool.
+//----------------------------------------------------------------------------
+
+void TSProcessorTest::testProcessorPool()
+{
+    ts::PluginRepository::Instance()->registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    // Less threads in the pool than packet processor plugins.
+    ts::TSProcessorPool pool(2);
+    TSUNIT_ASSERT(pool.start());
+    TSUNIT_EQUAL(2, pool.threadCount());
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testProcessorPool";
+    opt.input = {u"null", {u"1000"}};
+    opt.plugins = {
+        {u"test1", {u"--count", u"100"}},
+        {u"test1", {u"--count", u"100"}},
+        {u"test1", {u"--count", u"100"}},
+    };
+    opt.output = {u"drop"};
+
+    // Only stop events.
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+
+    constexpr size_t CHAIN_COUNT = 3;
+    TestEventHandler handlers[CHAIN_COUNT];
+    {
+        ts::SafePtr<ts::TSProcessor> procs[CHAIN_COUNT];
+        for (size_t i = 0; i < CHAIN_COUNT; ++i) {
+            procs[i] = new ts::TSProcessor(CERR);
+            procs[i]->setProcessorPool(&pool);
+            procs[i]->registerEventHandler(&handlers[i], crit);
+            TSUNIT_ASSERT(procs[i]->start(opt));
+        }
+        for (size_t i = 0; i < CHAIN_COUNT; ++i) {
+            procs[i]->waitForTermination();
+        }
+    }
+
+    // All plugins of all chains have processed all packets.
+    // The plugins are stopped from different threads, in any order.
+    for (size_t i = 0; i < CHAIN_COUNT; ++i) {
+        TSUNIT_EQUAL(3, handlers[i].logs.size());
+        size_t indexes = 0;
+        for (size_t j = 0; j < handlers[i].logs.size(); ++j) {
+            TSUNIT_EQUAL(0xBEEF0002, handlers[i].logs[j].code);
+            TSUNIT_EQUAL(1000,       handlers[i].logs[j].packets);
+            indexes |= size_t(1) << handlers[i].logs[j].index;
+        }
+        TSUNIT_EQUAL(0x0E, indexes);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class for the tests of plugin "analyze".
+// The PID of the packets is incremented every SEGMENT_PACKETS packets and
+// the plugin sleeps one millisecond per packet to slow down the stream.
+// Each analysis report contains a contiguous range of PID's.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SegmentPlugin : ts::ProcessorPlugin
+    {
+    public:
+        // Constructor.
+        SegmentPlugin(ts::TSP* t) : ts::ProcessorPlugin(t, u"Test plugin", u"") {}
+
+        // Implementation of plugin API.
+        virtual Status processPacket(ts::TSPacket&, ts::TSPacketMetadata&) override;
+
+        // A factory static method which creates an instance of that class.
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP* t) { return new SegmentPlugin(t); }
+
+        // Characteristics of the generated stream.
+        static constexpr ts::PID    BASE_PID = 100;
+        static constexpr size_t     SEGMENT_PACKETS = 200;
+        static constexpr size_t     SEGMENT_COUNT = 10;
+        static constexpr ts::PacketCounter TOTAL_PACKETS = SEGMENT_PACKETS * SEGMENT_COUNT;
+    };
+
+    // Summary of one normalized report of the plugin "analyze".
+    class AnalyzeSummary
+    {
+    public:
+        size_t            ts_lines;
+        ts::PacketCounter packets;
+        ts::PID           min_pid;
+        ts::PID           max_pid;
+
+        AnalyzeSummary() : ts_lines(0), packets(0), min_pid(ts::PID_MAX), max_pid(0) {}
+    };
+
+    // Get the integer value of a field "name=value" in a normalized line.
+    uint64_t NormalizedField(const ts::UString& line, const ts::UString& name)
+    {
+        const ts::UString key(u":" + name + u"=");
+        const size_t start = line.find(key);
+        uint64_t value = 0;
+        if (start != ts::NPOS) {
+            const size_t first = start + key.size();
+            line.substr(first, line.find(u':', first) - first).toInteger(value);
+        }
+        return value;
+    }
+
+    // Split a sequence of normalized reports, each one starts with a "title:" line.
+    void SplitNormalizedReports(std::vector<AnalyzeSummary>& reports, const std::string& text)
+    {
+        ts::UStringVector lines;
+        ts::UString::FromUTF8(text).split(lines, u'\n', true, true);
+        reports.clear();
+        for (auto it = lines.begin(); it != lines.end(); ++it) {
+            if (it->startWith(u"title:")) {
+                reports.push_back(AnalyzeSummary());
+            }
+            else if (!reports.empty() && it->startWith(u"ts:")) {
+                reports.back().ts_lines++;
+                reports.back().packets += NormalizedField(*it, u"packets");
+            }
+            else if (!reports.empty() && it->startWith(u"pid:")) {
+                const ts::PID pid = ts::PID(NormalizedField(*it, u"pid"));
+                reports.back().min_pid = std::min(reports.back().min_pid, pid);
+                reports.back().max_pid = std::max(reports.back().max_pid, pid);
+            }
+        }
+    }
+}
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr ts::PID SegmentPlugin::BASE_PID;
+constexpr size_t SegmentPlugin::SEGMENT_PACKETS;
+constexpr size_t SegmentPlugin::SEGMENT_COUNT;
+constexpr ts::PacketCounter SegmentPlugin::TOTAL_PACKETS;
+#endif
+
+SegmentPlugin::Status SegmentPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMetadata& metadata)
+{
+    pkt.setPID(ts::PID(BASE_PID + tsp->pluginPackets() / SEGMENT_PACKETS));
+    ts::SleepThread(1);
+    return TSP_OK;
+}
+
+
+//----------------------------------------------------------------------------
+// Interval reports of plugin "analyze": all packets are reported, in order.
+//----------------------------------------------------------------------------
+
+void TSProcessorTest::testAnalyzeInterval()
+{
+    analyzeInterval(false);
+}
+
+void TSProcessorTest::testAnalyzeIntervalInline()
+{
+    analyzeInterval(true);
+}
+
+void TSProcessorTest::analyzeInterval(bool inline_report)
+{
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    ts::PluginRepository::Instance()->registerProcessor(u"test2", SegmentPlugin::CreateInstance);
+
+    // The input lasts a bit more than two seconds, with one-second interval reports.
+    // Packets are passed in small groups to the plugin "analyze" for regular reports.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testAnalyzeInterval";
+    opt.max_flush_pkt = 10;
+    opt.input = {u"null", {ts::UString::Decimal(SegmentPlugin::TOTAL_PACKETS, 0, true, ts::UString())}};
+    opt.plugins = {
+        {u"test2", {}},
+        {u"analyze", {u"--interval", u"1", u"--normalized"}},
+    };
+    opt.output = {u"drop"};
+    if (inline_report) {
+        opt.plugins.back().args.push_back(u"--inline-report");
+    }
+
+    // The reports are written on the standard output. Collect them in memory.
+    // The standard output must be restored before any assertion.
+    std::stringstream out;
+    std::streambuf* const cout_buf = std::cout.rdbuf(out.rdbuf());
+    bool started = false;
+    {
+        ts::TSProcessor tsproc(report);
+        started = tsproc.start(opt);
+        if (started) {
+            tsproc.waitForTermination();
+        }
+    }
+    std::cout.rdbuf(cout_buf);
+
+    if (!started) {
+        // The plugin "analyze" is a shared library which may not be available.
+        debug() << "TSProcessorTest::testAnalyzeInterval: cannot start plugin analyze" << std::endl;
+        return;
+    }
+    debug() << "TSProcessorTest::testAnalyzeInterval: inline: " << inline_report << ", reports:" << std::endl << out.str();
+
+    std::vector<AnalyzeSummary> reports;
+    SplitNormalizedReports(reports, out.str());
+
+    // At least one interval report and the final report.
+    TSUNIT_ASSERT(reports.size() >= 2);
+
+    // Each report is complete and contains a contiguous range of PID's, after the previous report.
+    ts::PacketCounter total = 0;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        TSUNIT_EQUAL(1, reports[i].ts_lines);
+        TSUNIT_ASSERT(reports[i].packets > 0);
+        TSUNIT_ASSERT(reports[i].min_pid >= SegmentPlugin::BASE_PID);
+        TSUNIT_ASSERT(reports[i].min_pid <= reports[i].max_pid);
+        TSUNIT_ASSERT(reports[i].max_pid < SegmentPlugin::BASE_PID + SegmentPlugin::SEGMENT_COUNT);
+        TSUNIT_ASSERT(i == 0 || reports[i-1].max_pid <= reports[i].min_pid);
+        total += reports[i].packets;
+    }
+
+    // No packet was lost or counted twice during the swaps of analyzers.
+    TSUNIT_EQUAL(SegmentPlugin::TOTAL_PACKETS, total);
+    TSUNIT_EQUAL(SegmentPlugin::BASE_PID, reports.front().min_pid);
+    TSUNIT_EQUAL(SegmentPlugin::BASE_PID + SegmentPlugin::SEGMENT_COUNT - 1, reports.back().max_pid);
+}
+
+
+//----------------------------------------------------------------------------
+// Plugin "analyze" with --interval is deleted without being stopped when the
+// output plugin fails to start. The report thread must be terminated.
+//----------------------------------------------------------------------------
+
+void TSProcessorTest::testAnalyzeNoStop()
+{
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+
+    // The processor plugins are started before the output plugin.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testAnalyzeNoStop";
+    opt.input = {u"null", {u"100"}};
+    opt.plugins = {
+        {u"analyze", {u"--interval", u"1", u"--normalized"}},
+    };
+    opt.output = {u"file", {ts::TempFile(u"") + ts::PathSeparator + u"nonexistent" + ts::PathSeparator + u"out.ts"}};
+
+    std::stringstream out;
+    std::streambuf* const cout_buf = std::cout.rdbuf(out.rdbuf());
+    bool started = false;
+    {
+        ts::TSProcessor tsproc(report);
+        started = tsproc.start(opt);
+        if (started) {
+            tsproc.waitForTermination();
+        }
+    }
+    std::cout.rdbuf(cout_buf);
+
+    // The output plugin failed and the analysis was never reported.
+    TSUNIT_ASSERT(!started);
+    TSUNIT_ASSERT(out.str().empty());
+}
@@ -47,6 +47,9 @@
 #include "tsEacemPreferredNameIdentifierDescriptor.h"
 #include "tsEacemLogicalChannelNumberDescriptor.h"
 #include "tsEutelsatChannelNumberDescriptor.h"
+#include "tsServiceDescriptor.h"
+#include "tsBinaryTable.h"
+#include "tsSection.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
 #include "tsunit.h"
@@ -74,6 +77,7 @@ public:
     void testTOT();
     void testTSDT();
     void testCleanupPrivateDescriptors();
+    void testSerializeLargeSDT();
 
     TSUNIT_TEST_BEGIN(TableTest);
     TSUNIT_TEST(testAssignPMT);
@@ -87,6 +91,7 @@ public:
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testTSDT);
     TSUNIT_TEST(testCleanupPrivateDescriptors);
+    TSUNIT_TEST(testSerializeLargeSDT);
     TSUNIT_TEST_END();
 };
 
@@ -369,3 +374,38 @@ void TableTest::testCleanupPrivateDescriptors()
     TSUNIT_EQUAL(1, dlist.count());
     TSUNIT_EQUAL(ts::DID_SERVICE, dlist[0]->tag());
 }
+
+void TableTest::testSerializeLargeSDT()
+{
+    // Repeated small modifications and serializations of a large multi-section SDT.
+    ts::DuckContext duck;
+    ts::SDT sdt(true, 3, true, 0x1234, 0x5678);
+    for (uint16_t id = 1; id <= 200; ++id) {
+        sdt.services[id].running_status = 4;
+        sdt.services[id].descs.add(duck, ts::ServiceDescriptor(0x01, u"Provider", ts::UString::Format(u"Service number %d with a long name", {id})));
+    }
+
+    ts::BinaryTable bin;
+    for (int i = 0; i < 200; ++i) {
+        ts::DescriptorList& dlist(sdt.services[uint16_t(1 + i % 200)].descs);
+        dlist.clear();
+        dlist.add(duck, ts::ServiceDescriptor(0x01, u"Provider", ts::UString::Format(u"Modified %d", {i})));
+        sdt.serialize(duck, bin);
+    }
+
+    // All sections must be consistent and have a valid CRC32.
+    TSUNIT_ASSERT(bin.isValid());
+    TSUNIT_ASSERT(bin.sectionCount() > 1);
+    for (size_t si = 0; si < bin.sectionCount(); ++si) {
+        const ts::SectionPtr sec(bin.sectionAt(si));
+        TSUNIT_ASSERT(!sec.isNull());
+        TSUNIT_EQUAL(si, sec->sectionNumber());
+        TSUNIT_EQUAL(bin.sectionCount() - 1, sec->lastSectionNumber());
+        TSUNIT_ASSERT(ts::Section(sec->content(), sec->size(), ts::PID_NULL, ts::CRC32::CHECK).isValid());
+    }
+
+    const ts::SDT sdt2(duck, bin);
+    TSUNIT_ASSERT(sdt2.isValid());
+    TSUNIT_EQUAL(200, sdt2.services.size());
+    TSUNIT_EQUAL(u"Modified 199", sdt2.services.find(200)->second.serviceName(duck));
+}
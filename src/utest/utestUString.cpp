@@ -52,6 +52,7 @@ public:
 
     void testIsSpace();
     void testUTF();
+    void testUTFRuns();
     void testDiacritical();
     void testSurrogate();
     void testFromWChar();
@@ -92,6 +93,7 @@ public:
     void testDecimal();
     void testHexa();
     void testHexaDump();
+    void testHexaDumpStream();
     void testArgMixIn();
     void testArgMixOut();
     void testFormat();
@@ -107,6 +109,7 @@ public:
     TSUNIT_TEST_BEGIN(UStringTest);
     TSUNIT_TEST(testIsSpace);
     TSUNIT_TEST(testUTF);
+    TSUNIT_TEST(testUTFRuns);
     TSUNIT_TEST(testDiacritical);
     TSUNIT_TEST(testSurrogate);
     TSUNIT_TEST(testFromWChar);
@@ -146,6 +149,7 @@ public:
     TSUNIT_TEST(testDecimal);
     TSUNIT_TEST(testHexa);
     TSUNIT_TEST(testHexaDump);
+    TSUNIT_TEST(testHexaDumpStream);
     TSUNIT_TEST(testArgMixIn);
     TSUNIT_TEST(testArgMixOut);
     TSUNIT_TEST(testFormat);
@@ -321,6 +325,43 @@ void UStringTest::testUTF()
     TSUNIT_EQUAL(s1, s4);
 }
 
+void UStringTest::testUTFRuns()
+{
+    // Check conversions of ASCII runs of all lengths, with one non-ASCII character
+    // at all positions, to exercise the fast paths for ASCII and their boundaries.
+    struct Special {
+        std::vector<ts::UChar> utf16;
+        std::string utf8;
+    };
+    const std::vector<Special> specials {
+        {{0x007F}, "\x7F"},
+        {{0x0080}, "\xC2\x80"},
+        {{0x00E9}, "\xC3\xA9"},
+        {{0x20AC}, "\xE2\x82\xAC"},
+        {{0xD835, 0xDD38}, "\xF0\x9D\x94\xB8"},
+    };
+
+    for (size_t len = 0; len < 70; ++len) {
+        for (auto it = specials.begin(); it != specials.end(); ++it) {
+            for (size_t pos = 0; pos <= len; ++pos) {
+                ts::UString str;
+                std::string utf8;
+                for (size_t i = 0; i < len; ++i) {
+                    if (i == pos) {
+                        str.append(it->utf16.begin(), it->utf16.end());
+                        utf8.append(it->utf8);
+                    }
+                    const char c = char('a' + (i % 26));
+                    str.push_back(ts::UChar(c));
+                    utf8.push_back(c);
+                }
+                TSUNIT_ASSERT(str.toUTF8() == utf8);
+                TSUNIT_EQUAL(str, ts::UString::FromUTF8(utf8));
+            }
+        }
+    }
+}
+
 void UStringTest::testDiacritical()
 {
     TSUNIT_ASSERT(!ts::IsCombiningDiacritical(ts::UChar('a')));
@@ -1365,6 +1406,44 @@ void UStringTest::testHexaDump()
     TSUNIT_EQUAL(ref8, hex8);
 }
 
+void UStringTest::testHexaDumpStream()
+{
+    // Large data area, larger than the internal buffer of the stream dump.
+    ts::ByteBlock data(200000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 7 + (i >> 8));
+    }
+
+    static const uint32_t flags[] = {
+        ts::UString::HEXA,
+        ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET,
+        ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET | ts::UString::WIDE_OFFSET | ts::UString::BPL,
+        ts::UString::HEXA | ts::UString::C_STYLE,
+        ts::UString::BIN_NIBBLE | ts::UString::ASCII,
+        ts::UString::SINGLE_LINE,
+        ts::UString::COMPACT,
+    };
+    static const size_t sizes[] = {1, 15, 16, 17, 1000, 70000, 200000};
+
+    for (size_t fi = 0; fi < sizeof(flags) / sizeof(flags[0]); ++fi) {
+        for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+            const ts::UString str(ts::UString::Dump(data.data(), sizes[si], flags[fi], 3, 16, 0xFFF0, 1));
+            std::ostringstream strm;
+            ts::UString::Dump(strm, data.data(), sizes[si], flags[fi], 3, 16, 0xFFF0, 1);
+            TSUNIT_ASSERT(str.toUTF8() == strm.str());
+        }
+    }
+
+    // Appending to an existing string.
+    ts::UString str(u"abc\n");
+    str.appendDump(data.data(), 4, ts::UString::HEXA | ts::UString::ASCII | ts::UString::BPL, 0, 4);
+    TSUNIT_EQUAL(u"abc\n00 07 0E 15  ....\n", str);
+
+    std::ostringstream strm;
+    ts::UString::Dump(strm, data.data(), 0);
+    TSUNIT_ASSERT(strm.str().empty());
+}
+
 void UStringTest::testArgMixIn()
 {
     testArgMixInCalled1({});
@@ -33,6 +33,7 @@
 
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlPullParser.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
@@ -63,6 +64,7 @@ public:
     void testEscape();
     void testTweaks();
     void testChannels();
+    void testPullParser();
 
     TSUNIT_TEST_BEGIN(XMLTest);
     TSUNIT_TEST(testDocument);
@@ -74,6 +76,7 @@ public:
     TSUNIT_TEST(testEscape);
     TSUNIT_TEST(testTweaks);
     TSUNIT_TEST(testChannels);
+    TSUNIT_TEST(testPullParser);
     TSUNIT_TEST_END();
 
 private:
@@ -485,3 +488,75 @@ void XMLTest::testChannels()
     ts::xml::Document model(report());
     TSUNIT_ASSERT(model.load(TS_XML_TABLES_MODEL));
 }
+
+void XMLTest::testPullParser()
+{
+    static const char* xmlContent =
+        "<?xml version='1.0' encoding='UTF-8'?>\n"
+        "<!-- leading comment -->\n"
+        "<root attr1='val1'>\n"
+        "  <node1 a1='v1'>\n"
+        "    <sub1/>\n"
+        "  </node1>\n"
+        "  <!-- inner comment -->\n"
+        "  <node2>Text in\n"
+        "node2</node2><node3 a3='v3'/>\n"
+        "</root>\n"
+        "<!-- trailing comment -->\n";
+
+    std::istringstream strm(xmlContent);
+    ts::xml::Document doc(report());
+    ts::xml::PullParser parser(doc);
+    TSUNIT_ASSERT(parser.open(strm));
+
+    ts::xml::Element* root = doc.rootElement();
+    TSUNIT_ASSERT(root != nullptr);
+    TSUNIT_EQUAL(u"root", root->name());
+    TSUNIT_EQUAL(u"val1", root->attribute(u"attr1").value());
+    TSUNIT_ASSERT(!root->hasChildren());
+
+    ts::xml::Element* elem = parser.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node1", elem->name());
+    TSUNIT_EQUAL(4, elem->lineNumber());
+    TSUNIT_EQUAL(u"v1", elem->attribute(u"a1").value());
+    TSUNIT_ASSERT(elem->parent() == root);
+    TSUNIT_EQUAL(1, root->childrenCount());
+    TSUNIT_ASSERT(elem->firstChildElement() != nullptr);
+    TSUNIT_EQUAL(u"sub1", elem->firstChildElement()->name());
+
+    elem = parser.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node2", elem->name());
+    TSUNIT_EQUAL(1, root->childrenCount());
+    TSUNIT_EQUAL(u"Text in\nnode2", elem->text());
+
+    elem = parser.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node3", elem->name());
+    TSUNIT_EQUAL(9, elem->lineNumber());
+    TSUNIT_EQUAL(1, root->childrenCount());
+
+    TSUNIT_ASSERT(parser.nextElement() == nullptr);
+    TSUNIT_ASSERT(parser.nextElement() == nullptr);
+    TSUNIT_ASSERT(!root->hasChildren());
+    TSUNIT_ASSERT(parser.success());
+
+    // Invalid document, the elements before the error are still returned.
+    std::istringstream strm2(
+        "<root>\n"
+        "  <node1/>\n"
+        "  <node2></node3>\n"
+        "</root>\n");
+
+    ts::ReportBuffer<> rep;
+    ts::xml::Document doc2(rep);
+    ts::xml::PullParser parser2(doc2);
+    TSUNIT_ASSERT(parser2.open(strm2));
+    elem = parser2.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node1", elem->name());
+    TSUNIT_ASSERT(parser2.nextElement() == nullptr);
+    TSUNIT_ASSERT(!parser2.success());
+    TSUNIT_EQUAL(u"Error: line 3: parsing error, expected </node2> to match <node2> at line 3", rep.getMessages());
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Compile TSDuck names files (tsduck*.names) into binary files.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsNames.h"
+#include "tsSysUtils.h"
+TSDUCK_SOURCE;
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector infiles;   // Input text files.
+        ts::UString       outfile;   // Output binary file.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"Compile TSDuck names files into binary files", u"[options] input-file ..."),
+    infiles(),
+    outfile()
+{
+    option(u"", 0, STRING, 1, UNLIMITED_COUNT);
+    help(u"", u"Names files to compile. By default, each binary file is created in the same directory with an additional '.bin' suffix.");
+
+    option(u"output", 'o', STRING);
+    help(u"output", u"filename", u"Name of the binary output file. Allowed only with one input file.");
+
+    analyze(argc, argv);
+
+    getValues(infiles, u"");
+    getValue(outfile, u"output");
+
+    if (!outfile.empty() && infiles.size() > 1) {
+        error(u"--output is allowed only with one input file");
+    }
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    bool ok = true;
+
+    for (auto it = opt.infiles.begin(); it != opt.infiles.end(); ++it) {
+        if (!ts::FileExists(*it)) {
+            opt.error(u"file %s not found", {*it});
+            ok = false;
+            continue;
+        }
+
+        // Always parse the text file, never load an existing binary file.
+        const ts::Names names(*it, false, false);
+        const ts::UString outfile(opt.outfile.empty() ? ts::Names::BinaryFileName(*it) : opt.outfile);
+
+        if (names.errorCount() > 0) {
+            opt.error(u"%d errors in %s, %s not created", {names.errorCount(), *it, outfile});
+            ok = false;
+        }
+        else if (names.saveBinary(outfile, opt)) {
+            opt.verbose(u"created %s", {outfile});
+        }
+        else {
+            ok = false;
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}